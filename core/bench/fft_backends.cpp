@@ -0,0 +1,232 @@
+/**
+ * @file fft_backends.cpp
+ * @author Zeyu Yang (zeyuuyang42@gmail.com)
+ * @brief Benchmark and accuracy check of the compiled-in FFT backend
+ * @date 2026-10-19
+ *
+ * Only one backend is compiled into the core, so the backends are compared by configuring
+ * the core with different ZERR_FFT_BACKEND values and running this program for each build.
+ * Besides the timing it checks the transform against a direct DFT in long double, and the
+ * spectral features of the FeatureBank against the same extractors fed with the spectrum of
+ * that DFT. The program fails if an error exceeds the tolerances below, so every backend runs
+ * it as a test.
+ *
+ * @copyright Copyright (c) 2023-2026
+ */
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "audio_features.h"
+#include "featurebank.h"
+#include "fftbackend.h"
+#include "frequencytransformer.h"
+
+using namespace zerr;
+
+namespace {
+
+const int N_RUNS = 2000;
+
+const long double TWO_PI = 6.283185307179586476925286766559L;
+
+/**
+ * @brief Largest error of a transform relative to the largest reference bin, chosen by the
+ * precision the backend computes in, PFFFT and KissFFT use float also for T = double
+ */
+template <typename T> double fft_tolerance()
+{
+    return FFTBackend<T>::computes_in_float() ? 1e-5 : 1e-12;
+}
+
+/**
+ * @brief Largest error of a feature relative to its largest reference value. The features are
+ * float, so a few float ulps, more behind a float transform and most with the float extractors
+ * of zerr_core_float
+ */
+double feature_tolerance()
+{
+    if (sizeof(Sample) == sizeof(float)) {
+        return 1e-3;
+    }
+    return FFTBackend<Sample>::computes_in_float() ? 1e-4 : 1e-6;
+}
+
+/**
+ * @brief Time the forward transform and compare it with a direct DFT
+ * @tparam T Sample type of the transformer
+ * @return bool Whether the error is within fft_tolerance()
+ */
+template <typename T>
+bool measure(int frame_size, const char* precision)
+{
+    std::mt19937 rng(frame_size);
+    std::uniform_real_distribution<double> noise(-1.0, 1.0);
+
+    BasicFrequencyTransformer<T> transformer(frame_size);
+    std::vector<double> frame(frame_size);
+    for (int i = 0; i < frame_size; ++i) {
+        frame[i]                    = noise(rng);
+        transformer.fft_input()[i] = (T)frame[i];
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    for (int run = 0; run < N_RUNS; ++run) {
+        transformer.fft();
+    }
+    auto stop = std::chrono::steady_clock::now();
+    double us = std::chrono::duration<double, std::micro>(stop - start).count() / N_RUNS;
+
+    // direct DFT of a few bins in long double as reference
+    double error = 0.0;
+    double peak  = 0.0;
+    for (int k = 0; k <= frame_size / 2; k += frame_size / 16) {
+        long double re = 0.0L, im = 0.0L;
+        for (int i = 0; i < frame_size; ++i) {
+            long double phase = -TWO_PI * (long double)k * i / frame_size;
+            re += frame[i] * std::cos(phase);
+            im += frame[i] * std::sin(phase);
+        }
+        const T* bin = transformer.fft_output()[k];
+        error        = std::max(error, (double)std::hypot(re - bin[0], im - bin[1]));
+        peak         = std::max(peak, (double)std::hypot(re, im));
+    }
+
+    const bool passed = error / peak <= fft_tolerance<T>();
+    std::printf("%8s %9s %6d %12.3f %12.2e%s\n", FFTBackend<T>::name(), precision, frame_size,
+                us, error / peak, passed ? "" : "  FAILED");
+    return passed;
+}
+
+/**
+ * @brief Power spectrum of the Hann-windowed frame in long double, scaled like the transformer
+ */
+SpecBuffer reference_spectrum(const std::vector<double>& frame,
+                              const std::vector<long double>& re_table,
+                              const std::vector<long double>& im_table)
+{
+    const size_t n = frame.size();
+    std::vector<long double> windowed(n);
+    for (size_t i = 0; i < n; ++i) {
+        // the window of the transformer, its rounding is not an error of the backend
+        windowed[i] = frame[i] * (long double)get_hann_sample((int)i, (int)n);
+    }
+
+    SpecBuffer spec(n / 2 + 1);
+    for (size_t k = 0; k < spec.size(); ++k) {
+        long double re = 0.0L, im = 0.0L;
+        for (size_t i = 0, m = 0; i < n; ++i, m = (m + k) % n) {
+            re += windowed[i] * re_table[m];
+            im += windowed[i] * im_table[m];
+        }
+        spec[k] = (Sample)((re * re + im * im) / (2.0L * spec.size()));
+    }
+    return spec;
+}
+
+/**
+ * @brief Compare the spectral features of a FeatureBank with the extractors fed the spectrum
+ * of a direct DFT
+ * @return bool Whether every feature is within feature_tolerance()
+ */
+bool check_features()
+{
+    const size_t frame_size = 1024;
+    const size_t hop_size   = 256;
+    SystemConfigs cfg{48000, 64};
+
+    FeatureNames names{"flx", "ctd", "rlf", "flt"};
+    FeatureNames resolved;
+    for (const auto& name : names) {
+        resolved.push_back(name + "@" + std::to_string(frame_size) + "/" +
+                           std::to_string(hop_size));
+    }
+    FeatureBank bank;
+    bank.initialize(resolved, cfg);
+
+    std::vector<std::unique_ptr<FeatureExtractor>> reference;
+    reference.emplace_back(new feature::Flux());
+    reference.emplace_back(new feature::Centroid());
+    reference.emplace_back(new feature::Rolloff());
+    reference.emplace_back(new feature::Flatness());
+    SystemConfigs feature_cfg = cfg;
+    feature_cfg.frame_size    = frame_size;
+    for (auto& extractor : reference) {
+        extractor->initialize(feature_cfg);
+    }
+
+    std::vector<long double> re_table(frame_size), im_table(frame_size);
+    for (size_t m = 0; m < frame_size; ++m) {
+        re_table[m] = std::cos(-TWO_PI * m / frame_size);
+        im_table[m] = std::sin(-TWO_PI * m / frame_size);
+    }
+
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<double> noise(-0.05, 0.05);
+    std::vector<double> frame(frame_size, 0.0);
+    std::vector<double> error(names.size(), 0.0), peak(names.size(), 0.0);
+
+    Block in(cfg.block_size);
+    AudioInputs x;
+    for (size_t b = 0; b < 400; ++b) {
+        for (size_t i = 0; i < in.size(); ++i) {
+            double t = (b * in.size() + i) / (double)cfg.sample_rate;
+            in[i]    = 0.5 * std::sin(2.0 * PI * 440.0 * t) +
+                    0.2 * std::sin(2.0 * PI * 3150.0 * t) + noise(rng);
+        }
+        const FeaturesVals& y = bank.perform(in);
+
+        std::rotate(frame.begin(), frame.begin() + in.size(), frame.end());
+        std::copy(in.begin(), in.end(), frame.end() - in.size());
+        // the bank analyses once per hop and holds the values in between
+        if ((b + 1) * cfg.block_size % hop_size != 0) {
+            continue;
+        }
+        x.block = in;
+        x.spec  = reference_spectrum(frame, re_table, im_table);
+        for (size_t f = 0; f < names.size(); ++f) {
+            reference[f]->fetch(x);
+            reference[f]->extract();
+            const FeatureVals& expected = reference[f]->send();
+            for (size_t i = 0; i < expected.size(); ++i) {
+                error[f] = std::max(error[f], (double)std::fabs(y[f][i] - expected[i]));
+                peak[f]  = std::max(peak[f], (double)std::fabs(expected[i]));
+            }
+        }
+    }
+
+    const double tolerance = feature_tolerance();
+    bool passed            = true;
+    std::printf("\nfeatures against a long double DFT (%s, tolerance %.0e)\n",
+                FFTBackend<Sample>::name(), tolerance);
+    for (size_t f = 0; f < names.size(); ++f) {
+        const double relative = peak[f] > 0.0 ? error[f] / peak[f] : error[f];
+        std::printf("  %-4s %12.2e%s\n", names[f].c_str(), relative,
+                    relative <= tolerance ? "" : "  FAILED");
+        passed = passed && relative <= tolerance;
+    }
+    return passed;
+}
+
+} // namespace
+
+int main()
+{
+    bool passed = true;
+    std::printf("%8s %9s %6s %12s %12s\n", "backend", "precision", "size", "us/fft",
+                "rel error");
+    for (int frame_size = 256; frame_size <= 8192; frame_size *= 2) {
+        passed = measure<double>(frame_size, "double") && passed;
+#ifdef ZERR_CORE_FFT_FLOAT
+        passed = measure<float>(frame_size, "float") && passed;
+#endif
+    }
+
+    passed = check_features() && passed;
+
+    return passed ? 0 : 1;
+}
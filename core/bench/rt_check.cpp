@@ -0,0 +1,607 @@
+/**
+ * @file rt_check.cpp
+ * @author Zeyu Yang (zeyuuyang42@gmail.com)
+ * @brief Real-time safety checker for the perform() paths of the core modules
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2023-2026
+ *
+ * The checker interposes the allocator, the pthread locks and condition variables, futex
+ * system calls and a set of blocking or I/O calls in this executable. While a module processes
+ * synthetic input, every such call made by the processing thread is reported once per call site
+ * with a backtrace, and the process exits with the number of violations. It relies on glibc
+ * symbol interposition and only builds on Linux.
+ *
+ *     zerr_rt_check <scenario> [--blocks <n>] [--warmup <n>]
+ *     zerr_rt_check --list
+ */
+#include <dlfcn.h>
+#include <execinfo.h>
+#include <pthread.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <cxxabi.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdarg>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "asyncfeaturebank.h"
+#include "audio_features.h"
+#include "audiodisperser.h"
+#include "envelopecombinator.h"
+#include "envelopegenerator.h"
+#include "featurebank.h"
+#include "staticfeaturebank.h"
+
+extern "C" {
+void* __libc_malloc(size_t size);
+void* __libc_calloc(size_t n, size_t size);
+void* __libc_realloc(void* ptr, size_t size);
+void* __libc_memalign(size_t alignment, size_t size);
+void __libc_free(void* ptr);
+}
+
+namespace rtcheck {
+
+/**
+ * @brief Kinds of calls that are not allowed on the audio thread
+ */
+enum Kind { ALLOCATION, LOCK, SYSCALL, N_KINDS };
+
+const char* const KIND_NAMES[N_KINDS] = {"allocation", "lock", "syscall"};
+
+const int MAX_FRAMES = 32;  /**< Frames recorded per backtrace */
+const int MAX_SITES  = 256; /**< Distinct call sites reported in full */
+
+thread_local bool armed  = false; /**< The current thread runs a checked perform() */
+thread_local bool inside = false; /**< Guards against reports from within a report */
+
+std::atomic<size_t> counts[N_KINDS]; /**< Violations per kind */
+size_t sites[MAX_SITES];              /**< Hashes of the reported call sites */
+int n_sites = 0;                      /**< Number of reported call sites */
+
+/**
+ * @brief Resolve the next definition of an interposed function
+ */
+template <typename F> F next(const char* name)
+{
+    static_assert(sizeof(F) == sizeof(void*), "function pointer expected");
+    void* symbol = dlsym(RTLD_NEXT, name);
+    F function;
+    std::memcpy(&function, &symbol, sizeof(function));
+    return function;
+}
+
+/**
+ * @brief Write to stderr with the raw system call, bypassing the interposed write() and syscall()
+ */
+void print(const char* format, ...)
+{
+    char text[512];
+    va_list args;
+    va_start(args, format);
+    int size = std::vsnprintf(text, sizeof(text), format, args);
+    va_end(args);
+    static auto raw = next<long (*)(long, ...)>("syscall");
+    raw(SYS_write, 2, text, (size_t)std::min<int>(size, sizeof(text) - 1));
+}
+
+/**
+ * @brief Print a backtrace with demangled names, allocating is fine while reporting
+ */
+void print_backtrace(void* const* frames, int n_frames)
+{
+    char** symbols = backtrace_symbols(frames, n_frames);
+    if (!symbols) {
+        backtrace_symbols_fd(frames, n_frames, 2);
+        return;
+    }
+    for (int i = 0; i < n_frames; ++i) {
+        // glibc formats the frames as "object(mangled+offset) [address]"
+        std::string line = symbols[i];
+        size_t begin     = line.find('(');
+        size_t end       = line.find('+', begin);
+        std::string name;
+        if (begin != std::string::npos && end != std::string::npos) {
+            name = line.substr(begin + 1, end - begin - 1);
+        }
+        int status      = -1;
+        char* demangled = nullptr;
+        if (!name.empty()) {
+            demangled = abi::__cxa_demangle(name.c_str(), nullptr, nullptr, &status);
+        }
+        print("    #%-2d %s\n", i, status == 0 ? demangled : line.c_str());
+        std::free(demangled);
+    }
+    std::free(symbols);
+}
+
+/**
+ * @brief Record a violation, print the backtrace the first time a call site is seen
+ * @param kind Kind of the violating call
+ * @param what Name of the called function
+ */
+void report(Kind kind, const char* what)
+{
+    if (!armed || inside) {
+        return;
+    }
+    inside = true;
+    counts[kind].fetch_add(1);
+
+    void* frames[MAX_FRAMES];
+    int n_frames = backtrace(frames, MAX_FRAMES);
+
+    size_t hash = (size_t)kind;
+    for (int i = 0; i < n_frames; ++i) {
+        hash = hash * 1000003u ^ (size_t)frames[i];
+    }
+    bool known = std::find(sites, sites + n_sites, hash) != sites + n_sites;
+    if (!known && n_sites < MAX_SITES) {
+        sites[n_sites++] = hash;
+        print("\n[rt_check] %s: %s\n", KIND_NAMES[kind], what);
+        // skip report() and the interposer
+        print_backtrace(frames + 1, n_frames - 1);
+    }
+    inside = false;
+}
+
+} // namespace rtcheck
+
+using rtcheck::ALLOCATION;
+using rtcheck::LOCK;
+using rtcheck::SYSCALL;
+using rtcheck::next;
+using rtcheck::report;
+
+// ---------------------------------------------------------------------------------------------
+// interposed functions, the allocator forwards to glibc, everything else to the next definition
+
+extern "C" {
+
+void* malloc(size_t size)
+{
+    report(ALLOCATION, "malloc");
+    return __libc_malloc(size);
+}
+
+void* calloc(size_t n, size_t size)
+{
+    report(ALLOCATION, "calloc");
+    return __libc_calloc(n, size);
+}
+
+void* realloc(void* ptr, size_t size)
+{
+    report(ALLOCATION, "realloc");
+    return __libc_realloc(ptr, size);
+}
+
+void* memalign(size_t alignment, size_t size)
+{
+    report(ALLOCATION, "memalign");
+    return __libc_memalign(alignment, size);
+}
+
+void* aligned_alloc(size_t alignment, size_t size)
+{
+    report(ALLOCATION, "aligned_alloc");
+    return __libc_memalign(alignment, size);
+}
+
+int posix_memalign(void** ptr, size_t alignment, size_t size)
+{
+    report(ALLOCATION, "posix_memalign");
+    *ptr = __libc_memalign(alignment, size);
+    return *ptr || size == 0 ? 0 : ENOMEM;
+}
+
+void free(void* ptr)
+{
+    if (ptr) {
+        report(ALLOCATION, "free");
+    }
+    __libc_free(ptr);
+}
+
+int pthread_mutex_lock(pthread_mutex_t* mutex)
+{
+    static auto real = next<int (*)(pthread_mutex_t*)>("pthread_mutex_lock");
+    report(LOCK, "pthread_mutex_lock");
+    return real(mutex);
+}
+
+int pthread_mutex_trylock(pthread_mutex_t* mutex)
+{
+    static auto real = next<int (*)(pthread_mutex_t*)>("pthread_mutex_trylock");
+    report(LOCK, "pthread_mutex_trylock");
+    return real(mutex);
+}
+
+int pthread_rwlock_rdlock(pthread_rwlock_t* lock)
+{
+    static auto real = next<int (*)(pthread_rwlock_t*)>("pthread_rwlock_rdlock");
+    report(LOCK, "pthread_rwlock_rdlock");
+    return real(lock);
+}
+
+int pthread_rwlock_wrlock(pthread_rwlock_t* lock)
+{
+    static auto real = next<int (*)(pthread_rwlock_t*)>("pthread_rwlock_wrlock");
+    report(LOCK, "pthread_rwlock_wrlock");
+    return real(lock);
+}
+
+int pthread_cond_wait(pthread_cond_t* cond, pthread_mutex_t* mutex)
+{
+    static auto real = next<int (*)(pthread_cond_t*, pthread_mutex_t*)>("pthread_cond_wait");
+    report(LOCK, "pthread_cond_wait");
+    return real(cond, mutex);
+}
+
+int pthread_cond_signal(pthread_cond_t* cond)
+{
+    static auto real = next<int (*)(pthread_cond_t*)>("pthread_cond_signal");
+    report(LOCK, "pthread_cond_signal");
+    return real(cond);
+}
+
+int pthread_cond_broadcast(pthread_cond_t* cond)
+{
+    static auto real = next<int (*)(pthread_cond_t*)>("pthread_cond_broadcast");
+    report(LOCK, "pthread_cond_broadcast");
+    return real(cond);
+}
+
+long syscall(long number, ...)
+{
+    static auto real = next<long (*)(long, ...)>("syscall");
+    // no system call takes more than six arguments, the unused ones are passed as garbage
+    va_list args;
+    va_start(args, number);
+    long a[6];
+    for (long& arg : a) {
+        arg = va_arg(args, long);
+    }
+    va_end(args);
+    // futex is what std::atomic wait/notify and hand-rolled locks block on
+    report(number == SYS_futex ? LOCK : SYSCALL, number == SYS_futex ? "futex" : "syscall");
+    return real(number, a[0], a[1], a[2], a[3], a[4], a[5]);
+}
+
+ssize_t read(int fd, void* buf, size_t count)
+{
+    static auto real = next<ssize_t (*)(int, void*, size_t)>("read");
+    report(SYSCALL, "read");
+    return real(fd, buf, count);
+}
+
+ssize_t write(int fd, const void* buf, size_t count)
+{
+    static auto real = next<ssize_t (*)(int, const void*, size_t)>("write");
+    report(SYSCALL, "write");
+    return real(fd, buf, count);
+}
+
+int open(const char* path, int flags, ...)
+{
+    static auto real = next<int (*)(const char*, int, ...)>("open");
+    va_list args;
+    va_start(args, flags);
+    mode_t mode = va_arg(args, mode_t);
+    va_end(args);
+    report(SYSCALL, "open");
+    return real(path, flags, mode);
+}
+
+int close(int fd)
+{
+    static auto real = next<int (*)(int)>("close");
+    report(SYSCALL, "close");
+    return real(fd);
+}
+
+FILE* fopen(const char* path, const char* mode)
+{
+    static auto real = next<FILE* (*)(const char*, const char*)>("fopen");
+    report(SYSCALL, "fopen");
+    return real(path, mode);
+}
+
+size_t fwrite(const void* ptr, size_t size, size_t n, FILE* stream)
+{
+    static auto real = next<size_t (*)(const void*, size_t, size_t, FILE*)>("fwrite");
+    report(SYSCALL, "fwrite");
+    return real(ptr, size, n, stream);
+}
+
+int nanosleep(const struct timespec* duration, struct timespec* remaining)
+{
+    static auto real =
+        next<int (*)(const struct timespec*, struct timespec*)>("nanosleep");
+    report(SYSCALL, "nanosleep");
+    return real(duration, remaining);
+}
+
+int usleep(useconds_t usec)
+{
+    static auto real = next<int (*)(useconds_t)>("usleep");
+    report(SYSCALL, "usleep");
+    return real(usec);
+}
+
+int sched_yield()
+{
+    static auto real = next<int (*)()>("sched_yield");
+    report(SYSCALL, "sched_yield");
+    return real();
+}
+
+ssize_t getrandom(void* buf, size_t size, unsigned int flags)
+{
+    static auto real = next<ssize_t (*)(void*, size_t, unsigned int)>("getrandom");
+    report(SYSCALL, "getrandom");
+    return real(buf, size, flags);
+}
+
+} // extern "C"
+
+// ---------------------------------------------------------------------------------------------
+// scenarios
+
+using namespace zerr;
+
+namespace {
+
+const size_t SAMPLE_RATE = 48000;
+const size_t BLOCK_SIZE  = 64;
+
+/**
+ * @brief A configured module and the call that processes one block
+ */
+struct Scenario {
+    std::string name;                                  /**< Name used on the command line */
+    std::function<std::function<void(size_t)>()> make; /**< Builds the module, returns perform */
+};
+
+/**
+ * @brief Synthetic input: a tone with noise and a silent gap every second, so the silence
+ * gates open and close during the check
+ */
+Sample signal_at(size_t pos)
+{
+    static std::mt19937 rng(7);
+    static std::uniform_real_distribution<double> noise(-0.1, 0.1);
+
+    if (pos % SAMPLE_RATE > SAMPLE_RATE * 3 / 4) {
+        return 0.0;
+    }
+    return (Sample)(0.5 * std::sin(2.0 * PI * 440.0 * pos / SAMPLE_RATE) + noise(rng));
+}
+
+/**
+ * @brief Fill a block with the synthetic signal starting at the block index
+ */
+template <typename Buffer> void fill_signal(Buffer&& block, size_t index)
+{
+    for (size_t i = 0; i < BLOCK_SIZE; ++i) {
+        block[i] = signal_at(index * BLOCK_SIZE + i);
+    }
+}
+
+std::function<void(size_t)> featurebank(FeatureNames names, SpectrumMode mode, size_t n_channels,
+                                        bool metered = false)
+{
+    auto bank = std::make_shared<FeatureBank>();
+    auto in   = std::make_shared<PlanarBuffer>(n_channels, BLOCK_SIZE);
+    bank->set_spectrum_mode(mode);
+    bank->initialize(names, SystemConfigs{SAMPLE_RATE, BLOCK_SIZE}, n_channels);
+    bank->get_load_meter().set_enabled(metered);
+
+    return [bank, in](size_t index) {
+        for (size_t ch = 0; ch < in->get_n_channels(); ++ch) {
+            fill_signal((*in)[ch], index + ch);
+        }
+        bank->perform(*in);
+    };
+}
+
+std::function<void(size_t)> generator(const std::string& mode, const std::string& layout)
+{
+    auto gen = std::make_shared<EnvelopeGenerator>(SystemConfigs{SAMPLE_RATE, BLOCK_SIZE},
+                                                   std::string(ZERR_CONFIGS_DIR) + "/" + layout,
+                                                   mode);
+    if (!gen->initialize()) {
+        throw std::runtime_error("cannot load the layout " + layout);
+    }
+    auto in = std::make_shared<PlanarBuffer>(3, BLOCK_SIZE);
+
+    return [gen, in, mode](size_t index) {
+        for (size_t i = 0; i < BLOCK_SIZE; ++i) {
+            size_t pos = index * BLOCK_SIZE + i;
+            // a trigger every 50ms or a trajectory cycle every 2s, muted every other second
+            in->channel(0)[i] = mode == "trigger" ? (Sample)(pos % (SAMPLE_RATE / 20) == 0)
+                                                  : (Sample)(pos % (2 * SAMPLE_RATE)) /
+                                                        (2 * SAMPLE_RATE);
+            in->channel(1)[i] = 0.5;
+            in->channel(2)[i] = (pos / SAMPLE_RATE) % 2 ? 0.0 : 0.8;
+        }
+        gen->perform(*in);
+    };
+}
+
+std::function<void(size_t)> combinator(const std::string& mode)
+{
+    const int n_sources = 3, n_channels = 8;
+    auto comb = std::make_shared<EnvelopeCombinator>(n_sources, n_channels,
+                                                     SystemConfigs{SAMPLE_RATE, BLOCK_SIZE}, mode);
+    comb->initialize();
+    auto in = std::make_shared<PlanarBuffer>(n_sources * n_channels, BLOCK_SIZE);
+
+    return [comb, in](size_t index) {
+        for (size_t ch = 0; ch < in->get_n_channels(); ++ch) {
+            fill_signal((*in)[ch], index + ch);
+        }
+        comb->perform(*in);
+    };
+}
+
+std::function<void(size_t)> disperser()
+{
+    const int n_channels = 8;
+    auto disp =
+        std::make_shared<AudioDisperser>(n_channels, SystemConfigs{SAMPLE_RATE, BLOCK_SIZE});
+    disp->initialize();
+    auto in = std::make_shared<PlanarBuffer>(n_channels + 1, BLOCK_SIZE);
+
+    return [disp, in](size_t index) {
+        for (size_t ch = 0; ch < in->get_n_channels(); ++ch) {
+            fill_signal((*in)[ch], index + ch);
+        }
+        disp->perform(*in);
+    };
+}
+
+std::function<void(size_t)> logger()
+{
+    // the queue fills up after LOG_QUEUE_SIZE blocks, so both the push and the drop are checked
+    auto log = std::make_shared<Logger>([](const std::string& msg) { std::puts(msg.c_str()); });
+    log->setLogLevel(LogLevel::DEBUG);
+    log->setDeferred(true);
+
+    return [log](size_t index) {
+        Logger::RealtimeScope realtime;
+        log->logFormat(LogLevel::WARNING, "block %zu of %s at %.3f s", index,
+                       "a scenario with a long name", (double)(index * BLOCK_SIZE) / SAMPLE_RATE);
+    };
+}
+
+const FeatureNames ALL_FEATURES = {"rms", "zcr", "flx", "ctd", "rlf", "cf", "flt", "zc", "osf"};
+
+const std::vector<Scenario> SCENARIOS = {
+    {"featurebank", [] { return featurebank(ALL_FEATURES, SpectrumMode::FFT, 1); }},
+    {"featurebank_metered", [] { return featurebank(ALL_FEATURES, SpectrumMode::FFT, 1, true); }},
+    {"featurebank_sliding",
+     [] { return featurebank({"rms", "ctd", "flx", "rlf"}, SpectrumMode::SLIDING_DFT, 1); }},
+    {"featurebank_multires",
+     [] {
+         return featurebank({"rms@512", "ctd@1024/256", "flx", "ocd"}, SpectrumMode::FFT, 4);
+     }},
+    {"asyncfeaturebank",
+     [] {
+         auto bank = std::make_shared<AsyncFeatureBank>();
+         auto in   = std::make_shared<Block>(BLOCK_SIZE);
+         bank->initialize(ALL_FEATURES, SystemConfigs{SAMPLE_RATE, BLOCK_SIZE});
+         return std::function<void(size_t)>([bank, in](size_t index) {
+             fill_signal(*in, index);
+             bank->perform(*in);
+         });
+     }},
+    {"staticfeaturebank",
+     [] {
+         using namespace zerr::feature;
+         auto bank = std::make_shared<StaticFeatureBank<RootMeanSquare, CrestFactor, Centroid,
+                                                        Flatness, Flux, Onset>>();
+         auto in   = std::make_shared<Block>(BLOCK_SIZE);
+         bank->initialize(SystemConfigs{SAMPLE_RATE, BLOCK_SIZE});
+         return std::function<void(size_t)>([bank, in](size_t index) {
+             fill_signal(*in, index);
+             bank->perform(*in);
+         });
+     }},
+    {"envelopes_trigger", [] { return generator("trigger", "ring_8.yaml"); }},
+    {"envelopes_trajectory", [] { return generator("trajectory", "ring_8.yaml"); }},
+    {"combinator_add", [] { return combinator("add"); }},
+    {"combinator_root", [] { return combinator("root"); }},
+    {"combinator_max", [] { return combinator("max"); }},
+    {"disperser", [] { return disperser(); }},
+    {"logger", [] { return logger(); }},
+};
+
+void usage()
+{
+    std::printf("usage: zerr_rt_check <scenario> [--blocks <n>] [--warmup <n>]\n"
+                "       zerr_rt_check --list\n");
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    if (argc < 2) {
+        usage();
+        return 1;
+    }
+
+    std::string name = argv[1];
+    size_t n_blocks  = 4 * SAMPLE_RATE / BLOCK_SIZE;
+    size_t n_warmup  = 0;
+    for (int i = 2; i + 1 < argc; i += 2) {
+        if (std::strcmp(argv[i], "--blocks") == 0) {
+            n_blocks = std::strtoul(argv[i + 1], nullptr, 10);
+        }
+        else if (std::strcmp(argv[i], "--warmup") == 0) {
+            n_warmup = std::strtoul(argv[i + 1], nullptr, 10);
+        }
+    }
+
+    if (name == "--list") {
+        for (const auto& scenario : SCENARIOS) {
+            std::printf("%s\n", scenario.name.c_str());
+        }
+        return 0;
+    }
+
+    auto scenario = std::find_if(SCENARIOS.begin(), SCENARIOS.end(),
+                                 [&](const Scenario& s) { return s.name == name; });
+    if (scenario == SCENARIOS.end()) {
+        usage();
+        return 1;
+    }
+
+    // backtrace() loads its unwinder on the first call, which allocates
+    void* frames[rtcheck::MAX_FRAMES];
+    backtrace(frames, rtcheck::MAX_FRAMES);
+
+    std::function<void(size_t)> perform;
+    try {
+        perform = scenario->make();
+    }
+    catch (const std::exception& e) {
+        std::printf("%s: cannot set up the scenario: %s\n", name.c_str(), e.what());
+        return 1;
+    }
+
+    // the warm-up blocks are not checked, e.g. for hosts that prime a module before starting
+    for (size_t i = 0; i < n_warmup; ++i) {
+        perform(i);
+    }
+
+    rtcheck::armed = true;
+    for (size_t i = n_warmup; i < n_warmup + n_blocks; ++i) {
+        perform(i);
+    }
+    rtcheck::armed = false;
+
+    size_t total = 0;
+    std::printf("%s: %zu blocks of %zu samples\n", name.c_str(), n_blocks, BLOCK_SIZE);
+    for (int kind = 0; kind < rtcheck::N_KINDS; ++kind) {
+        size_t count = rtcheck::counts[kind].load();
+        std::printf("    %-12s %zu\n", rtcheck::KIND_NAMES[kind], count);
+        total += count;
+    }
+    std::printf("%s\n", total ? "FAILED: perform() is not real-time safe" : "passed");
+
+    return total ? 1 : 0;
+}
@@ -0,0 +1,75 @@
+/**
+ * @file silence_triggers.cpp
+ * @author Zeyu Yang (zeyuuyang42@gmail.com)
+ * @brief Check that the trigger features of a FeatureBank do not latch while its input is gated
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2023-2026
+ *
+ * Noise below the silence threshold that crosses zero on every sample makes zc fire in every
+ * block, also in the last one before the gate closes. The noise is followed by digital silence.
+ * Once the gate is closed, the triggers have to stay at zero while the continuous features hold
+ * a constant value. Returns non-zero on failure, so it runs as a test.
+ */
+#include <cmath>
+#include <cstdio>
+#include <random>
+
+#include "featurebank.h"
+
+using namespace zerr;
+
+namespace {
+
+const size_t SAMPLE_RATE = 48000;
+const size_t BLOCK_SIZE  = 64;
+
+} // namespace
+
+int main()
+{
+    FeatureBank bank;
+    // zc and osf are the sample-level triggers, rms is held
+    bank.initialize({"zc", "osf", "rms"}, {SAMPLE_RATE, BLOCK_SIZE});
+
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<double> level(0.1, 0.4);
+
+    // the gate closes after SILENCE_HOLD_TIME of noise below half the threshold
+    const size_t noise_blocks   = 2 * SAMPLE_RATE / BLOCK_SIZE;
+    const size_t silence_blocks = SAMPLE_RATE / BLOCK_SIZE;
+    const size_t checked_from   = (size_t)(1.5 * SAMPLE_RATE) / BLOCK_SIZE;
+
+    Block block(BLOCK_SIZE);
+    size_t fired = 0, latched = 0, unsteady = 0;
+    for (size_t b = 0; b < noise_blocks + silence_blocks; ++b) {
+        for (size_t i = 0; i < BLOCK_SIZE; ++i) {
+            const double sign = (i % 2) ? 1.0 : -1.0;
+            block[i]          = b < noise_blocks ? sign * level(rng) * SILENCE_THRESHOLD : 0.0;
+        }
+        const FeaturesVals& y = bank.perform(block);
+
+        if (b < noise_blocks / 4) {
+            fired += y[0].back() > 0.0 ? 1 : 0;
+        }
+        if (b < checked_from) {
+            continue;
+        }
+        for (size_t i = 0; i < BLOCK_SIZE; ++i) {
+            latched += (y[0][i] != 0.0 || y[1][i] != 0.0) ? 1 : 0;
+            unsteady += y[2][i] != y[2][0] ? 1 : 0;
+        }
+    }
+
+    if (fired == 0) {
+        std::printf("FAILED: zc never fired on the noise, the check is void\n");
+        return 1;
+    }
+    if (latched > 0 || unsteady > 0) {
+        std::printf("FAILED: %zu trigger samples set and %zu held samples changed while gated\n",
+                    latched, unsteady);
+        return 1;
+    }
+    std::printf("ok: triggers released and continuous features held while gated\n");
+    return 0;
+}
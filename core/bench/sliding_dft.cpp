@@ -0,0 +1,112 @@
+/**
+ * @file sliding_dft.cpp
+ * @author Zeyu Yang (zeyuuyang42@gmail.com)
+ * @brief Benchmark of the sliding DFT against the full FFT at different hop sizes
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2023-2026
+ */
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <random>
+
+#include "frequencytransformer.h"
+#include "ringbuffer.h"
+
+using namespace zerr;
+
+namespace {
+
+const size_t SAMPLE_RATE = 48000;
+const int SECONDS        = 4;
+
+/**
+ * @brief Compute the spectrum of one hop with the full FFT, as the FeatureBank does
+ */
+void fft_hop(FrequencyTransformer& transformer, RingBuffer& ring, const Block& hop)
+{
+    ring.enqueue(hop);
+    SampleView wave = ring.view(transformer.get_frame_size());
+    std::copy(wave.begin(), wave.end(), transformer.fft_input());
+    transformer.windowing();
+    transformer.fft();
+    transformer.power_spectrum();
+}
+
+/**
+ * @brief Compute the spectrum of one hop with the sliding DFT
+ */
+void sliding_hop(FrequencyTransformer& transformer, const Block& hop)
+{
+    transformer.slide(hop.data(), hop.size());
+    transformer.fft();
+    transformer.power_spectrum();
+}
+
+/**
+ * @brief Run a hop function over the whole test signal
+ * @return double Processing time in microseconds per second of audio
+ */
+template <typename HopFunc>
+double run(const Samples& signal, size_t hop_size, HopFunc hop_func)
+{
+    Block hop(hop_size);
+    auto start = std::chrono::steady_clock::now();
+    for (size_t pos = 0; pos + hop_size <= signal.size(); pos += hop_size) {
+        std::copy(signal.begin() + pos, signal.begin() + pos + hop_size, hop.begin());
+        hop_func(hop);
+    }
+    auto stop = std::chrono::steady_clock::now();
+
+    return std::chrono::duration<double, std::micro>(stop - start).count() / SECONDS;
+}
+
+} // namespace
+
+int main()
+{
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<double> noise(-0.5, 0.5);
+
+    Samples signal(SAMPLE_RATE * SECONDS);
+    for (size_t i = 0; i < signal.size(); ++i) {
+        signal[i] = 0.5 * std::sin(2.0 * PI * 440.0 * i / SAMPLE_RATE) + 0.1 * noise(rng);
+    }
+
+    std::printf("%6s %6s %14s %14s %14s %10s %12s\n", "frame", "hop", "fft [us/s]",
+                "sdft [us/s]", "sdft/64 [us/s]", "winner", "max error");
+
+    for (int frame_size : {512, 1024, 2048}) {
+        for (size_t hop_size : {1, 2, 4, 8, 16, 32, 64, 128, 256, 512}) {
+            FrequencyTransformer fft(frame_size);
+            RingBuffer ring(frame_size);
+            double t_fft =
+                run(signal, hop_size, [&](const Block& hop) { fft_hop(fft, ring, hop); });
+
+            FrequencyTransformer sdft(frame_size, 1, SpectrumMode::SLIDING_DFT);
+            double t_sdft = run(signal, hop_size, [&](const Block& hop) { sliding_hop(sdft, hop); });
+
+            // a bin subset, e.g. the low end used by a pitch or band tracker
+            FrequencyTransformer subset(frame_size, 1, SpectrumMode::SLIDING_DFT);
+            subset.set_bin_range(0, 63);
+            double t_subset =
+                run(signal, hop_size, [&](const Block& hop) { sliding_hop(subset, hop); });
+
+            // both front-ends have seen the same signal, compare the last spectra
+            AudioBuffer spec_fft  = fft.get_power_spectrum();
+            AudioBuffer spec_sdft = sdft.get_power_spectrum();
+            double peak = *std::max_element(spec_fft.begin(), spec_fft.end());
+            double error = 0.0;
+            for (size_t k = 0; k < spec_fft.size(); ++k) {
+                error = std::max(error, std::fabs(spec_fft[k] - spec_sdft[k]) / peak);
+            }
+
+            std::printf("%6d %6zu %14.1f %14.1f %14.1f %10s %12.2e\n", frame_size, hop_size, t_fft,
+                        t_sdft, t_subset, t_sdft < t_fft ? "sdft" : "fft", error);
+        }
+    }
+
+    return 0;
+}
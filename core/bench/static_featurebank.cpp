@@ -0,0 +1,86 @@
+/**
+ * @file static_featurebank.cpp
+ * @author Zeyu Yang (zeyuuyang42@gmail.com)
+ * @brief Benchmark of the compile-time StaticFeatureBank against the runtime FeatureBank
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2023-2026
+ */
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <random>
+
+#include "featurebank.h"
+#include "staticfeaturebank.h"
+
+using namespace zerr;
+using namespace zerr::feature;
+
+namespace {
+
+const size_t SAMPLE_RATE = 48000;
+const int SECONDS        = 4;
+
+/**
+ * @brief Run a bank over the whole test signal
+ * @return double Processing time in microseconds per second of audio
+ */
+template <typename Bank>
+double run(Bank& bank, const Samples& signal, size_t block_size, FeaturesVals& last)
+{
+    Block block(block_size);
+    auto start = std::chrono::steady_clock::now();
+    for (size_t pos = 0; pos + block_size <= signal.size(); pos += block_size) {
+        std::copy(signal.begin() + pos, signal.begin() + pos + block_size, block.begin());
+        last = bank.perform(block);
+    }
+    auto stop = std::chrono::steady_clock::now();
+
+    return std::chrono::duration<double, std::micro>(stop - start).count() / SECONDS;
+}
+
+} // namespace
+
+int main()
+{
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<double> noise(-0.5, 0.5);
+
+    Samples signal(SAMPLE_RATE * SECONDS);
+    for (size_t i = 0; i < signal.size(); ++i) {
+        signal[i] = 0.5 * std::sin(2.0 * PI * 440.0 * i / SAMPLE_RATE) + 0.1 * noise(rng);
+    }
+
+    std::printf("%6s %16s %16s %8s %12s\n", "block", "dynamic [us/s]", "static [us/s]",
+                "speedup", "max diff");
+
+    for (size_t block_size : {32, 64, 128, 256, 512}) {
+        SystemConfigs configs{SAMPLE_RATE, block_size};
+
+        FeatureBank dynamic;
+        dynamic.initialize({"rms", "cf", "zcr", "ctd", "flt", "rlf", "flx"}, configs);
+        StaticFeatureBank<RootMeanSquare, CrestFactor, ZeroCrossingRate, Centroid, Flatness,
+                          Rolloff, Flux>
+            fused;
+        fused.initialize(configs);
+
+        FeaturesVals y_dynamic, y_fused;
+        double t_dynamic = run(dynamic, signal, block_size, y_dynamic);
+        double t_fused   = run(fused, signal, block_size, y_fused);
+
+        // both banks run the same arithmetic, so the values should agree exactly
+        double diff = 0.0;
+        for (size_t f = 0; f < y_dynamic.size(); ++f) {
+            for (size_t i = 0; i < block_size; ++i) {
+                diff = std::max(diff, (double)std::fabs(y_dynamic[f][i] - y_fused[f][i]));
+            }
+        }
+
+        std::printf("%6zu %16.1f %16.1f %8.2f %12.2e\n", block_size, t_dynamic, t_fused,
+                    t_dynamic / t_fused, diff);
+    }
+
+    return 0;
+}
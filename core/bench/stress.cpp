@@ -0,0 +1,502 @@
+/**
+ * @file stress.cpp
+ * @author Zeyu Yang (zeyuuyang42@gmail.com)
+ * @brief Audio deadline stress test of the full chain with callback time histograms
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2023-2026
+ *
+ * The harness runs features -> envelopes -> combinator -> disperser like a host callback: one
+ * call per block period, woken at absolute times. For every callback it records the wake-up
+ * jitter and the execution time in histograms, and counts an xrun when a callback finishes
+ * after its deadline. The percentiles and the measured distribution give the xrun rate at
+ * other deadlines, which helps to choose block sizes and channel counts for a venue.
+ *
+ * With a core built with ZERR_CORE_TRACING, --trace records the stages of every callback and
+ * writes the timeline as Chrome trace JSON whenever a callback missed its deadline, and once
+ * more at the end of the run.
+ *
+ *     zerr_stress --layout configs/ring_8.yaml --block 64 --sources 4 --seconds 300 --cpu 2
+ */
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#include "audiodisperser.h"
+#include "envelopecombinator.h"
+#include "envelopegenerator.h"
+#include "featurebank.h"
+#include "tracer.h"
+
+using namespace zerr;
+
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+/**
+ * @brief Command line options
+ */
+struct Options {
+    std::string layout = std::string(ZERR_CONFIGS_DIR) + "/ring_8.yaml"; /**< Speaker layout */
+    std::string mode    = "trigger"; /**< Envelope generator mode */
+    std::string combine = "add";     /**< Combinator mode */
+    std::string csv_path;            /**< Write the histograms to this file */
+    std::string trace_path;          /**< Write a Chrome trace to this file */
+    size_t sample_rate = 48000;      /**< Simulated sample rate */
+    size_t block_size  = 64;         /**< Samples per callback */
+    int n_sources      = 2;          /**< Sources, each with a feature bank and generator */
+    double seconds     = 60.0;       /**< Duration of the run */
+    double deadline_ms = 0.0;        /**< Deadline, 0 uses the block period */
+    int cpu            = -1;         /**< Pin the callback thread to this CPU */
+    int priority       = 0;          /**< SCHED_FIFO priority of the callback thread */
+    int n_load         = 0;          /**< Background threads creating CPU and memory load */
+    bool free_run      = false;      /**< Run callbacks back to back instead of periodic */
+};
+
+/**
+ * @brief Histogram with a fixed bin width and an overflow bin, allocated up front
+ */
+class Histogram {
+ public:
+    Histogram(double bin_us, double max_us)
+        : bin_us(bin_us), bins((size_t)std::ceil(max_us / bin_us) + 1, 0)
+    {
+    }
+
+    void add(double us)
+    {
+        size_t bin = us <= 0.0 ? 0 : std::min(bins.size() - 1, (size_t)(us / bin_us));
+        ++bins[bin];
+        ++count;
+        max = std::max(max, us);
+    }
+
+    /**
+     * @brief Upper edge of the bin that holds the given fraction of all values
+     */
+    double percentile(double fraction) const
+    {
+        uint64_t target = (uint64_t)std::ceil(fraction * count);
+        uint64_t seen   = 0;
+        for (size_t i = 0; i < bins.size(); ++i) {
+            seen += bins[i];
+            if (seen >= target && seen > 0) {
+                return i + 1 == bins.size() ? max : std::min(max, (i + 1) * bin_us);
+            }
+        }
+        return max;
+    }
+
+    /**
+     * @brief Fraction of values above a limit, counted in whole bins
+     */
+    double exceeding(double us) const
+    {
+        size_t first = std::min(bins.size(), (size_t)std::ceil(us / bin_us));
+        uint64_t n   = 0;
+        for (size_t i = first; i < bins.size(); ++i) {
+            n += bins[i];
+        }
+        return count ? (double)n / count : 0.0;
+    }
+
+    double bin_us;
+    std::vector<uint64_t> bins;
+    uint64_t count = 0;
+    double max     = 0.0;
+};
+
+/**
+ * @brief The processing chain of the Pd and Max objects for n_sources sources
+ */
+class Chain {
+ public:
+    explicit Chain(const Options& options)
+        : configs{options.sample_rate, options.block_size}
+        , n_sources(options.n_sources)
+        , trigger_mode(options.mode == "trigger")
+    {
+        std::mt19937 rng(3);
+        std::uniform_real_distribution<double> noise(-0.1, 0.1);
+
+        for (int s = 0; s < n_sources; ++s) {
+            auto bank = std::make_unique<FeatureBank>();
+            // onsets drive the trigger mode, the centroid the trajectory mode
+            bank->initialize({"osf", "ctd", "rms"}, configs);
+            banks.push_back(std::move(bank));
+
+            auto generator =
+                std::make_unique<EnvelopeGenerator>(configs, options.layout, options.mode);
+            if (!generator->initialize()) {
+                throw std::runtime_error("cannot load the layout " + options.layout);
+            }
+            generators.push_back(std::move(generator));
+
+            // a few seconds of a decaying pulse train with a different tempo per source
+            Block signal(options.sample_rate * 4);
+            size_t period = options.sample_rate / (2 + s);
+            for (size_t i = 0; i < signal.size(); ++i) {
+                double t     = (double)i / options.sample_rate;
+                double decay = std::exp(-8.0 * (i % period) / options.sample_rate);
+                signal[i] = (Sample)(decay * std::sin(2.0 * PI * (220.0 + 110.0 * s) * t) +
+                                     noise(rng));
+            }
+            signals.push_back(std::move(signal));
+        }
+
+        n_channels = generators[0]->getNumSpeakers();
+        combinator = std::make_unique<EnvelopeCombinator>(n_sources, n_channels, configs,
+                                                          options.combine);
+        disperser  = std::make_unique<AudioDisperser>(n_channels, configs);
+        combinator->initialize();
+        disperser->initialize();
+
+        source.resize(1, configs.block_size);
+        control.resize(3, configs.block_size);
+        envelopes.resize(n_sources * n_channels, configs.block_size);
+        dispersed.resize(n_channels + 1, configs.block_size);
+    }
+
+    /**
+     * @brief One host callback
+     */
+    void process()
+    {
+        const size_t block_size = configs.block_size;
+        const size_t length     = signals[0].size();
+        if (pos + block_size > length) {
+            pos = 0;
+        }
+
+        std::fill(dispersed[0].begin(), dispersed[0].end(), (Sample)0.0);
+        for (int s = 0; s < n_sources; ++s) {
+            std::copy(signals[s].begin() + pos, signals[s].begin() + pos + block_size,
+                      source.channel(0));
+            for (size_t i = 0; i < block_size; ++i) {
+                dispersed.channel(0)[i] += source.channel(0)[i];
+            }
+
+            const FeaturesVals& y   = banks[s]->perform(source);
+            const FeatureVals& main = trigger_mode ? y[0] : y[1];
+            for (size_t i = 0; i < block_size; ++i) {
+                // the centroid in Hz becomes a trajectory position
+                control.channel(0)[i] = trigger_mode ? main[i] : (Sample)(main[i] / 4000.0);
+                control.channel(1)[i] = 0.4;
+                control.channel(2)[i] = (Sample)std::min(1.0f, y[2][i] * 4.0f);
+            }
+
+            // the combinator expects channel ch of source s at ch + s * n_channels
+            const PlanarBuffer& env = generators[s]->perform(control);
+            for (int ch = 0; ch < n_channels; ++ch) {
+                std::copy(env[ch].begin(), env[ch].end(), envelopes.channel(ch + s * n_channels));
+            }
+        }
+
+        const PlanarBuffer& combined = combinator->perform(envelopes);
+        for (int ch = 0; ch < n_channels; ++ch) {
+            std::copy(combined[ch].begin(), combined[ch].end(), dispersed.channel(ch + 1));
+        }
+        disperser->perform(dispersed);
+
+        pos += block_size;
+    }
+
+    int get_n_channels() const { return n_channels; }
+
+ private:
+    SystemConfigs configs;
+    int n_sources;
+    bool trigger_mode; /**< Onsets drive the generators, otherwise the centroid */
+    int n_channels = 0;
+    size_t pos     = 0;
+
+    std::vector<std::unique_ptr<FeatureBank>> banks;
+    std::vector<std::unique_ptr<EnvelopeGenerator>> generators;
+    std::unique_ptr<EnvelopeCombinator> combinator;
+    std::unique_ptr<AudioDisperser> disperser;
+    std::vector<Block> signals;
+
+    PlanarBuffer source;    /**< Current block of one source */
+    PlanarBuffer control;   /**< Trigger or trajectory, spread and volume of one source */
+    PlanarBuffer envelopes; /**< Envelopes of all sources */
+    PlanarBuffer dispersed; /**< Mixed sources and combined envelopes */
+};
+
+/**
+ * @brief Pin the calling thread and raise its priority where the platform allows it
+ */
+void setup_thread(const Options& options)
+{
+#ifdef __linux__
+    if (options.cpu >= 0) {
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(options.cpu, &set);
+        if (pthread_setaffinity_np(pthread_self(), sizeof(set), &set) != 0) {
+            std::fprintf(stderr, "zerr_stress: cannot pin to CPU %d\n", options.cpu);
+        }
+    }
+    if (options.priority > 0) {
+        sched_param param{};
+        param.sched_priority = options.priority;
+        if (pthread_setschedparam(pthread_self(), SCHED_FIFO, &param) != 0) {
+            std::fprintf(stderr, "zerr_stress: cannot set SCHED_FIFO priority %d\n",
+                         options.priority);
+        }
+    }
+#else
+    if (options.cpu >= 0 || options.priority > 0) {
+        std::fprintf(stderr, "zerr_stress: pinning and priorities are only supported on Linux\n");
+    }
+#endif
+}
+
+/**
+ * @brief Background load: arithmetic on a buffer larger than the caches
+ */
+void load_worker(std::atomic<bool>& running)
+{
+    std::vector<double> buffer(8 << 20, 1.0);
+    size_t i = 0;
+    while (running.load(std::memory_order_relaxed)) {
+        for (size_t n = 0; n < 4096; ++n, i = (i + 4099) % buffer.size()) {
+            buffer[i] = buffer[i] * 0.999 + 0.001;
+        }
+    }
+}
+
+void usage()
+{
+    std::printf(
+        "usage: zerr_stress [options]\n"
+        "  --layout <yaml>      speaker layout (configs/ring_8.yaml)\n"
+        "  --mode <mode>        trigger or trajectory (trigger)\n"
+        "  --combine <mode>     add, root or max (add)\n"
+        "  --sources <n>        number of sources (2)\n"
+        "  --rate <hz>          sample rate (48000)\n"
+        "  --block <n>          samples per callback (64)\n"
+        "  --seconds <s>        duration (60)\n"
+        "  --deadline-ms <ms>   deadline of a callback (the block period)\n"
+        "  --cpu <n>            pin the callback thread to a CPU\n"
+        "  --priority <n>       run the callback thread with SCHED_FIFO priority n\n"
+        "  --load <n>           number of background load threads (0)\n"
+        "  --free-run           run callbacks back to back instead of once per period\n"
+        "  --csv <file>         write the histograms as CSV\n"
+        "  --trace <file>       write a Chrome trace on every xrun and at the end\n");
+}
+
+bool parse(int argc, char** argv, Options& options)
+{
+    for (int i = 1; i < argc; ++i) {
+        std::string arg   = argv[i];
+        const char* value = i + 1 < argc ? argv[i + 1] : nullptr;
+
+        if (arg == "--free-run") {
+            options.free_run = true;
+            continue;
+        }
+        if (!value) {
+            return false;
+        }
+        ++i;
+        if (arg == "--layout")
+            options.layout = value;
+        else if (arg == "--mode")
+            options.mode = value;
+        else if (arg == "--combine")
+            options.combine = value;
+        else if (arg == "--sources")
+            options.n_sources = std::max(1, std::atoi(value));
+        else if (arg == "--rate")
+            options.sample_rate = std::strtoul(value, nullptr, 10);
+        else if (arg == "--block")
+            options.block_size = std::strtoul(value, nullptr, 10);
+        else if (arg == "--seconds")
+            options.seconds = std::atof(value);
+        else if (arg == "--deadline-ms")
+            options.deadline_ms = std::atof(value);
+        else if (arg == "--cpu")
+            options.cpu = std::atoi(value);
+        else if (arg == "--priority")
+            options.priority = std::atoi(value);
+        else if (arg == "--load")
+            options.n_load = std::atoi(value);
+        else if (arg == "--csv")
+            options.csv_path = value;
+        else if (arg == "--trace")
+            options.trace_path = value;
+        else
+            return false;
+    }
+    return options.block_size > 0 && options.sample_rate > 0;
+}
+
+void print_histogram(const char* name, const Histogram& h)
+{
+    std::printf("%-10s p50 %9.2f  p99 %9.2f  p99.9 %9.2f  max %9.2f us\n", name,
+                h.percentile(0.5), h.percentile(0.99), h.percentile(0.999), h.max);
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    Options options;
+    if (!parse(argc, argv, options)) {
+        usage();
+        return 1;
+    }
+
+    const double period_us = 1e6 * options.block_size / options.sample_rate;
+    const double deadline_us =
+        options.deadline_ms > 0.0 ? options.deadline_ms * 1000.0 : period_us;
+    const uint64_t n_callbacks =
+        (uint64_t)(options.seconds * options.sample_rate / options.block_size);
+
+    std::unique_ptr<Chain> chain;
+    try {
+        chain = std::make_unique<Chain>(options);
+    }
+    catch (const std::exception& e) {
+        std::fprintf(stderr, "zerr_stress: %s\n", e.what());
+        return 1;
+    }
+
+    std::printf("chain: %d sources -> %d channels, %s mode, %s combination\n", options.n_sources,
+                chain->get_n_channels(), options.mode.c_str(), options.combine.c_str());
+    std::printf("block %zu at %zu Hz: period %.1f us, deadline %.1f us, %llu callbacks%s\n",
+                options.block_size, options.sample_rate, period_us, deadline_us,
+                (unsigned long long)n_callbacks, options.free_run ? ", free running" : "");
+
+    std::atomic<bool> running{true};
+    std::vector<std::thread> load;
+    for (int i = 0; i < options.n_load; ++i) {
+        load.emplace_back(load_worker, std::ref(running));
+    }
+
+    // 0.5us bins up to ten periods, larger values go to the overflow bin
+    Histogram execution(0.5, 10.0 * period_us);
+    Histogram jitter(0.5, 10.0 * period_us);
+    Histogram completion(0.5, 10.0 * period_us);
+    uint64_t xruns = 0;
+
+    Tracer& tracer = Tracer::instance();
+    if (!options.trace_path.empty()) {
+#ifndef ZERR_TRACING
+        std::fprintf(stderr, "zerr_stress: the core was built without ZERR_CORE_TRACING, the "
+                             "trace only shows the xruns\n");
+#endif
+        tracer.start();
+    }
+    std::atomic<bool> finished{false};
+
+    std::thread callback([&]() {
+        setup_thread(options);
+
+        const auto period = std::chrono::duration_cast<Clock::duration>(
+            std::chrono::duration<double, std::micro>(period_us));
+        auto wake = Clock::now() + period;
+
+        for (uint64_t n = 0; n < n_callbacks; ++n) {
+            if (!options.free_run) {
+                std::this_thread::sleep_until(wake);
+            }
+            auto start = Clock::now();
+            chain->process();
+            auto stop = Clock::now();
+
+            double late_us = options.free_run
+                                 ? 0.0
+                                 : std::chrono::duration<double, std::micro>(start - wake).count();
+            double exec_us = std::chrono::duration<double, std::micro>(stop - start).count();
+
+            jitter.add(late_us);
+            execution.add(exec_us);
+            completion.add(late_us + exec_us);
+            // the host needs the block one period after the callback was due
+            if (late_us + exec_us > deadline_us) {
+                ++xruns;
+                tracer.mark_xrun();
+            }
+
+            wake += period;
+            if (stop > wake + period) {
+                // after an xrun the host drops the missed periods instead of catching up
+                wake = stop + period;
+            }
+        }
+        finished.store(true);
+    });
+
+    // the trace is written from this thread, so that the callback never waits for the disk
+    int n_dumps = 0;
+    while (!finished.load()) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        n_dumps += tracer.dump_xrun(options.trace_path);
+    }
+    callback.join();
+
+    running.store(false);
+    for (auto& thread : load) {
+        thread.join();
+    }
+
+    std::printf("\n");
+    print_histogram("execution", execution);
+    if (!options.free_run) {
+        print_histogram("wake-up", jitter);
+        print_histogram("complete", completion);
+    }
+
+    const double per_minute = 60.0 * options.sample_rate / options.block_size;
+    std::printf("\nxruns: %llu of %llu callbacks (%.3g per minute)\n", (unsigned long long)xruns,
+                (unsigned long long)n_callbacks, (double)xruns / n_callbacks * per_minute);
+
+    // the measured distribution predicts the rate at other deadlines with the same load
+    const Histogram& basis = options.free_run ? execution : completion;
+    std::printf("\n%12s %14s %14s\n", "deadline us", "P(xrun)", "xruns/minute");
+    for (double fraction : {0.25, 0.5, 0.75, 1.0, 1.5, 2.0}) {
+        double d = fraction * deadline_us;
+        double p = basis.exceeding(d);
+        std::printf("%12.1f %14.3g %14.3g\n", d, p, p * per_minute);
+    }
+
+    if (!options.trace_path.empty()) {
+        tracer.stop();
+        if (!tracer.write_json(options.trace_path)) {
+            std::fprintf(stderr, "zerr_stress: cannot write %s\n", options.trace_path.c_str());
+            return 1;
+        }
+        std::printf("\ntrace: %s, written %d times on xruns\n", options.trace_path.c_str(),
+                    n_dumps);
+    }
+
+    if (!options.csv_path.empty()) {
+        std::ofstream csv(options.csv_path);
+        csv << "us,execution,wakeup,complete\n";
+        for (size_t i = 0; i < execution.bins.size(); ++i) {
+            if (execution.bins[i] || jitter.bins[i] || completion.bins[i]) {
+                csv << i * execution.bin_us << "," << execution.bins[i] << "," << jitter.bins[i]
+                    << "," << completion.bins[i] << "\n";
+            }
+        }
+    }
+
+    return 0;
+}
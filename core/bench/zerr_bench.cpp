@@ -0,0 +1,448 @@
+/**
+ * @file zerr_bench.cpp
+ * @author Zeyu Yang (zeyuuyang42@gmail.com)
+ * @brief Performance suite sweeping the modules over block sizes, features and speaker layouts
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2023-2026
+ */
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "audiodisperser.h"
+#include "envelopecombinator.h"
+#include "envelopegenerator.h"
+#include "featurebank.h"
+
+using namespace zerr;
+
+namespace fs = std::filesystem;
+
+namespace {
+
+const size_t SAMPLE_RATE = 48000;
+
+/**
+ * @brief One benchmark case: a configured module and the call that processes one block
+ */
+struct Case {
+    std::string name;   /**< Unique name, module/param:value/... */
+    std::string module; /**< Benchmarked module */
+    std::vector<std::pair<std::string, std::string>> params; /**< Swept parameters */
+    size_t block_size;             /**< Samples per block */
+    std::function<void()> process; /**< Processes one block */
+};
+
+/**
+ * @brief Timing of one case
+ */
+struct Result {
+    size_t iterations;     /**< Number of processed blocks */
+    double ns_per_sample;  /**< Wall time per sample frame in nanoseconds */
+    double realtime_ratio; /**< Wall time over audio time, 1.0 uses one core completely */
+};
+
+/**
+ * @brief Command line options
+ */
+struct Options {
+    std::string json_path; /**< Write the results as JSON to this file */
+    std::string filter;    /**< Only run cases whose name contains this string */
+    std::string configs_dir = ZERR_CONFIGS_DIR; /**< Directory of the speaker layouts */
+    double min_time         = 0.2;   /**< Minimum measured wall time per case in seconds */
+    bool list               = false; /**< Only print the case names */
+};
+
+/**
+ * @brief Test signal: a tone with some noise, so that no silence gate closes
+ */
+Block test_signal(size_t size, unsigned seed)
+{
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<double> noise(-0.5, 0.5);
+
+    Block signal(size);
+    for (size_t i = 0; i < size; ++i) {
+        signal[i] =
+            (Sample)(0.5 * std::sin(2.0 * PI * 440.0 * i / SAMPLE_RATE) + 0.1 * noise(rng));
+    }
+    return signal;
+}
+
+/**
+ * @brief Name of a case from its module and parameters
+ */
+std::string case_name(const Case& c)
+{
+    std::string name = c.module;
+    for (const auto& p : c.params) {
+        name += "/" + p.first + ":" + p.second;
+    }
+    return name;
+}
+
+Case make_case(const std::string& module, std::vector<std::pair<std::string, std::string>> params,
+               size_t block_size, std::function<void()> process)
+{
+    Case c{"", module, std::move(params), block_size, std::move(process)};
+    c.params.emplace_back("block", std::to_string(block_size));
+    c.name = case_name(c);
+    return c;
+}
+
+/**
+ * @brief Feature bank cases: block sizes, frame sizes and feature sets
+ */
+void add_featurebank_cases(std::vector<Case>& cases)
+{
+    const std::vector<std::pair<std::string, FeatureNames>> sets = {
+        {"wave", {"rms", "zcr", "cf", "zc"}},
+        {"spectral", {"ctd", "flt", "rlf", "flx"}},
+        {"onset", {"osf"}},
+        {"all", {"rms", "zcr", "cf", "zc", "ctd", "flt", "rlf", "flx", "osf"}},
+    };
+
+    auto add = [&](const std::string& set_name, const FeatureNames& names, size_t frame_size,
+                   size_t block_size) {
+        auto bank   = std::make_shared<FeatureBank>();
+        auto signal = std::make_shared<Block>(test_signal(SAMPLE_RATE, 1));
+        auto block  = std::make_shared<Block>(block_size);
+        auto pos    = std::make_shared<size_t>(0);
+
+        // the frame size is selected per feature with the name@frame_size syntax
+        FeatureNames specs;
+        for (const auto& name : names) {
+            specs.push_back(name + "@" + std::to_string(frame_size));
+        }
+        bank->initialize(specs, SystemConfigs{SAMPLE_RATE, block_size});
+
+        cases.push_back(make_case(
+            "FeatureBank", {{"features", set_name}, {"frame", std::to_string(frame_size)}},
+            block_size, [bank, signal, block, pos, block_size]() {
+                if (*pos + block_size > signal->size()) {
+                    *pos = 0;
+                }
+                std::copy(signal->begin() + *pos, signal->begin() + *pos + block_size,
+                          block->begin());
+                *pos += block_size;
+                bank->perform(*block);
+            }));
+    };
+
+    for (size_t block_size = 16; block_size <= 2048; block_size *= 2) {
+        add("all", sets.back().second, AUDIO_BUFFER_SIZE, block_size);
+    }
+    for (size_t frame_size : {512, 1024, 4096, 8192}) {
+        add("all", sets.back().second, frame_size, 64);
+    }
+    for (size_t i = 0; i + 1 < sets.size(); ++i) {
+        add(sets[i].first, sets[i].second, AUDIO_BUFFER_SIZE, 64);
+    }
+}
+
+/**
+ * @brief Write a dome of speakers on a Fibonacci spiral over the upper hemisphere
+ * @return ConfigPath Path of the written layout
+ */
+ConfigPath write_dome_layout(size_t n_speakers)
+{
+    fs::path path = fs::temp_directory_path() /
+                    ("zerr_bench_dome_" + std::to_string(n_speakers) + ".yaml");
+    std::ofstream file(path);
+
+    const double golden_angle = 180.0 * (3.0 - std::sqrt(5.0));
+    file << "standard:\n";
+    for (size_t i = 0; i < n_speakers; ++i) {
+        double height    = (i + 0.5) / n_speakers;
+        double elevation = std::asin(height) * 180.0 / PI;
+        double azimuth   = std::fmod(i * golden_angle, 360.0) - 180.0;
+
+        file << "  " << i + 1 << ":\n"
+             << "    position: \n"
+             << "      spherical:\n"
+             << "        azimuth:        " << azimuth << "\n"
+             << "        elevation:      " << elevation << "\n"
+             << "        distance:       1.0\n";
+    }
+    return path.string();
+}
+
+/**
+ * @brief Envelope generator cases: shipped and synthetic layouts in both modes
+ */
+void add_generator_cases(std::vector<Case>& cases, const Options& options)
+{
+    std::vector<std::pair<std::string, ConfigPath>> layouts;
+    if (fs::is_directory(options.configs_dir)) {
+        for (const auto& entry : fs::directory_iterator(options.configs_dir)) {
+            if (entry.path().extension() == ".yaml") {
+                layouts.emplace_back(entry.path().stem().string(), entry.path().string());
+            }
+        }
+        std::sort(layouts.begin(), layouts.end());
+    }
+    else {
+        std::fprintf(stderr, "zerr_bench: no layouts in %s, only synthetic ones are used\n",
+                     options.configs_dir.c_str());
+    }
+    for (size_t n_speakers : {32, 64, 128, 256}) {
+        layouts.emplace_back("dome_" + std::to_string(n_speakers), write_dome_layout(n_speakers));
+    }
+
+    const size_t block_size = 64;
+    SystemConfigs configs{SAMPLE_RATE, block_size};
+
+    for (const auto& layout : layouts) {
+        for (const std::string mode : {"trigger", "trajectory"}) {
+            auto generator = std::make_shared<EnvelopeGenerator>(configs, layout.second, mode);
+            if (!generator->initialize()) {
+                std::fprintf(stderr, "zerr_bench: cannot load %s\n", layout.second.c_str());
+                continue;
+            }
+
+            // main input: a trigger every 100ms or a slow trajectory ramp
+            auto in  = std::make_shared<PlanarBuffer>(3, block_size);
+            auto pos = std::make_shared<size_t>(0);
+            std::fill((*in)[1].begin(), (*in)[1].end(), (Sample)0.3);
+            std::fill((*in)[2].begin(), (*in)[2].end(), (Sample)1.0);
+
+            cases.push_back(make_case(
+                "EnvelopeGenerator",
+                {{"mode", mode},
+                 {"layout", layout.first},
+                 {"speakers", std::to_string(generator->getNumSpeakers())}},
+                block_size, [generator, in, pos, mode, block_size]() {
+                    Sample* main = in->channel(0);
+                    for (size_t i = 0; i < block_size; ++i, ++*pos) {
+                        if (mode == "trigger") {
+                            main[i] = *pos % (SAMPLE_RATE / 10) == 0 ? 1.0 : 0.0;
+                        }
+                        else {
+                            main[i] = (Sample)((*pos % (SAMPLE_RATE * 4)) / (SAMPLE_RATE * 4.0));
+                        }
+                    }
+                    generator->perform(*in);
+                }));
+        }
+    }
+}
+
+/**
+ * @brief Envelope combinator and audio disperser cases
+ */
+void add_mixer_cases(std::vector<Case>& cases)
+{
+    const size_t block_size = 64;
+    SystemConfigs configs{SAMPLE_RATE, block_size};
+    Block signal = test_signal(block_size, 2);
+
+    for (const std::string mode : {"add", "root", "max"}) {
+        for (int n_sources : {2, 8}) {
+            for (int n_channels : {8, 64, 256}) {
+                auto combinator =
+                    std::make_shared<EnvelopeCombinator>(n_sources, n_channels, configs, mode);
+                combinator->initialize();
+
+                auto in = std::make_shared<PlanarBuffer>(n_sources * n_channels, block_size);
+                for (size_t ch = 0; ch < in->get_n_channels(); ++ch) {
+                    for (size_t i = 0; i < block_size; ++i) {
+                        in->channel(ch)[i] = std::fabs(signal[(i + ch) % block_size]);
+                    }
+                }
+
+                cases.push_back(make_case("EnvelopeCombinator",
+                                          {{"mode", mode},
+                                           {"sources", std::to_string(n_sources)},
+                                           {"channels", std::to_string(n_channels)}},
+                                          block_size,
+                                          [combinator, in]() { combinator->perform(*in); }));
+            }
+        }
+    }
+
+    for (int n_channels : {8, 64, 256}) {
+        auto disperser = std::make_shared<AudioDisperser>(n_channels, configs);
+        disperser->initialize();
+
+        auto in = std::make_shared<PlanarBuffer>(n_channels + 1, block_size);
+        for (size_t ch = 0; ch < in->get_n_channels(); ++ch) {
+            std::copy(signal.begin(), signal.end(), in->channel(ch));
+        }
+
+        cases.push_back(make_case("AudioDisperser", {{"channels", std::to_string(n_channels)}},
+                                  block_size, [disperser, in]() { disperser->perform(*in); }));
+    }
+}
+
+/**
+ * @brief Time a case, growing the number of blocks until min_time is reached
+ */
+Result run(const Case& c, double min_time)
+{
+    using clock = std::chrono::steady_clock;
+
+    // warm up caches, plans and the analysis history with a quarter second of audio
+    const size_t warmup = std::max<size_t>(1, SAMPLE_RATE / 4 / c.block_size);
+    for (size_t i = 0; i < warmup; ++i) {
+        c.process();
+    }
+
+    size_t iterations = 0;
+    size_t batch      = warmup;
+    double elapsed    = 0.0;
+    while (elapsed < min_time) {
+        auto start = clock::now();
+        for (size_t i = 0; i < batch; ++i) {
+            c.process();
+        }
+        elapsed += std::chrono::duration<double>(clock::now() - start).count();
+        iterations += batch;
+        batch *= 2;
+    }
+
+    double samples = (double)iterations * c.block_size;
+    return {iterations, elapsed * 1e9 / samples, elapsed / (samples / SAMPLE_RATE)};
+}
+
+std::string json_escape(const std::string& s)
+{
+    std::string out;
+    for (char ch : s) {
+        if (ch == '"' || ch == '\\') {
+            out += '\\';
+        }
+        out += ch;
+    }
+    return out;
+}
+
+/**
+ * @brief Write the results in a layout close to the Google Benchmark JSON output
+ */
+bool write_json(const std::string& path, const std::vector<Case>& cases,
+                const std::vector<Result>& results)
+{
+    std::ofstream file(path);
+    if (!file) {
+        return false;
+    }
+
+    char date[32];
+    std::time_t now = std::time(nullptr);
+    std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S", std::localtime(&now));
+
+    file << "{\n  \"context\": {\n"
+         << "    \"date\": \"" << date << "\",\n"
+         << "    \"library\": \"zerr_core " << ZERR_CORE_VERSION << "\",\n"
+         << "    \"fft_backend\": \"" << ZERR_FFT_BACKEND_NAME << "\",\n"
+         << "    \"sample_type\": \"" << (sizeof(Sample) == 4 ? "float" : "double") << "\",\n"
+         << "    \"sample_rate\": " << SAMPLE_RATE << "\n  },\n  \"benchmarks\": [";
+
+    for (size_t i = 0; i < cases.size(); ++i) {
+        const Case& c   = cases[i];
+        const Result& r = results[i];
+        file << (i ? ",\n" : "\n") << "    {\n"
+             << "      \"name\": \"" << json_escape(c.name) << "\",\n"
+             << "      \"module\": \"" << c.module << "\",\n";
+        for (const auto& p : c.params) {
+            file << "      \"" << p.first << "\": \"" << json_escape(p.second) << "\",\n";
+        }
+        file << "      \"iterations\": " << r.iterations << ",\n"
+             << "      \"ns_per_sample\": " << r.ns_per_sample << ",\n"
+             << "      \"realtime_ratio\": " << r.realtime_ratio << "\n    }";
+    }
+    file << "\n  ]\n}\n";
+
+    return (bool)file;
+}
+
+void usage()
+{
+    std::printf("usage: zerr_bench [--filter <substring>] [--min-time <seconds>]\n"
+                "                  [--configs <layout dir>] [--json <file>] [--list]\n");
+}
+
+bool parse(int argc, char** argv, Options& options)
+{
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool has_value  = i + 1 < argc;
+
+        if (arg == "--json" && has_value) {
+            options.json_path = argv[++i];
+        }
+        else if (arg == "--filter" && has_value) {
+            options.filter = argv[++i];
+        }
+        else if (arg == "--configs" && has_value) {
+            options.configs_dir = argv[++i];
+        }
+        else if (arg == "--min-time" && has_value) {
+            options.min_time = std::atof(argv[++i]);
+        }
+        else if (arg == "--list") {
+            options.list = true;
+        }
+        else {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    Options options;
+    if (!parse(argc, argv, options)) {
+        usage();
+        return 1;
+    }
+
+    std::vector<Case> all;
+    add_featurebank_cases(all);
+    add_generator_cases(all, options);
+    add_mixer_cases(all);
+
+    std::vector<Case> cases;
+    for (auto& c : all) {
+        if (c.name.find(options.filter) != std::string::npos) {
+            cases.push_back(std::move(c));
+        }
+    }
+
+    if (options.list) {
+        for (const auto& c : cases) {
+            std::printf("%s\n", c.name.c_str());
+        }
+        return 0;
+    }
+
+    std::printf("%-76s %12s %12s %10s\n", "case", "ns/sample", "rt ratio", "blocks");
+
+    std::vector<Result> results;
+    for (const auto& c : cases) {
+        results.push_back(run(c, options.min_time));
+        const Result& r = results.back();
+        std::printf("%-76s %12.2f %12.5f %10zu\n", c.name.c_str(), r.ns_per_sample,
+                    r.realtime_ratio, r.iterations);
+    }
+
+    if (!options.json_path.empty() && !write_json(options.json_path, cases, results)) {
+        std::fprintf(stderr, "zerr_bench: cannot write %s\n", options.json_path.c_str());
+        return 1;
+    }
+
+    return 0;
+}
@@ -28,6 +28,7 @@
 #include "rolloff.h"  // Frequency below which N% of spectrum lies
 
 // Sample-level features - Computed per-sample rather than per-block
+#include "onset.h"         // Onset triggers from spectral onset detection functions
 #include "zerocrossings.h" // Individual zero crossing points
 
 #endif // FEATURES_H
\ No newline at end of file
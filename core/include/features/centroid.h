@@ -62,13 +62,53 @@ namespace zerr
              * @brief Load new audio input data for processing
              * @param in Audio input data
              */
-            void fetch(AudioInputs in);
+            void fetch(const AudioInputs& in);
 
             /**
              * @brief Get the calculated centroid values
-             * @return FeatureVals The extracted centroid values
+             * @return const FeatureVals& The extracted centroid values
              */
-            FeatureVals send();
+            const FeatureVals& send();
+
+            /**
+             * @brief Input of the fused single pass, see StaticFeatureBank
+             */
+            static constexpr InputDomain domain = InputDomain::SPECTRUM;
+
+            /**
+             * @brief Start the single pass over a new spectrum
+             * @param data Values of the power spectrum
+             * @param n Number of values
+             */
+            void begin(const Sample* /*data*/, size_t n)
+            {
+                prv_y           = crr_y;
+                centroid        = 0.0;
+                total_magnitude = 0.0;
+                n_bins          = n;
+            }
+
+            /**
+             * @brief Add the frequency weighted power of one bin
+             * @param v Value at index i
+             * @param i Index of the value
+             */
+            void accumulate(Sample v, size_t i)
+            {
+                centroid += ((double)i * freq_max / (double)n_bins) * v;
+                total_magnitude += v;
+            }
+
+            /**
+             * @brief Normalise the weighted sum by the total power
+             * @param data Values of the power spectrum
+             * @param n Number of values
+             */
+            void finish(const Sample* /*data*/, size_t /*n*/)
+            {
+                crr_y = total_magnitude > 0.0 ? centroid / total_magnitude : centroid;
+            }
+
             // FeatureVals perform(AudioInputs x);
 
         private:
@@ -80,9 +120,11 @@ namespace zerr
             FeatureVal prv_y; ///< Previous centroid value
             FeatureVal crr_y; ///< Current centroid value
 
-            double freq_max; ///< Maximum frequency considered for centroid calculation
+            Accum centroid;         ///< Frequency weighted power of the current spectrum
+            Accum total_magnitude;  ///< Total power of the current spectrum
+            size_t n_bins;          ///< Number of bins of the current spectrum
 
-            LinearInterpolator linear_interpolator; ///< Interpolator for smoothing centroid values
+            double freq_max; ///< Maximum frequency considered for centroid calculation
         };
 
     } // namespace feature
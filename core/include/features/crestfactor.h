@@ -63,13 +63,59 @@ namespace zerr
              * @brief Load new audio input data for processing
              * @param in Audio input data
              */
-            void fetch(AudioInputs in);
+            void fetch(const AudioInputs& in);
 
             /**
              * @brief Get the calculated crest factor values
-             * @return FeatureVals The extracted crest factor values
+             * @return const FeatureVals& The extracted crest factor values
              */
-            FeatureVals send();
+            const FeatureVals& send();
+
+            /**
+             * @brief The crest factor works on the waveform only
+             * @return bool Always false
+             */
+            bool requires_spectrum() { return false; }
+
+            /**
+             * @brief Input of the fused single pass, see StaticFeatureBank
+             */
+            static constexpr InputDomain domain = InputDomain::WAVE;
+
+            /**
+             * @brief Start the single pass over a new frame
+             * @param data Values of the analysis frame
+             * @param n Number of values
+             */
+            void begin(const Sample* /*data*/, size_t /*n*/)
+            {
+                prv_y      = crr_y;
+                square_sum = 0.0;
+                peak_max   = 0.0;
+            }
+
+            /**
+             * @brief Add the square of one sample and track the peak
+             * @param v Value at index i
+             * @param i Index of the value
+             */
+            void accumulate(Sample v, size_t /*i*/)
+            {
+                square_sum += (Accum)v * v;
+                const double peak = std::abs(v);
+                peak_max          = peak > peak_max ? peak : peak_max;
+            }
+
+            /**
+             * @brief Divide the peak by the RMS of the frame
+             * @param data Values of the analysis frame
+             * @param n Number of values
+             */
+            void finish(const Sample* /*data*/, size_t n)
+            {
+                crr_y = peak_max / std::sqrt(square_sum / (double)n);
+            }
+
             // FeatureVals perform(AudioInputs x);
 
         private:
@@ -81,7 +127,8 @@ namespace zerr
             FeatureVal prv_y; ///< Previous crest factor value
             FeatureVal crr_y; ///< Current crest factor value
 
-            LinearInterpolator linear_interpolator; ///< Interpolator for smoothing crest factor values
+            Accum square_sum;  ///< Sum of squares of the current frame
+            Accum peak_max;    ///< Largest absolute sample of the current frame
         };
 
     } // namespace feature
@@ -63,13 +63,55 @@ namespace zerr
              * @brief Load new audio input data for processing
              * @param in Audio input data
              */
-            void fetch(AudioInputs in);
+            void fetch(const AudioInputs& in);
 
             /**
              * @brief Get the calculated flatness values
-             * @return FeatureVals The extracted flatness values
+             * @return const FeatureVals& The extracted flatness values
              */
-            FeatureVals send();
+            const FeatureVals& send();
+
+            /**
+             * @brief Input of the fused single pass, see StaticFeatureBank
+             */
+            static constexpr InputDomain domain = InputDomain::SPECTRUM;
+
+            /**
+             * @brief Start the single pass over a new spectrum
+             * @param data Values of the power spectrum
+             * @param n Number of values
+             */
+            void begin(const Sample* /*data*/, size_t /*n*/)
+            {
+                prv_y   = crr_y;
+                log_sum = 0.0;
+                sum     = 0.0;
+            }
+
+            /**
+             * @brief Add the logarithm and the value of one bin
+             * @param v Value at index i
+             * @param i Index of the value
+             */
+            void accumulate(Sample v, size_t /*i*/)
+            {
+                // the small constant avoids taking the log of 0
+                log_sum += std::log(v + 1e-10);
+                sum += v;
+            }
+
+            /**
+             * @brief Divide the geometric by the arithmetic mean
+             * @param data Values of the power spectrum
+             * @param n Number of values
+             */
+            void finish(const Sample* /*data*/, size_t n)
+            {
+                const double geometric_mean  = std::exp(log_sum / (double)n);
+                const double arithmetic_mean = sum / (double)n;
+                crr_y = arithmetic_mean != 0.0 ? geometric_mean / arithmetic_mean : 0.0;
+            }
+
             // FeatureVals perform(AudioInputs x);
 
         private:
@@ -81,7 +123,8 @@ namespace zerr
             FeatureVal prv_y; ///< Previous flatness value
             FeatureVal crr_y; ///< Current flatness value
 
-            LinearInterpolator linear_interpolator; ///< Interpolator for smoothing flatness values
+            Accum log_sum;  ///< Sum of the log power of the current spectrum
+            Accum sum;      ///< Sum of the power of the current spectrum
         };
 
     } // namespace feature
@@ -60,13 +60,62 @@ public:
      * @brief Load new audio input data for processing
      * @param in Audio input data
      */
-    void fetch(AudioInputs in);
+    void fetch(const AudioInputs& in);
 
     /**
      * @brief Get the calculated flux values
-     * @return FeatureVals The extracted flux values
+     * @return const FeatureVals& The extracted flux values
      */
-    FeatureVals send();
+    const FeatureVals& send();
+
+    /**
+     * @brief Flux is the change between successive frames
+     * @return bool Always true
+     */
+    bool requires_time_resolution() { return true; }
+
+    /**
+     * @brief Input of the fused single pass, see StaticFeatureBank
+     */
+    static constexpr InputDomain domain = InputDomain::SPECTRUM;
+
+    /**
+     * @brief Start the single pass over a new spectrum
+     * @param data Values of the power spectrum
+     * @param n Number of values
+     */
+    void begin(const Sample* /*data*/, size_t n)
+    {
+        prv_y = crr_y;
+        flux  = 0.0;
+        // frames of a larger resolution have more bins than the initial history
+        if (prv_x.size() < n) {
+            prv_x.resize(n, 0.0);
+        }
+    }
+
+    /**
+     * @brief Add the squared difference of one bin to the previous spectrum
+     * @param v Value at index i
+     * @param i Index of the value
+     */
+    void accumulate(Sample v, size_t i)
+    {
+        const Param diff = v - prv_x[i];
+        flux += diff * diff;
+    }
+
+    /**
+     * @brief Take the root and keep the spectrum for the next frame
+     * @param data Values of the power spectrum
+     * @param n Number of values
+     */
+    void finish(const Sample* data, size_t n)
+    {
+        crr_y = std::sqrt(flux);
+        prv_x.assign(data, data + n);
+    }
+
     // FeatureVals perform(AudioInputs x);
 
 private:
@@ -79,7 +128,7 @@ private:
     FeatureVal prv_y;   ///< Previous flux value
     FeatureVal crr_y;   ///< Current flux value
 
-    LinearInterpolator linear_interpolator; ///< Interpolator for smoothing flux values
+    Param flux; ///< Sum of squared bin differences of the current spectrum
 };
 
 } //namespace feature
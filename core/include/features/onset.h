@@ -0,0 +1,115 @@
+/**
+ * @file onset.h
+ * @author Zeyu Yang (zeyuuyang42@gmail.com)
+ * @brief Implementation of spectral onset detection as a trigger feature
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2023-2026
+ */
+
+#ifndef ONSET_H
+#define ONSET_H
+
+#include "configs.h"
+#include "featureextractor.h"
+#include "spectralonsetdetector.h"
+#include "utils.h"
+
+namespace zerr
+{
+    namespace feature
+    {
+        /**
+         * @brief Onset detection - Outputs a trigger at the sample position of detected onsets
+         *
+         * The onset feature runs a SpectralOnsetDetector on the complex spectrum shared by the
+         * FeatureBank. The output is a sample-level trigger signal which is 1.0 at the estimated
+         * onset sample and 0.0 elsewhere, so it can drive the trigger mode of the envelope
+         * generator directly. Onsets are reported one block after the peak of the detection
+         * function, which itself trails the physical onset by up to half an analysis frame.
+         */
+        class Onset : public FeatureExtractor
+        {
+        public:
+            static const std::string name;        ///< Name identifier for this feature
+            static const std::string category;    ///< Category this feature belongs to
+            static const std::string description; ///< Description of what this feature measures
+
+            /**
+             * @brief Construct a new Onset extractor
+             * @param odf The onset detection function used by the detector
+             */
+            explicit Onset(OnsetFunction odf = OnsetFunction::SPECTRAL_FLUX) : detector(odf) {}
+
+            /**
+             * @brief Get the name identifier of this feature
+             * @return std::string The feature name
+             */
+            std::string get_name() { return name; }
+
+            /**
+             * @brief Get the category this feature belongs to
+             * @return std::string The feature category
+             */
+            std::string get_category() { return category; }
+
+            /**
+             * @brief Get the description of what this feature measures
+             * @return std::string The feature description
+             */
+            std::string get_description() { return description; }
+
+            /**
+             * @brief Initialize the onset extractor with system configurations
+             * @param sys_cfg System configuration parameters
+             */
+            void initialize(SystemConfigs sys_cfg);
+
+            /**
+             * @brief Run the onset detection on the current spectral frame
+             */
+            void extract();
+
+            /**
+             * @brief Reset the onset detector state
+             */
+            void reset();
+
+            /**
+             * @brief Load new audio input data for processing
+             * @param in Audio input data
+             */
+            void fetch(const AudioInputs& in);
+
+            /**
+             * @brief Get the onset trigger block
+             * @return const FeatureVals& Trigger values, 1.0 at onset samples
+             */
+            const FeatureVals& send();
+
+            /**
+             * @brief The onset detector works on the complex spectrum
+             * @return bool Always true
+             */
+            bool requires_complex_spectrum() { return true; }
+
+            /**
+             * @brief Onsets are changes between short successive frames
+             * @return bool Always true
+             */
+            bool requires_time_resolution() { return true; }
+
+        private:
+            /**
+             * @brief Reset internal parameters to initial state
+             */
+            void _reset_param();
+
+            FFTBuffer spectrum;             ///< Complex spectrum of the current frame
+            SpectralOnsetDetector detector; ///< Streaming onset detection engine
+        };
+
+    } // namespace feature
+} // namespace zerr
+
+#endif // ONSET_H
@@ -73,13 +73,44 @@ namespace zerr
              * @brief Load new audio input data for processing
              * @param in Audio input data
              */
-            void fetch(AudioInputs in);
+            void fetch(const AudioInputs& in);
 
             /**
              * @brief Get the calculated rolloff values
-             * @return FeatureVals The extracted rolloff values
+             * @return const FeatureVals& The extracted rolloff values
              */
-            FeatureVals send();
+            const FeatureVals& send();
+
+            /**
+             * @brief Input of the fused single pass, see StaticFeatureBank
+             */
+            static constexpr InputDomain domain = InputDomain::SPECTRUM;
+
+            /**
+             * @brief Start the single pass over a new spectrum
+             * @param data Values of the power spectrum
+             * @param n Number of values
+             */
+            void begin(const Sample* /*data*/, size_t /*n*/)
+            {
+                prv_y        = crr_y;
+                total_energy = 0.0;
+            }
+
+            /**
+             * @brief Add the power of one bin to the total energy
+             * @param v Value at index i
+             * @param i Index of the value
+             */
+            void accumulate(Sample v, size_t /*i*/) { total_energy += v; }
+
+            /**
+             * @brief Search the bin below which the rolloff percentage of the energy lies
+             * @param data Values of the power spectrum
+             * @param n Number of values
+             */
+            void finish(const Sample* data, size_t n);
+
             // FeatureVals perform(AudioInputs x);
 
         private:
@@ -91,10 +122,10 @@ namespace zerr
             FeatureVal prv_y; ///< Previous rolloff value
             FeatureVal crr_y; ///< Current rolloff value
 
+            Accum total_energy;  ///< Total power of the current spectrum
+
             double freq_max;              ///< Maximum frequency considered for rolloff calculation
             double rolloffPercent = 0.85; ///< Percentage threshold for spectral energy accumulation
-
-            LinearInterpolator linear_interpolator; ///< Interpolator for smoothing rolloff values
         };
 
     } // namespace feature
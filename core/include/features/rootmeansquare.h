@@ -76,13 +76,53 @@ namespace zerr
              * @brief Load new audio input data for processing
              * @param in Audio input data
              */
-            void fetch(AudioInputs in);
+            void fetch(const AudioInputs& in);
 
             /**
              * @brief Get the calculated RMS values
-             * @return FeatureVals The extracted RMS values
+             * @return const FeatureVals& The extracted RMS values
              */
-            FeatureVals send();
+            const FeatureVals& send();
+
+            /**
+             * @brief The root mean square works on the waveform only
+             * @return bool Always false
+             */
+            bool requires_spectrum() { return false; }
+
+            /**
+             * @brief Input of the fused single pass, see StaticFeatureBank
+             */
+            static constexpr InputDomain domain = InputDomain::WAVE;
+
+            /**
+             * @brief Start the single pass over a new frame
+             * @param data Values of the analysis frame
+             * @param n Number of values
+             */
+            void begin(const Sample* /*data*/, size_t /*n*/)
+            {
+                prv_y      = crr_y;
+                square_sum = 0.0;
+            }
+
+            /**
+             * @brief Add the square of one sample
+             * @param v Value at index i
+             * @param i Index of the value
+             */
+            void accumulate(Sample v, size_t /*i*/) { square_sum += (Accum)v * v; }
+
+            /**
+             * @brief Take the root of the mean square
+             * @param data Values of the analysis frame
+             * @param n Number of values
+             */
+            void finish(const Sample* /*data*/, size_t n)
+            {
+                crr_y = std::sqrt(square_sum / (double)n);
+            }
+
             // FeatureVals perform(AudioInputs x);
 
         private:
@@ -94,7 +134,7 @@ namespace zerr
             FeatureVal prv_y; ///< Previous RMS value
             FeatureVal crr_y; ///< Current RMS value
 
-            LinearInterpolator linear_interpolator; ///< Interpolator for smoothing RMS values
+            Accum square_sum;  ///< Sum of squares of the current frame
         };
 
     } // namespace feature
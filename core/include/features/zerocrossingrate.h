@@ -64,13 +64,58 @@ namespace zerr
              * @brief Load new audio input data for processing
              * @param in Audio input data
              */
-            void fetch(AudioInputs in);
+            void fetch(const AudioInputs& in);
 
             /**
              * @brief Get the calculated zero crossing rate values
-             * @return FeatureVals The extracted zero crossing rate values
+             * @return const FeatureVals& The extracted zero crossing rate values
              */
-            FeatureVals send();
+            const FeatureVals& send();
+
+            /**
+             * @brief The zero crossing rate works on the waveform only
+             * @return bool Always false
+             */
+            bool requires_spectrum() { return false; }
+
+            /**
+             * @brief Input of the fused single pass, see StaticFeatureBank
+             */
+            static constexpr InputDomain domain = InputDomain::WAVE;
+
+            /**
+             * @brief Start the single pass over a new frame
+             * @param data Values of the analysis frame
+             * @param n Number of values
+             */
+            void begin(const Sample* data, size_t n)
+            {
+                prv_y          = crr_y;
+                zero_crossings = 0;
+                last_sample    = n > 0 ? data[0] : 0.0;
+            }
+
+            /**
+             * @brief Count a sign change between the previous and this sample
+             * @param v Value at index i
+             * @param i Index of the value
+             */
+            void accumulate(Sample v, size_t /*i*/)
+            {
+                zero_crossings += (v >= 0 && last_sample < 0) || (v < 0 && last_sample >= 0);
+                last_sample = v;
+            }
+
+            /**
+             * @brief Normalise the count by the number of sample pairs
+             * @param data Values of the analysis frame
+             * @param n Number of values
+             */
+            void finish(const Sample* /*data*/, size_t n)
+            {
+                crr_y = static_cast<Param>(zero_crossings) / (Param)(n - 1);
+            }
+
             // FeatureVals perform(AudioInputs x);
 
         private:
@@ -81,10 +126,9 @@ namespace zerr
 
             FeatureVal prv_y; ///< Previous zero crossing rate value
             FeatureVal crr_y; ///< Current zero crossing rate value
-            // params
-            // int zero_crossings;
 
-            LinearInterpolator linear_interpolator; ///< Interpolator for smoothing zero crossing rate values
+            size_t zero_crossings; ///< Sign changes counted in the current frame
+            Sample last_sample;    ///< Previous sample of the current frame
         };
 
     } // namespace feature
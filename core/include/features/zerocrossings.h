@@ -64,13 +64,19 @@ namespace zerr
              * @brief Load new audio input data for processing
              * @param in Audio input data
              */
-            void fetch(AudioInputs in);
+            void fetch(const AudioInputs& in);
 
             /**
              * @brief Get the calculated zero crossings values
-             * @return FeatureVals The extracted zero crossings counts
+             * @return const FeatureVals& The extracted zero crossings counts
              */
-            FeatureVals send();
+            const FeatureVals& send();
+
+            /**
+             * @brief The zero crossings work on the input block only
+             * @return bool Always false
+             */
+            bool requires_spectrum() { return false; }
             // FeatureVals perform(AudioInputs x);
 
         private:
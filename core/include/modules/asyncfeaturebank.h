@@ -0,0 +1,168 @@
+/**
+ * @file asyncfeaturebank.h
+ * @author Zeyu Yang (zeyuuyang42@gmail.com)
+ * @brief Runs a FeatureBank on a worker thread, off the audio callback
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2023-2026
+ */
+#ifndef ASYNCFEATUREBANK_H
+#define ASYNCFEATUREBANK_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+#include "featurebank.h"
+#include "spscringbuffer.h"
+#include "triplebuffer.h"
+
+namespace zerr {
+
+/**
+ * @brief Asynchronous mode of the FeatureBank
+ *
+ * perform() runs on the audio thread and does not analyse anything. It pushes the input into
+ * a lock-free SPSCRingBuffer and returns the most recently published feature values from a
+ * TripleBuffer, without locking or allocating. A worker thread reads the input block by
+ * block, runs the FFTs and extractors of an ordinary FeatureBank at their hop rate and
+ * publishes the values of every block. The cost of the analysis is therefore paid on the
+ * worker and does not count against the audio deadline. The audio thread never signals the
+ * worker, which polls the input four times per block while it is idle.
+ *
+ * The returned values trail the input by up to a quarter block until the worker polls and by
+ * the time it needs for the analysis, which get_latency() reports in samples. The input ring
+ * holds at most max_latency samples that the worker has not started on. If the worker falls
+ * further behind, the newest input is dropped and counted by get_overruns(), which bounds the
+ * latency to max_latency plus the block in analysis, at the cost of a gap in the analysed
+ * signal.
+ */
+class AsyncFeatureBank {
+ public:
+    AsyncFeatureBank() = default;
+    /**
+     * @brief Stop the worker thread
+     */
+    ~AsyncFeatureBank();
+
+    AsyncFeatureBank(const AsyncFeatureBank&)            = delete;
+    AsyncFeatureBank& operator=(const AsyncFeatureBank&) = delete;
+
+    /**
+     * @brief Initialize the feature bank and start the worker thread
+     * @param feature_names List of feature names to activate, see FeatureBank::initialize()
+     * @param system_configs System configuration parameters
+     * @param n_channels Number of input channels analysed in parallel
+     * @param max_latency Samples the worker may fall behind before input is dropped, rounded
+     * up to whole blocks, 0 allows one frame of the largest resolution
+     */
+    void initialize(FeatureNames feature_names, SystemConfigs system_configs,
+                    size_t n_channels = 1, size_t max_latency = 0);
+    /**
+     * @brief Declare an analysis resolution, must be called before initialize()
+     * @see FeatureBank::add_resolution()
+     */
+    void add_resolution(size_t frame_size, size_t hop_size = 0, bool derive = false)
+    {
+        bank.add_resolution(frame_size, hop_size, derive);
+    }
+    /**
+     * @brief Select the interpolation of all features, must be called before initialize()
+     * @see FeatureBank::set_interpolation_mode()
+     */
+    void set_interpolation_mode(InterpolationMode mode) { interpolation_mode = mode; }
+    /**
+     * @brief Select how the spectra are computed, must be called before initialize()
+     * @see FeatureBank::set_spectrum_mode()
+     */
+    void set_spectrum_mode(SpectrumMode mode) { bank.set_spectrum_mode(mode); }
+    /**
+     * @brief Push an input block and get the latest feature values, audio thread only
+     * @param in Input audio block of the configured block size
+     * @return const FeaturesVals& Latest published values, valid until the next perform()
+     */
+    const FeaturesVals& perform(const Block& in);
+    /**
+     * @brief Push one input block per channel and get the latest feature values
+     * @param in Input audio blocks, one for each channel
+     * @return const FeaturesVals& Latest published values, grouped like FeatureBank::perform()
+     */
+    const FeaturesVals& perform(const Blocks& in);
+    /**
+     * @brief Stop the worker thread, perform() keeps returning the last values
+     */
+    void stop();
+    /**
+     * @brief Get the number of input channels analysed in parallel
+     * @return size_t Number of channels
+     */
+    size_t get_n_channels() const { return n_channels; }
+    /**
+     * @brief Get how far the returned values trail the input of the last perform()
+     * @return size_t Latency in samples
+     */
+    size_t get_latency() const { return latency.load(std::memory_order_relaxed); }
+    /**
+     * @brief Get the bound of the latency
+     * @return size_t Maximum latency in samples
+     */
+    size_t get_max_latency() const { return max_latency; }
+    /**
+     * @brief Get how often input was dropped because the worker fell behind
+     * @return uint64_t Number of overruns
+     */
+    uint64_t get_overruns() const { return input ? input->get_overruns() : 0; }
+    /**
+     * @brief Access the timing of perform() on the audio thread, disabled by default
+     * @return LoadMeter& Meter to enable and read from another thread
+     */
+    LoadMeter& get_load_meter() { return load_meter; }
+    /**
+     * @brief Access the timing of the analysis on the worker thread, disabled by default
+     * @return LoadMeter& Meter of the wrapped FeatureBank
+     */
+    LoadMeter& get_analysis_load_meter() { return bank.get_load_meter(); }
+
+ private:
+    /**
+     * @brief Feature values with the input position they were computed at
+     */
+    struct Frame {
+        FeaturesVals values; /**< Values of all features on all channels */
+        uint64_t position;   /**< Number of input samples analysed, including this block */
+    };
+
+    /**
+     * @brief Worker loop, analyses the buffered input and publishes the values
+     */
+    void _run();
+    /**
+     * @brief Account the pushed block and fetch the latest values
+     * @return const FeaturesVals& Latest published values
+     */
+    const FeaturesVals& _fetch();
+
+    FeatureBank bank;                              /**< Analysis run by the worker */
+    InterpolationMode interpolation_mode = InterpolationMode::LINEAR; /**< Feature curve */
+    std::unique_ptr<SPSCRingBuffer> input;         /**< Input from the audio thread */
+    std::unique_ptr<TripleBuffer<Frame>> frames;   /**< Values for the audio thread */
+    LoadMeter load_meter;                          /**< Timing of perform() */
+
+    size_t n_channels  = 1; /**< Number of input channels analysed in parallel */
+    size_t block_size  = 0; /**< Samples per perform() call */
+    size_t max_latency = 0; /**< Samples the worker may fall behind */
+
+    uint64_t pushed = 0;              /**< Input samples accepted by perform(), audio thread */
+    std::atomic<size_t> latency{0};   /**< Latency of the last perform() */
+
+    std::thread worker;                  /**< Runs _run() */
+    std::atomic<bool> running{false};    /**< Cleared to stop the worker */
+    std::mutex wake_mutex;               /**< Guards the wait of the worker */
+    std::condition_variable wake;        /**< Signalled when the worker is stopped */
+    std::chrono::microseconds poll_interval{1000}; /**< Wait of the idle worker between polls */
+};
+
+} // namespace zerr
+#endif // ASYNCFEATUREBANK_H
@@ -10,7 +10,9 @@
 #define AUDIODISPERSER_H
 
 #include <functional>
+#include "loadmeter.h"
 #include "logger.h"
+#include "planarbuffer.h"
 #include "types.h"
 
 namespace zerr {
@@ -34,7 +36,13 @@ class AudioDisperser {
      */
     bool initialize();
     /**
-     * @brief Process input audio blocks and disperse across channels
+     * @brief Process input audio and disperse across channels
+     * @param in Source audio in the first channel, followed by one envelope per output
+     * @return Dispersed output audio, valid until the next call
+     */
+    const PlanarBuffer& perform(const PlanarBuffer& in);
+    /**
+     * @brief Convenience overload of perform() for separate blocks, copies in and out
      * @param in Input audio blocks to process
      * @return Processed and dispersed output audio blocks
      */
@@ -44,14 +52,19 @@ class AudioDisperser {
      * @return The block size from system configuration
      */
     int get_block_size() { return systemCfgs.block_size; }
+    /**
+     * @brief Access the timing of perform(), disabled by default
+     * @return LoadMeter& Meter to enable and read from another thread
+     */
+    LoadMeter& get_load_meter() { return loadMeter; }
 
   private:
     int numChannel;              /**< Number of audio channels for dispersal */
     SystemConfigs systemCfgs;    /**< system configuration: sample_rate, block_size */
     std::string combinationMode; /**< Mode for combining audio signals */
     Logger* logger;              /**< Logger instance for debug/error messages */
-    Blocks inputBuffer;          /**< Buffer for storing input audio blocks */
-    Blocks outputBuffer;         /**< Buffer for storing processed output blocks */
+    PlanarBuffer outputBuffer;   /**< Buffer for storing processed output blocks */
+    LoadMeter loadMeter;         /**< Timing of perform() */
 };
 
 } // namespace zerr
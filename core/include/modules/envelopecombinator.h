@@ -10,7 +10,9 @@
 #define ENVELOPECOMBINATOR_H
 
 #include <functional>
+#include "loadmeter.h"
 #include "logger.h"
+#include "planarbuffer.h"
 #include "types.h"
 #include "utils.h"
 
@@ -43,11 +45,22 @@ class EnvelopeCombinator {
      */
     int get_block_size() { return systemCfgs.block_size; }
     /**
-     * @brief Process input envelope blocks and combine using selected mode
+     * @brief Process input envelopes and combine using selected mode
+     * @param in Input envelopes, the channels of all sources one after another
+     * @return Combined output envelopes, valid until the next call
+     */
+    const PlanarBuffer& perform(const PlanarBuffer& in);
+    /**
+     * @brief Convenience overload of perform() for separate blocks, copies in and out
      * @param in Input envelope blocks to process
      * @return Combined output envelope blocks
      */
     Blocks perform(Blocks in);
+    /**
+     * @brief Access the timing of perform(), disabled by default
+     * @return LoadMeter& Meter to enable and read from another thread
+     */
+    LoadMeter& get_load_meter() { return loadMeter; }
     /**
      * @brief Destructor for the Envelope Combinator
      */
@@ -61,11 +74,12 @@ class EnvelopeCombinator {
     int numChannel;                 /**< Number of channels per source */
     zerr::SystemConfigs systemCfgs; /**< system configuration: sample_rate, block_size */
     std::string combMode;           /**< Mode for combining envelopes */
+    LoadMeter loadMeter;            /**< Timing of perform() */
 
     Logger* logger; /**< Logger instance for debug/error messages */
 
-    Blocks inputBuffer;  /**< Buffer for storing input envelope blocks */
-    Blocks outputBuffer; /**< Buffer for storing combined output blocks */
+    PlanarBuffer inputBuffer;  /**< Buffer for storing input envelope blocks */
+    PlanarBuffer outputBuffer; /**< Buffer for storing combined output blocks */
 
     /**
      * @brief Process envelopes using addition combination mode
@@ -14,8 +14,12 @@
 #define CORE_ENVELOPEGENERATOR_H
 
 #include <functional>
+#include <vector>
+#include "loadmeter.h"
 #include "logger.h"
 #include "onsetdetector.h"
+#include "planarbuffer.h"
+#include "silencegate.h"
 #include "speakermanager.h"
 #include "types.h"
 
@@ -57,6 +61,14 @@ class EnvelopeGenerator {
     /**
      * @brief Main callback function of EnvelopeGenerator class.
      *
+     * @param in input multi-channel audio: main, spread and volume
+     * @return const PlanarBuffer& The generated multi-channel envelopes, valid until the next
+     * call
+     */
+    const PlanarBuffer& perform(const PlanarBuffer& in);
+    /**
+     * @brief Convenience overload of perform() for separate blocks, copies in and out
+     *
      * @param in input multi-channel audio blocks
      * @return Blocks The generated multi-channel envelopes.
      */
@@ -95,6 +107,12 @@ class EnvelopeGenerator {
      * @param newInterval The new interval value in milliseconds
      */
     void setTriggerInterval(Param newInterval);
+    /**
+     * @brief Seed the random speaker selection, so that a render can be repeated exactly.
+     *        Call after initialize(), the first speaker of the trigger mode is drawn again.
+     * @param seed Seed of the random engine
+     */
+    void setSeed(unsigned int seed);
     /**
      * @brief Prints the current parameter settings to the logger
      */
@@ -112,6 +130,24 @@ class EnvelopeGenerator {
      * @brief xxxxx
      */
     void setPrinter(Logger::PrintStrategy newPrinter);
+    /**
+     * @brief Queue the messages logged in perform() instead of printing them on the audio thread
+     * @param deferred Whether to defer, see Logger::setDeferred()
+     */
+    void setLogDeferred(bool deferred);
+    /**
+     * @brief Print the messages deferred by perform(), call from a non-real-time thread
+     */
+    void flushLog();
+    /**
+     * @brief Whether flushLog() has something to print, real-time safe
+     */
+    bool hasPendingLog() const;
+    /**
+     * @brief Access the timing of perform(), disabled by default
+     * @return LoadMeter& Meter to enable and read from another thread
+     */
+    LoadMeter& getLoadMeter() { return loadMeter; }
 
 
  private:
@@ -130,16 +166,20 @@ class EnvelopeGenerator {
     Mode triggerMode; /**< The strategy for choosing the next speaker to jump to
                          using trigger with topology */
 
-    AudioBuffers inputBuffers; /**< multi-channel input buffer in the shape of
+    PlanarBuffer inputBuffers; /**< multi-channel input buffer in the shape of
                                   input channel number x block size */
-    AudioBuffers outputBuffers; /**< multi-channel output buffer in the shape of
+    PlanarBuffer outputBuffers; /**< multi-channel output buffer in the shape of
                                    output channel number x block size */
 
     // SpeakerManager* speakerManager; /**< SpeakerManger object to access the speaker array information */
 
     OnsetDetector* onsetDetector; /**< Detector for identifying onset triggers in the input signal */
 
-    std::map<Index, size_t> indexChannelLookup; /**< index to channel reverse lookup table */
+    SilenceGate volumeGate; /**< Detects a muted volume input, which leaves the envelopes at zero */
+
+    LoadMeter loadMeter; /**< Timing of perform() */
+
+    std::vector<size_t> indexChannelLookup; /**< index to channel reverse lookup table */
     /**
      * @brief trigger mode envelope generation process.
      *           jump to a new output speaker when ever a trigger received
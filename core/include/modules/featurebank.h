@@ -7,9 +7,12 @@
 
 #include "audio_features.h"
 #include "configs.h"
+#include "featurebus.h"
 #include "featureextractor.h"
 #include "frequencytransformer.h"
+#include "loadmeter.h"
 #include "ringbuffer.h"
+#include "silencegate.h"
 #include "utils.h"
 
 namespace zerr {
@@ -19,6 +22,28 @@ namespace zerr {
  * FeatureBank is used to organize the behavior of all feature extractors uniformly.
  * It takes original audio block input and performs preprocessing like buffering and FFT,
  * then distributes the results to all activated feature extraction algorithms.
+ *
+ * Features can run at different analysis resolutions. A feature name may carry a frame size
+ * and an optional hop size, e.g. "zcr@256" or "ctd@4096/1024". All resolutions read from one
+ * ring buffer sized for the largest frame, and each resolution runs its own FFT once per hop.
+ * Between two hops, the features of a resolution hold their last value. Resolutions added with
+ * add_resolution() may derive their spectrum from the largest resolution instead of running
+ * an FFT of their own.
+ *
+ * In multichannel mode every feature runs once per input channel. The ring buffers of all
+ * channels share one allocation and each resolution transforms all channels with a single
+ * batched FFT. The output holds one value block per feature and channel, grouped by feature.
+ *
+ * A silence gate watches every channel. Once a channel has been silent long enough for all
+ * features to settle, its extractors are skipped and hold their values, except the triggers of
+ * the sample-level features, which stay at zero. When all channels are silent the FFTs are
+ * skipped as well. Only the ring buffer keeps running.
+ *
+ * Single features can be disabled, e.g. when nothing reads their output. A disabled feature is
+ * not extracted, and a resolution skips its FFT when no enabled feature reads a spectrum.
+ *
+ * The bank can publish its output on a named FeatureBus after every block, where other objects
+ * and processes read the latest value of every feature without a copy through the host.
  */
 class FeatureBank {
  public:
@@ -48,36 +73,168 @@ class FeatureBank {
      * @brief Initialize the feature bank with selected features and system configuration
      * @param feature_names List of feature names to activate
      * @param system_configs System configuration parameters
+     * @param n_channels Number of input channels analysed in parallel
+     */
+    void initialize(FeatureNames feature_names, SystemConfigs system_configs,
+                    size_t n_channels = 1);
+    /**
+     * @brief Declare an analysis resolution before initialize()
+     * @param frame_size Analysis frame size in samples
+     * @param hop_size Samples between two analyses, 0 analyses every block
+     * @param derive Derive the power spectrum from the largest resolution when the frame size
+     * divides it and the hop is a multiple of its hop, otherwise a dedicated FFT is used. Every
+     * derived bin is the average of a group of bins of the larger spectrum. This approximates
+     * only the bin spacing of the smaller frame: the bins are not scaled to match a real FFT of
+     * the smaller frame, and they keep the time resolution and latency of the largest frame.
+     * No complex spectrum is derived. initialize() therefore throws if a feature that compares
+     * successive frames or reads complex bins, e.g. flux or the onsets, would get a derived
+     * spectrum.
      */
-    void initialize(FeatureNames feature_names, SystemConfigs system_configs);
+    void add_resolution(size_t frame_size, size_t hop_size = 0, bool derive = false);
     /**
      * @brief Process an input audio block and extract all active features
-     * @param in Input audio block to analyze
-     * @return Map of feature names to extracted feature values
+     * @param in Input audio block to analyze, throws unless the bank has a single channel
+     * @return const FeaturesVals& Feature values, valid until the next perform()
      */
-    FeaturesVals perform(Block in);
+    const FeaturesVals& perform(const Block& in);
+    /**
+     * @brief Process one input block per channel and extract all active features
+     * @param in Input audio blocks, one for each channel
+     * @return Feature values, the value of feature f on channel c is at f * n_channels + c,
+     * valid until the next perform()
+     */
+    const FeaturesVals& perform(const Blocks& in);
+    /**
+     * @brief Process one channel of a planar buffer per input channel
+     * @param in Input audio with n_channels channels
+     * @return Feature values, the value of feature f on channel c is at f * n_channels + c,
+     * valid until the next perform()
+     */
+    const FeaturesVals& perform(const PlanarBuffer& in);
+    /**
+     * @brief Get the number of input channels analysed in parallel
+     * @return size_t Number of channels
+     */
+    size_t get_n_channels() const { return n_channels; }
     /**
      * @brief Reset the feature bank parameters and load a new set of features
      * @param feature_names New list of feature names to activate
      */
     void reset(FeatureNames feature_names);
+    /**
+     * @brief Select how all active features are interpolated between analysis frames
+     * @param mode Interpolation curve: hold, linear (default) or cubic
+     */
+    void set_interpolation_mode(InterpolationMode mode);
+    /**
+     * @brief Select how the spectra are computed, must be called before initialize()
+     *
+     * The sliding DFT updates every bin with each incoming sample, so its cost grows with the
+     * samples per second rather than with the spectra per second. Measured with
+     * bench/sliding_dft.cpp for frames of 512 to 2048 samples, it beats the FFT only at a hop
+     * of 1 or 2 samples, and even restricted to 64 bins it loses from a hop of about 4 to 16
+     * samples up. AUTO therefore uses the sliding DFT only for resolutions whose hop, and thus
+     * block, is at most SLIDING_DFT_MAX_HOP samples, and the FFT everywhere else.
+     *
+     * @param mode AUTO (default), full FFT or sliding DFT for all resolutions
+     */
+    void set_spectrum_mode(SpectrumMode mode) { spectrum_mode = mode; }
+    /**
+     * @brief Set the peak level below which an input channel counts as silent
+     * @param threshold Silence level, 0 analyses every block
+     */
+    void set_silence_threshold(Sample threshold);
+    /**
+     * @brief Enable or disable a feature on all channels, does not allocate
+     * @param index Position of the feature in the names given to initialize()
+     * @param enabled Whether the feature is extracted, a disabled feature outputs zeros
+     */
+    void set_feature_enabled(size_t index, bool enabled);
+    /**
+     * @brief Whether a feature is extracted
+     * @param index Position of the feature in the names given to initialize()
+     * @return bool True if the feature is enabled
+     */
+    bool is_feature_enabled(size_t index) const { return feature_enabled.at(index); }
+    /**
+     * @brief Access the timing of perform(), disabled by default
+     * @return LoadMeter& Meter to enable and read from another thread
+     */
+    LoadMeter& get_load_meter() { return load_meter; }
+    /**
+     * @brief Publish the latest value of every feature and channel after each block, not
+     * real-time safe
+     *
+     * Must be called after initialize(). The values are named as given to initialize(), with
+     * "/<channel>" appended in multichannel mode. Throws if the bus cannot be created.
+     *
+     * @param name Name of the bus, empty to stop publishing
+     */
+    void publish(const std::string& name);
+    /**
+     * @brief Access the bus the bank publishes on
+     * @return const FeatureBusWriter* The bus, null if the bank does not publish
+     */
+    const FeatureBusWriter* get_bus() const { return bus.get(); }
 
  private:
+    /**
+     * @brief Analysis settings and inputs shared by all features of one frame size
+     */
+    struct Resolution {
+        size_t frame_size; /**< Analysis frame size in samples */
+        size_t hop_size;   /**< Samples between two analyses, 0 for every block */
+        bool derive;       /**< Whether the spectrum is derived from the largest resolution */
+        bool enabled;      /**< Whether an enabled feature reads this resolution */
+        bool spectrum;     /**< Whether an enabled feature reads a spectrum of this resolution */
+        bool restart;      /**< Whether the sliding DFT restarts from an empty frame */
+        bool complex_spec; /**< Whether an enabled feature reads the complex spectrum */
+        bool due;          /**< Whether the resolution is analysed in the current block */
+        size_t elapsed;    /**< Samples since the last analysis */
+
+        std::unique_ptr<FrequencyTransformer> freq_transformer; /**< FFT of this resolution */
+
+        std::vector<AudioInputs> x; /**< Inputs of the features of this resolution per channel */
+    };
+
     std::map<std::string, CreateFunc> registed_features; /**< Map between feature names and their constructor functions */
 
-    std::vector<fe_ptr> activated_features; /**< Vector of pointers to activated feature objects */
+    std::vector<fe_ptr> activated_features; /**< Activated feature objects, one per feature and channel */
 
     RingBuffer ring_buffer; /**< Ring buffer to hold previous audio samples for analysis */
 
-    FrequencyTransformer freq_transformer; /**< FFT wrapper to perform frequency analysis
-                                              on audio signal input */
+    std::vector<Resolution> resolutions; /**< Analysis resolutions, the largest one first */
+
+    std::vector<size_t> feature_resolution; /**< Resolution index of every activated feature */
 
-    AudioInputs x; /**< Structure holding different types of feature inputs */
+    std::vector<bool> feature_enabled; /**< Whether each feature is extracted */
+
+    std::vector<bool> feature_triggers; /**< Whether every activated feature outputs triggers */
 
     FeaturesVals y; /**< Map containing extracted feature names and their values */
 
+    std::vector<SampleView> input_views; /**< Views of the input block of every channel */
+
+    std::vector<SilenceGate> silence_gates; /**< Activity of every input channel */
+
+    Sample silence_threshold = SILENCE_THRESHOLD; /**< Peak level of a silent channel */
+
     int n_features; /**< Number of currently activated features */
 
+    size_t n_channels = 1; /**< Number of input channels analysed in parallel */
+
+    SpectrumMode spectrum_mode = SpectrumMode::AUTO; /**< How the spectra are computed */
+
+    LoadMeter load_meter; /**< Timing of perform() */
+
+    std::vector<std::string> trace_labels; /**< Name of every activated feature in a trace */
+
+    FeatureNames bus_labels; /**< Name of every activated feature on a bus */
+
+    SystemConfigs system_configs{}; /**< Sample rate and block size given to initialize() */
+
+    std::unique_ptr<FeatureBusWriter> bus; /**< Bus receiving the output, null if unused */
+
     /**
      * @brief Register all available feature extractors to the FeatureBank
      *
@@ -100,6 +257,28 @@ class FeatureBank {
      * This should only run inside initialize function
      */
     std::unique_ptr<FeatureExtractor> _create(const std::string& className);
+    /**
+     * @brief Find the resolution of a frame size, adding it if it does not exist
+     * @param frame_size Analysis frame size in samples
+     * @param hop_size Samples between two analyses, 0 analyses every block
+     * @return size_t Index of the resolution
+     */
+    size_t _get_resolution(size_t frame_size, size_t hop_size);
+    /**
+     * @brief Run the FFT of a resolution or derive its spectrum from the largest one
+     * @param res The resolution whose wave has been updated
+     */
+    void _analyse_spectrum(Resolution& res);
+    /**
+     * @brief Find the resolutions and spectra the enabled features need
+     */
+    void _update_resolutions();
+    /**
+     * @brief Analyse the buffered frames and run all features on them
+     * @param in Pointer to views of the current input block of every channel
+     * @return const FeaturesVals& Values of all features on all channels
+     */
+    const FeaturesVals& _process(const SampleView* in);
 };
 
 } // namespace zerr
@@ -1,10 +1,23 @@
 #ifndef FEATUREEXTRACTOR_H
 #define FEATUREEXTRACTOR_H
 
+#include "linearinterpolator.h"
 #include "utils.h"
 
 namespace zerr
 {
+    /**
+     * @brief Input a feature reduces over in its fused single pass
+     *
+     * Features with a fused pass expose non-virtual begin(), accumulate() and finish() calls
+     * next to extract(). StaticFeatureBank runs all features of one domain in a single loop.
+     */
+    enum class InputDomain
+    {
+        WAVE,    ///< Samples of the analysis frame
+        SPECTRUM ///< Bins of the power spectrum
+    };
+
     /**
      * @brief Virtual base class that defines the interface for audio feature extractors
      *
@@ -55,12 +68,29 @@ namespace zerr
          * @brief Load new audio data into the input buffer
          * @param x Input audio data structure containing time/frequency domain signals
          */
-        virtual void fetch(AudioInputs x) = 0;
+        virtual void fetch(const AudioInputs& x) = 0;
         /**
          * @brief Retrieve the calculated feature values
-         * @return Map of feature names to their computed values
+         * @return const FeatureVals& The values of the current block, owned by the extractor and
+         * valid until the next send()
+         */
+        virtual const FeatureVals& send() = 0;
+        /**
+         * @brief Whether the extractor reads the complex spectrum in AudioInputs::fft
+         * @return True if the FeatureBank has to provide the complex spectrum
          */
-        virtual FeatureVals send() = 0;
+        virtual bool requires_complex_spectrum() { return false; }
+        /**
+         * @brief Whether the extractor reads a spectrum at all
+         * @return False if the FeatureBank can skip the FFT for this extractor
+         */
+        virtual bool requires_spectrum() { return true; }
+        /**
+         * @brief Whether the extractor compares successive frames and relies on the time
+         * resolution of its own frame size
+         * @return True if the FeatureBank must not derive its spectrum from a larger frame
+         */
+        virtual bool requires_time_resolution() { return false; }
         /**
          * @brief Check if the feature extractor is properly initialized
          * @return True if initialized, false otherwise
@@ -71,13 +101,22 @@ namespace zerr
          * @param s New initialization status
          */
         void set_initialize_statue(bool s) { initialized = s; }
+        /**
+         * @brief Select how feature values are interpolated between analysis frames
+         * @param mode Interpolation curve used when sending the feature values
+         */
+        void set_interpolation_mode(InterpolationMode mode) { linear_interpolator.set_mode(mode); }
 
     protected:
         Samples x;     /**< Input data buffer containing time or frequency domain samples */
         FeatureVals y; /**< Output buffer containing extracted feature values */
 
+        SampleView frame; /**< In-place view of the analysis frame, valid until the next fetch */
+
         SystemConfigs system_configs; /**< System configuration parameters */
         bool initialized = false;     /**< Tracks whether the extractor is initialized */
+
+        LinearInterpolator linear_interpolator; /**< Interpolator for smoothing values between frames */
     }; // Class FeatureExtractor
 
 } // Namespace zerr
@@ -221,15 +221,16 @@ class SpeakerManager {
      * @param mode The operation mode that determines the selection algorithm.
      * @return Index The selected speaker index based on the trigger and mode.
      */
-    Index getIndexesByTrigger(Param trigger, Mode mode);
+    Index getIndexesByTrigger(Param trigger, const Mode& mode);
 
     /**
      * @brief Get a vector of distances from a specific speaker index to all
      * other speakers.
      * @param spkrIdx The reference speaker index.
-     * @return Params A vector containing the Euclidean distances to all other speakers.
+     * @return const Params& A vector containing the Euclidean distances to all other speakers,
+     * empty for an unknown index.
      */
-    Params getDistanceVector(Index spkrIdx);
+    const Params& getDistanceVector(Index spkrIdx) const;
 
     /**
      * @brief Activate or deactivate speakers based on the given action and
@@ -261,6 +262,12 @@ class SpeakerManager {
      */
     void setCurrentSpeaker(Index newIdx);
 
+    /**
+     * @brief Restart the random speaker selection from a seed, for reproducible renders.
+     * @param seed Seed of the random engine, which is seeded randomly by default.
+     */
+    void setSeed(unsigned int seed) { randomEngine.seed(seed); }
+
     /**
      * @brief Print parameters related to the speaker manager's configuration
      * and state.
@@ -308,6 +315,7 @@ class SpeakerManager {
                         ///< trajectory for playback.
     TopoMatrix topoMatrix; ///< Matrix defining the connectivity and spatial
                            ///< relationships between speakers.
+    std::mt19937 randomEngine; ///< Random engine of the speaker selection, seeded once.
 
     /**
      * @brief Initializes the distance matrix used for spatial calculations.
@@ -316,12 +324,11 @@ class SpeakerManager {
     void _initDistanceMatrix();
 
     /**
-     * @brief Generates a vector of random speaker indexes.
-     * @param l The lower bound for random index generation.
-     * @param n The number of random indexes to generate.
-     * @return Indexes A vector of n unique random speaker indexes >= l.
+     * @brief Draws a random position, without allocating on the audio thread.
+     * @param l The number of positions to choose from.
+     * @return int A random position in [0, l).
      */
-    Indexes _getRandomIndexes(int l, int n);
+    int _getRandomIndex(int l);
 
     /**
      * @brief Calculates the Euclidean distance between two speakers.
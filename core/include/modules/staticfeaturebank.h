@@ -0,0 +1,255 @@
+/**
+ * @file staticfeaturebank.h
+ * @author Zeyu Yang (zeyuuyang42@gmail.com)
+ * @brief Feature bank with a feature set fixed at compile time and fused feature loops
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2023-2026
+ */
+#ifndef STATICFEATUREBANK_H
+#define STATICFEATUREBANK_H
+
+#include <memory>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "audio_features.h"
+#include "frequencytransformer.h"
+#include "ringbuffer.h"
+
+namespace zerr {
+
+/**
+ * @brief Feature bank whose features are template arguments
+ *
+ * The extractors are stored by value in a tuple and called through their concrete type, so
+ * there is no virtual dispatch and no allocation per extractor. Features that expose a fused
+ * single pass (see InputDomain) share one loop per input: all wave features run in one pass
+ * over the analysis frame and all spectral features in one pass over the power spectrum.
+ * These loops are inlined into perform(), which lets the compiler vectorise them across
+ * features. Other features, e.g. the onsets, run their own fetch() and extract().
+ *
+ *     StaticFeatureBank<feature::RootMeanSquare, feature::Centroid, feature::Flux> bank;
+ *     bank.initialize(system_configs);
+ *     const FeaturesVals& y = bank.perform(block);
+ *
+ * The bank analyses one channel at one resolution of system_configs.frame_size samples in
+ * every block, which is the default setup of the FeatureBank and produces the same values.
+ * Feature sets chosen at runtime, multiple resolutions or channels and the sliding DFT stay
+ * with the FeatureBank.
+ *
+ * @tparam Features Feature extractor classes, each deriving from FeatureExtractor
+ */
+template <typename... Features> class StaticFeatureBank {
+ public:
+    static constexpr size_t n_features = sizeof...(Features); /**< Number of features */
+
+    /**
+     * @brief Construct a new Static Feature Bank, call initialize() before perform()
+     */
+    StaticFeatureBank() : ring_buffer(AUDIO_BUFFER_SIZE) {}
+    /**
+     * @brief Initialize all features and allocate the analysis buffers
+     * @param system_configs System configuration, frame_size sets the analysis frame
+     */
+    void initialize(SystemConfigs system_configs)
+    {
+        if (system_configs.frame_size < 2) {
+            throw std::runtime_error("Analysis frame size " +
+                                     std::to_string(system_configs.frame_size) +
+                                     " is too small");
+        }
+        frame_size   = system_configs.frame_size;
+        ring_buffer  = RingBuffer(frame_size);
+        complex_spec = false;
+
+        std::apply(
+            [&](auto&... feature) {
+                ((feature.initialize(system_configs),
+                  complex_spec |= feature.requires_complex_spectrum()),
+                 ...);
+            },
+            features);
+
+        if (_needs_spectrum() || complex_spec) {
+            freq_transformer = std::make_unique<FrequencyTransformer>(frame_size);
+        }
+        // the inputs are sized here, so that perform() does not allocate
+        x.block.assign(system_configs.block_size, 0.0);
+        x.spec.assign(frame_size / 2 + 1, 0.0);
+        x.fft.assign(frame_size / 2 + 1, Complex{0.0, 0.0});
+        y.assign(n_features, FeatureVals(system_configs.block_size, 0.0f));
+    }
+    /**
+     * @brief Process an input block and extract all features
+     * @param in Input audio block
+     * @return const FeaturesVals& Values of the features in template argument order, valid
+     * until the next perform()
+     */
+    const FeaturesVals& perform(const Block& in)
+    {
+        ring_buffer.enqueue(in);
+        if constexpr (_needs_block()) {
+            x.block = in;
+        }
+        x.wave = ring_buffer.view(frame_size);
+
+        if (freq_transformer) {
+            _analyse_spectrum();
+        }
+
+        constexpr auto all = std::index_sequence_for<Features...>{};
+        _reduce<InputDomain::WAVE>(x.wave.data(), x.wave.size(), all);
+        _reduce<InputDomain::SPECTRUM>(x.spec.data(), x.spec.size(), all);
+        _extract_unfused(all);
+        _send(all);
+
+        return y;
+    }
+    /**
+     * @brief Select how all features are interpolated between analysis frames
+     * @param mode Interpolation curve: hold, linear (default) or cubic
+     */
+    void set_interpolation_mode(InterpolationMode mode)
+    {
+        std::apply([mode](auto&... feature) { (feature.set_interpolation_mode(mode), ...); },
+                   features);
+    }
+    /**
+     * @brief Access a feature extractor, e.g. to configure it
+     * @tparam I Position of the feature in the template arguments
+     * @return The feature extractor
+     */
+    template <size_t I> auto& get() { return std::get<I>(features); }
+
+ private:
+    /**
+     * @brief Whether a feature exposes the fused single pass
+     */
+    template <typename F, typename = void> struct is_fused : std::false_type {};
+    template <typename F>
+    struct is_fused<F, std::void_t<decltype(F::domain)>> : std::true_type {};
+
+    /**
+     * @brief Whether a feature runs in the fused pass over the given input
+     */
+    template <InputDomain D, typename F> static constexpr bool _reads()
+    {
+        if constexpr (is_fused<F>::value) {
+            return F::domain == D;
+        }
+        else {
+            return false;
+        }
+    }
+
+    /**
+     * @brief Whether a feature reads the power spectrum in the fused pass
+     */
+    static constexpr bool _needs_spectrum()
+    {
+        return (_reads<InputDomain::SPECTRUM, Features>() || ...);
+    }
+
+    /**
+     * @brief Whether a feature without a fused pass needs the input block
+     */
+    static constexpr bool _needs_block() { return (!is_fused<Features>::value || ...); }
+
+    /**
+     * @brief Run all features of one input domain in a single loop
+     */
+    template <InputDomain D, size_t... I>
+    void _reduce(const Sample* data, size_t n, std::index_sequence<I...>)
+    {
+        if constexpr ((_reads<D, Features>() || ...)) {
+            (_begin<D>(std::get<I>(features), data, n), ...);
+            for (size_t i = 0; i < n; ++i) {
+                const Sample v = data[i];
+                (_accumulate<D>(std::get<I>(features), v, i), ...);
+            }
+            (_finish<D>(std::get<I>(features), data, n), ...);
+        }
+    }
+
+    template <InputDomain D, typename F> static void _begin(F& f, const Sample* data, size_t n)
+    {
+        if constexpr (_reads<D, F>()) {
+            f.begin(data, n);
+        }
+    }
+
+    template <InputDomain D, typename F> static void _accumulate(F& f, Sample v, size_t i)
+    {
+        if constexpr (_reads<D, F>()) {
+            f.accumulate(v, i);
+        }
+    }
+
+    template <InputDomain D, typename F> static void _finish(F& f, const Sample* data, size_t n)
+    {
+        if constexpr (_reads<D, F>()) {
+            f.finish(data, n);
+        }
+    }
+
+    /**
+     * @brief Run the features without a fused pass on the shared inputs
+     */
+    template <size_t... I> void _extract_unfused(std::index_sequence<I...>)
+    {
+        (_extract(std::get<I>(features)), ...);
+    }
+
+    template <typename F> void _extract(F& f)
+    {
+        if constexpr (!is_fused<F>::value) {
+            f.F::fetch(x);
+            f.F::extract();
+        }
+    }
+
+    /**
+     * @brief Collect the interpolated values of all features
+     */
+    template <size_t... I> void _send(std::index_sequence<I...>)
+    {
+        (_send(std::get<I>(features), y[I]), ...);
+    }
+
+    template <typename F> static void _send(F& f, FeatureVals& out) { out = f.F::send(); }
+
+    /**
+     * @brief Run the FFT of the current frame, as FeatureBank does for a single resolution
+     */
+    void _analyse_spectrum()
+    {
+        FrequencyTransformer& transformer = *freq_transformer;
+        std::copy(x.wave.begin(), x.wave.end(), transformer.fft_input());
+        transformer.windowing();
+        transformer.fft();
+        transformer.power_spectrum();
+        transformer.get_power_spectrum(x.spec, 0);
+        if (complex_spec) {
+            transformer.get_complex_spectrum(x.fft);
+        }
+    }
+
+    std::tuple<Features...> features; /**< Feature extractors, stored by value */
+
+    RingBuffer ring_buffer; /**< Ring buffer holding the analysis frame */
+
+    std::unique_ptr<FrequencyTransformer> freq_transformer; /**< FFT of the analysis frame */
+
+    AudioInputs x; /**< Inputs shared by all features */
+
+    FeaturesVals y; /**< Values of all features */
+
+    size_t frame_size = AUDIO_BUFFER_SIZE; /**< Analysis frame size in samples */
+
+    bool complex_spec = false; /**< Whether a feature reads the complex spectrum */
+};
+
+} // namespace zerr
+#endif // STATICFEATUREBANK_H
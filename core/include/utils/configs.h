@@ -11,6 +11,24 @@
 
 #define VOLUME_THRESHOLD 1e-4 /**< Minimum volume threshold for audio processing */
 
+#define SILENCE_THRESHOLD 1e-6 /**< Peak level below which the input of an analysis is idle */
+
+#define SILENCE_HOLD_TIME 0.5 /**< Seconds of silence before an analysis is bypassed */
+
+#define LOG_QUEUE_SIZE 64 /**< Number of log messages the audio thread can defer */
+
+#define LOAD_METER_WINDOW 1024 /**< Number of recent blocks the load statistics cover */
+
+#define TRACE_BUFFER_SIZE 65536 /**< Number of events the tracer keeps, a power of two */
+
+#define TRACE_NAME_SIZE 32 /**< Bytes of a traced stage name, including the terminator */
+
+#define SLIDING_DFT_MAX_HOP 2 /**< Largest hop in samples at which the sliding DFT beats the FFT */
+
+#define FEATURE_BUS_SIZE 64 /**< Number of frames a feature bus keeps by default */
+
+#define FEATURE_BUS_NAME_SIZE 32 /**< Bytes of a feature name on a bus, including the terminator */
+
 #define DISTANCE_SCALE 1e-1 /**< Scaling factor for distance calculations in speaker positioning */
 
 #endif  // CONFIGS_H
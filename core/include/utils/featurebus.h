@@ -0,0 +1,253 @@
+/**
+ * @file featurebus.h
+ * @author Zeyu Yang (zeyuuyang42@gmail.com)
+ * @brief Named shared-memory bus carrying the latest feature frames to other objects and processes
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2023-2026
+ *
+ * A bus is a POSIX shared memory object named "/zerr.<name>", e.g. /dev/shm/zerr.voice on
+ * Linux. One writer publishes a frame per block, the latest value of every feature, and any
+ * number of readers in the same or in other processes map the bus and read the frames in place:
+ *
+ *     offset                 content
+ *     0                      FeatureBusHeader, 128 bytes
+ *     128                    n_features names of FEATURE_BUS_NAME_SIZE bytes, NUL-padded
+ *     slot_offset            slot 0: FeatureBusSlot, then n_features float32 values
+ *     slot_offset + k *      slot k, frame i is in slot i % capacity
+ *       slot_size
+ *
+ * The slots form a seqlock ring. While the writer fills a slot its sequence is odd, afterwards
+ * it is 2 * (frame + 1), so a reader knows a frame is complete and was not overwritten by
+ * comparing the sequence before and after reading. Neither side ever waits for the other.
+ */
+#ifndef FEATUREBUS_H
+#define FEATUREBUS_H
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "configs.h"
+#include "types.h"
+
+namespace zerr {
+
+constexpr char FEATURE_BUS_MAGIC[8]    = {'Z', 'E', 'R', 'R', 'B', 'U', 'S', '\0'};
+constexpr uint32_t FEATURE_BUS_VERSION = 1;
+
+/**
+ * @brief Header at the start of a bus
+ */
+struct FeatureBusHeader {
+    char magic[8];         /**< FEATURE_BUS_MAGIC, written last when the bus is created */
+    uint32_t version;      /**< FEATURE_BUS_VERSION */
+    uint32_t n_features;   /**< Values per frame */
+    uint32_t capacity;     /**< Slots of the ring, a power of two */
+    uint32_t slot_size;    /**< Bytes from the start of one slot to the next */
+    uint32_t name_size;    /**< FEATURE_BUS_NAME_SIZE */
+    uint32_t block_size;   /**< Samples between two frames */
+    double sample_rate;    /**< Sample rate of the analysed signal */
+    uint64_t slot_offset;  /**< Byte offset of slot 0 */
+    uint32_t writer_pid;   /**< Process of the writer */
+    uint8_t reserved[12];  /**< Zero */
+
+    alignas(64) std::atomic<uint64_t> published; /**< Number of frames published so far */
+    std::atomic<uint32_t> closed;                /**< Set when the writer removed the bus */
+};
+
+/**
+ * @brief Start of every slot, followed by the values of the frame
+ */
+struct FeatureBusSlot {
+    std::atomic<uint64_t> sequence; /**< Odd while written, 2 * (frame + 1) when complete */
+    uint64_t frame;                 /**< Number of the frame, counted from 0 */
+    int64_t time_ns;                /**< steady_clock time of publication, CLOCK_MONOTONIC */
+    uint64_t reserved;              /**< Zero */
+};
+
+static_assert(sizeof(FeatureBusHeader) == 128, "the bus header must stay 128 bytes");
+static_assert(sizeof(FeatureBusSlot) == 32, "the slot header must stay 32 bytes");
+static_assert(std::atomic<uint64_t>::is_always_lock_free,
+              "the bus needs lock-free 64-bit atomics to be shared between processes");
+
+/**
+ * @brief One frame copied from a bus
+ */
+struct FeatureFrame {
+    uint64_t frame  = 0;       /**< Number of the frame */
+    int64_t time_ns = 0;       /**< steady_clock time of publication */
+    std::vector<float> values; /**< Value of every feature */
+};
+
+/**
+ * @class FeatureBusWriter
+ * @brief Creates a bus and publishes feature frames on it
+ *
+ * Creating and destroying the writer is not real-time safe, publish() is: it copies one value
+ * per feature into the next slot and neither locks nor allocates. A bus has a single writer.
+ * Creating a bus whose name is taken by a living writer throws, a bus left behind by a writer
+ * that crashed is replaced. Destroying the writer removes the name, readers that still map the
+ * bus see is_closed() and can open the next bus of that name.
+ */
+class FeatureBusWriter {
+  public:
+    /**
+     * @brief Create the bus, throws if the name is taken or shared memory is unavailable
+     * @param name Name of the bus, without slashes
+     * @param feature_names Name of every value of a frame
+     * @param system_configs Sample rate and block size of the publishing analysis
+     * @param capacity Frames the ring keeps, rounded up to a power of two
+     */
+    FeatureBusWriter(const std::string& name, const FeatureNames& feature_names,
+                     SystemConfigs system_configs, size_t capacity = FEATURE_BUS_SIZE);
+    ~FeatureBusWriter();
+
+    FeatureBusWriter(const FeatureBusWriter&)            = delete;
+    FeatureBusWriter& operator=(const FeatureBusWriter&) = delete;
+
+    /**
+     * @brief Publish the value at the end of every block as one frame, real-time safe
+     * @param y Output of a FeatureBank, one block per value of the frame
+     */
+    void publish(const FeaturesVals& y);
+    /**
+     * @brief Publish one frame, real-time safe
+     * @param values One value per feature of the bus
+     */
+    void publish(const float* values);
+
+    const std::string& get_name() const { return name; }
+    size_t get_n_features() const { return n_features; }
+    uint64_t get_published() const { return frame; }
+
+  private:
+    std::string name;      /**< Name of the bus */
+    std::string shm_name;  /**< Name of the shared memory object */
+    size_t n_features = 0; /**< Values per frame */
+    void* memory      = nullptr;
+    size_t size       = 0; /**< Bytes mapped */
+    FeatureBusHeader* header = nullptr;
+    uint64_t frame           = 0; /**< Number of the next frame */
+
+    /**
+     * @brief Claim the next slot, returns the place of its values
+     */
+    float* _begin_frame();
+    /**
+     * @brief Complete the slot claimed by _begin_frame()
+     */
+    void _end_frame();
+};
+
+/**
+ * @class FeatureBusReader
+ * @brief Maps an existing bus and reads its frames without blocking the writer
+ *
+ * A reader never writes to the bus, so any number of readers can follow one writer. The
+ * accessors are real-time safe after construction. A reader that falls behind by more than
+ * the capacity of the ring loses the overwritten frames, read() reports them as unavailable.
+ */
+class FeatureBusReader {
+  public:
+    /**
+     * @brief Map a bus, throws if it does not exist or is not a valid bus
+     * @param name Name the writer created the bus with
+     */
+    explicit FeatureBusReader(const std::string& name);
+    ~FeatureBusReader();
+
+    FeatureBusReader(const FeatureBusReader&)            = delete;
+    FeatureBusReader& operator=(const FeatureBusReader&) = delete;
+
+    const std::string& get_name() const { return name; }
+    const FeatureNames& get_feature_names() const { return feature_names; }
+    size_t get_n_features() const { return feature_names.size(); }
+    size_t get_capacity() const { return header->capacity; }
+    double get_sample_rate() const { return header->sample_rate; }
+    size_t get_block_size() const { return header->block_size; }
+    /**
+     * @brief Position of a feature in a frame
+     * @param feature Name of the feature as published
+     * @return int Index of the value, -1 if the bus does not carry the feature
+     */
+    int find(const std::string& feature) const;
+    /**
+     * @brief Number of frames published so far, the latest frame is get_published() - 1
+     */
+    uint64_t get_published() const { return header->published.load(std::memory_order_acquire); }
+    /**
+     * @brief Whether the writer removed the bus, no more frames will follow
+     */
+    bool is_closed() const { return header->closed.load(std::memory_order_acquire) != 0; }
+    /**
+     * @brief Whether the name now refers to another bus or to none, e.g. after the writer
+     * crashed and was restarted, not real-time safe
+     */
+    bool is_replaced() const;
+    /**
+     * @brief Copy one frame
+     * @param frame Number of the frame
+     * @param out Receives the frame, its values are resized to the number of features
+     * @return bool False if the frame was not published yet or has been overwritten
+     */
+    bool read(uint64_t frame, FeatureFrame& out) const;
+    /**
+     * @brief Copy the latest frame
+     * @param out Receives the frame
+     * @return bool False if nothing was published yet
+     */
+    bool read_latest(FeatureFrame& out) const;
+    /**
+     * @brief Hand the latest frame to a function in place, without copying it
+     *
+     * The writer may overwrite the slot while the function runs, so the function should only
+     * read the values it needs. Whatever it derived from them is valid only if true is
+     * returned, otherwise it should be discarded and the call repeated.
+     *
+     * @param visit Called as visit(uint64_t frame, int64_t time_ns, const float* values)
+     * @return bool False if nothing was published yet or the frame was torn
+     */
+    template <typename Visitor>
+    bool visit_latest(Visitor&& visit) const
+    {
+        const uint64_t published = get_published();
+        if (published == 0) {
+            return false;
+        }
+        const uint64_t frame       = published - 1;
+        const FeatureBusSlot* slot = _slot(frame);
+        const uint64_t sequence    = slot->sequence.load(std::memory_order_acquire);
+        if (sequence != 2 * frame + 2) {
+            return false;
+        }
+        visit(frame, slot->time_ns, reinterpret_cast<const float*>(slot + 1));
+        std::atomic_thread_fence(std::memory_order_acquire);
+        return slot->sequence.load(std::memory_order_relaxed) == sequence;
+    }
+
+  private:
+    std::string name;           /**< Name of the bus */
+    FeatureNames feature_names; /**< Name of every value of a frame */
+    const void* memory = nullptr;
+    size_t size        = 0; /**< Bytes mapped */
+    uint64_t inode     = 0; /**< Identity of the mapped shared memory object */
+    const FeatureBusHeader* header = nullptr;
+
+    const FeatureBusSlot* _slot(uint64_t frame) const
+    {
+        const char* base = static_cast<const char*>(memory) + header->slot_offset;
+        return reinterpret_cast<const FeatureBusSlot*>(
+            base + (frame & (header->capacity - 1)) * header->slot_size);
+    }
+};
+
+/**
+ * @brief Names of the buses that currently exist, only listed on Linux
+ * @return FeatureNames Bus names, sorted
+ */
+FeatureNames list_feature_buses();
+
+} // namespace zerr
+#endif // FEATUREBUS_H
@@ -0,0 +1,88 @@
+/**
+ * @file fftbackend.h
+ * @author Zeyu Yang (zeyuuyang42@gmail.com)
+ * @brief Interface of the real FFT library selected at configure time
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2023-2026
+ */
+#ifndef FFTBACKEND_H
+#define FFTBACKEND_H
+
+namespace zerr {
+
+/**
+ * @class FFTBackend
+ * @brief Real-to-complex FFT of a batch of equally sized frames
+ *
+ * The implementation is chosen with the ZERR_FFT_BACKEND CMake option (FFTW, PFFFT or
+ * KISSFFT) and only one of them is compiled into the core. All backends share the FFTW
+ * conventions: the frames are stored one after another in the input buffer, the output holds
+ * frame_size / 2 + 1 interleaved complex bins per frame, the forward transform uses a negative
+ * exponent and neither direction is normalised.
+ *
+ * @tparam T Sample type, double or float
+ */
+template <typename T>
+class FFTBackend {
+  public:
+    /**
+     * @brief Allocate the buffers and plan the forward transform
+     * @param frame_size Number of samples per frame
+     * @param n_frames Number of frames transformed together
+     * @throws std::runtime_error if the backend does not support the frame size
+     */
+    FFTBackend(int frame_size, int n_frames);
+    /**
+     * @brief Release the plans and buffers
+     */
+    ~FFTBackend();
+
+    FFTBackend(const FFTBackend&)            = delete;
+    FFTBackend& operator=(const FFTBackend&) = delete;
+
+    /**
+     * @brief Get the real input buffer of frame_size * n_frames samples
+     * @return T* Pointer to the aligned input buffer
+     */
+    T* input() { return in; }
+    /**
+     * @brief Get the complex output buffer of (frame_size / 2 + 1) * n_frames bins
+     * @return T* Pointer to the aligned output buffer, real and imaginary parts interleaved
+     */
+    T* output() { return out; }
+    /**
+     * @brief Transform all frames from the input to the output buffer
+     */
+    void forward();
+    /**
+     * @brief Transform all frames from the output back to the input buffer
+     *
+     * The inverse plan is created on the first call.
+     */
+    void inverse();
+    /**
+     * @brief Get the name of the compiled-in backend
+     * @return const char* The backend name
+     */
+    static const char* name();
+    /**
+     * @brief Whether the library transforms in single precision, also for T = double
+     *
+     * PFFFT always converts to float around the transform and KissFFT computes in the
+     * kiss_fft_scalar it was built with, so a double FFTBackend may still carry float errors.
+     *
+     * @return bool True if the spectra are only accurate to float precision
+     */
+    static bool computes_in_float();
+
+  private:
+    struct Plan; ///< Library specific plans and work buffers
+
+    Plan* plan; ///< Owned plan of the backend
+    T* in;      ///< Real input buffer
+    T* out;     ///< Interleaved complex output buffer
+};
+
+} // namespace zerr
+#endif // FFTBACKEND_H
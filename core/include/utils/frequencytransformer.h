@@ -9,19 +9,58 @@
 #ifndef FREQUENCYTRANSFORMER_H
 #define FREQUENCYTRANSFORMER_H
 
-#include <fftw3.h>
-
+#include "fftbackend.h"
 #include "types.h"
 #include "utils.h"
 namespace zerr {
 
-class FrequencyTransformer {
+/**
+ * @brief Defines how the spectrum of the analysis frame is computed
+ */
+enum class SpectrumMode {
+    FFT,         ///< Full FFT of the buffered frame on every analysis
+    SLIDING_DFT, ///< Per-sample sliding DFT, updated incrementally with every input block
+    AUTO         ///< Chosen per resolution by the FeatureBank, a transformer runs the FFT
+};
+
+/**
+ * @class BasicFrequencyTransformer
+ * @brief Runs the FFT of one or several channels of equal frame size
+ *
+ * The frames of all channels are stored one after another in a single input buffer, and a
+ * single batched transform of the FFTBackend handles all of them at once. The backend owns
+ * aligned buffers and its plans, and creates the inverse plan on the first call of ifft().
+ *
+ * In SLIDING_DFT mode the spectrum is not computed from fft_in. Instead slide() feeds every
+ * new sample into a sliding DFT which updates each bin with one complex multiply-add, and
+ * fft() writes the current spectrum to the output buffer. The Hann window is applied in the
+ * frequency domain as a 3-tap convolution, so the result equals the FFT of the windowed
+ * frame. This is cheaper than a full FFT when only a few samples arrive between two
+ * analyses, and the work can be restricted to a range of bins.
+ *
+ * @tparam T Sample type of the transform, double or float
+ */
+template <typename T>
+class BasicFrequencyTransformer {
   public:
+    using complex = T[2];                            ///< Interleaved complex type, as in FFTW
+    using Buffer  = std::vector<T>;                  ///< Buffer type of spectra
+
     /**
      * @brief Construct a new Frequency Transformer object
      * @param L The frame size for FFT analysis
+     * @param n_channels The number of channels transformed together
+     * @param mode How the spectrum is computed
      */
-    FrequencyTransformer(int L);
+    BasicFrequencyTransformer(int L, int n_channels = 1, SpectrumMode mode = SpectrumMode::FFT);
+    /**
+     * @brief Destroy the plans and free the buffers
+     */
+    ~BasicFrequencyTransformer();
+
+    BasicFrequencyTransformer(const BasicFrequencyTransformer&)            = delete;
+    BasicFrequencyTransformer& operator=(const BasicFrequencyTransformer&) = delete;
+
     /**
      * @brief Perform Fast Fourier Transform
      * 
@@ -29,11 +68,41 @@ class FrequencyTransformer {
      * The input should be real-valued time domain signal.
      */
     void fft();
+    /**
+     * @brief Feed new samples into the sliding DFT
+     *
+     * Only used in SLIDING_DFT mode, where it has to be called with every input block.
+     *
+     * @param in Pointer to the new samples
+     * @param n Number of new samples
+     * @param channel The channel the samples belong to
+     */
+    void slide(const Sample* in, int n, int channel = 0);
+    /**
+     * @brief Restrict the sliding DFT to a range of bins
+     *
+     * Bins outside of the range read as zero. Only used in SLIDING_DFT mode. Changing the
+     * range clears the sliding DFT state.
+     *
+     * @param first The first bin to compute
+     * @param last The last bin to compute
+     */
+    void set_bin_range(int first, int last);
+    /**
+     * @brief Clear the sliding DFT state of one channel, as if its frame were all zeros
+     *
+     * Used when a channel skipped samples, e.g. while it was silent. Only used in
+     * SLIDING_DFT mode.
+     *
+     * @param channel The channel to clear
+     */
+    void clear_slide(int channel = 0);
     /**
      * @brief Perform Inverse Fast Fourier Transform
      * 
      * Run IFFT on fft_out buffer and save the result to fft_in buffer.
-     * Converts frequency domain data back to time domain.
+     * Converts frequency domain data back to time domain. The inverse plan is created on
+     * the first call, so this should not be first called from the audio thread.
      */
     void ifft();
     /**
@@ -45,24 +114,55 @@ class FrequencyTransformer {
     void power_spectrum();
     /**
      * @brief Get pointer to FFT input buffer
-     * @return double* Pointer to the real-valued input buffer
+     * @param channel The channel whose frame is requested
+     * @return T* Pointer to the real-valued input buffer
      */
-    double* fft_input();
+    T* fft_input(int channel = 0);
     /**
      * @brief Get pointer to FFT output buffer
-     * @return fftw_complex* Pointer to the complex-valued FFT output buffer
+     * @param channel The channel whose spectrum is requested
+     * @return complex* Pointer to the complex-valued FFT output buffer
+     */
+    complex* fft_output(int channel = 0);
+    /**
+     * @brief Get the computed power spectrum of the first channel
+     * @return Buffer Buffer containing the power spectrum values
      */
-    fftw_complex* fft_output();
+    Buffer get_power_spectrum();
     /**
-     * @brief Get the computed power spectrum
-     * @return AudioBuffer Buffer containing the power spectrum values
+     * @brief Copy the power spectrum of a channel into a buffer
+     * @param spectrum Destination buffer, resized to the number of bins
+     * @param channel The channel to copy
      */
-    AudioBuffer get_power_spectrum();
+    void get_power_spectrum(Buffer& spectrum, int channel);
+    /**
+     * @brief Compute the magnitude spectrum of a channel from the FFT output
+     * @param spectrum Destination buffer, resized to the number of bins
+     * @param channel The channel to compute
+     */
+    void get_magnitude_spectrum(Buffer& spectrum, int channel = 0);
+    /**
+     * @brief Compute the power spectrum of a channel in decibels
+     *
+     * Requires power_spectrum() to be run first.
+     *
+     * @param spectrum Destination buffer, resized to the number of bins
+     * @param channel The channel to compute
+     * @param floor Smallest power before the logarithm, avoids -inf for silent bins
+     */
+    void get_log_power_spectrum(Buffer& spectrum, int channel = 0, T floor = 1e-12);
+    /**
+     * @brief Copy the complex FFT output into a buffer
+     * @param spectrum Destination buffer, resized to the number of bins
+     * @param channel The channel to copy
+     */
+    void get_complex_spectrum(FFTBuffer& spectrum, int channel = 0);
 
     /**
      * @brief Apply window function to input data
      * 
-     * Applies windowing to reduce spectral leakage in FFT analysis
+     * Applies windowing to reduce spectral leakage in FFT analysis. In SLIDING_DFT mode the
+     * window is applied to the spectrum by fft() instead.
      */
     void windowing();
 
@@ -72,17 +172,60 @@ class FrequencyTransformer {
      */
     int get_frame_size() { return frame_size; }
 
+    /**
+     * @brief Get the number of channels transformed together
+     * @return int The number of channels
+     */
+    int get_n_channels() { return n_channels; }
+
+    /**
+     * @brief Get how the spectrum is computed
+     * @return SpectrumMode The spectrum mode
+     */
+    SpectrumMode get_mode() { return mode; }
+
   private:
     int frame_size;      ///< Size of the analysis frame in samples
     int fft_size;        ///< Size of the FFT (typically frame_size/2 + 1)
+    int n_channels;      ///< Number of channels stored one after another in the buffers
 
-    AudioBuffer power_spec;  ///< Buffer to store power spectrum results
+    T power_scale;       ///< Normalisation of the power spectrum, 1 / (2 * fft_size)
 
-    double* fft_in;         ///< Input buffer for FFT
-    fftw_complex* fft_out;  ///< Output buffer for FFT results
+    Buffer power_spec;   ///< Buffer to store power spectrum results
+    Buffer window;       ///< Precomputed Hann window of frame_size samples
 
-    fftw_plan p_fft, p_ifft;  ///< FFTW plan objects for forward and inverse transforms
+    FFTBackend<T> backend;  ///< FFT library selected at configure time
+
+    T* fft_in;           ///< Aligned input buffer for FFT, owned by the backend
+    complex* fft_out;    ///< Aligned output buffer for FFT results, owned by the backend
+
+    SpectrumMode mode;  ///< How the spectrum is computed
+
+    int bin_first;  ///< First bin of the sliding DFT output
+    int bin_last;   ///< Last bin of the sliding DFT output
+
+    std::vector<int> slide_pos;  ///< Write position in the sliding DFT history of every channel
+
+    // the recursion accumulates rounding errors, so its state stays double for float samples
+    std::vector<double> slide_history;  ///< Last frame_size samples of every channel
+    std::vector<double> slide_re;       ///< Real parts of the unwindowed sliding spectrum
+    std::vector<double> slide_im;       ///< Imaginary parts of the unwindowed sliding spectrum
+    std::vector<double> twiddle_re;     ///< Real parts of the damped per-sample rotation
+    std::vector<double> twiddle_im;     ///< Imaginary parts of the damped per-sample rotation
+    double damping_n;       ///< Damping after frame_size samples, applied to leaving samples
 };
 
+/**
+ * @brief Transformer used by the FeatureBank, in the precision of Sample
+ */
+using FrequencyTransformer = BasicFrequencyTransformer<Sample>;
+
+#ifdef ZERR_CORE_FFT_FLOAT
+/**
+ * @brief Single-precision transformer, available when the backend supports float
+ */
+using FrequencyTransformerF = BasicFrequencyTransformer<float>;
+#endif
+
 }  // namespace zerr
-#endif  // FREQUENCYTRANSFORMER_H
\ No newline at end of file
+#endif  // FREQUENCYTRANSFORMER_H
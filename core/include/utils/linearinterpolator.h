@@ -6,50 +6,115 @@
 
 namespace zerr {
 
+/**
+ * @brief Defines how values are generated between two analysis frames
+ */
+enum class InterpolationMode {
+    HOLD,   ///< Jump to the new value at the start of the block and hold it
+    LINEAR, ///< Straight ramp from the previous to the new value
+    CUBIC   ///< Catmull-Rom spline through the previous frames and the new value
+};
+
 /**
  * @class LinearInterpolator
  * @brief Performs linear interpolation between two values over a specified number of steps
- * 
+ *
  * This class implements linear interpolation to smoothly transition between a start and end value
  * over a specified number of steps. It is useful for creating gradual parameter changes and
  * smooth transitions in audio processing.
+ *
+ * The ramp parameters are precomputed in set_value(), so generating a block with fill() costs
+ * no division per sample. Besides the default linear ramp, a sample-and-hold mode and a cubic
+ * Catmull-Rom mode are available. The cubic mode uses the frame value before the start value as
+ * the leading control point and extrapolates the trailing one linearly, so it stays causal.
  */
 class LinearInterpolator {
   public:
+    /**
+     * @brief Select the interpolation curve between start and stop values
+     * @param mode One of InterpolationMode::HOLD, LINEAR or CUBIC
+     */
+    void set_mode(InterpolationMode mode) { interp_mode = mode; }
+
+    /**
+     * @brief Get the active interpolation curve
+     * @return InterpolationMode The current mode
+     */
+    InterpolationMode get_mode() const { return interp_mode; }
+
     /**
      * @brief Set the start and end values and number of interpolation steps
      * @param start Starting value for interpolation
-     * @param stop Ending value for interpolation  
+     * @param stop Ending value for interpolation
      * @param len Number of interpolation steps
-     * 
+     *
      * Initializes the interpolator with the given parameters. The interpolation will
-     * move from start to stop value over len number of steps.
+     * move from start to stop value over len number of steps. A len of 1 or less yields
+     * the stop value directly.
      */
     void set_value(Param start, Param stop, int len);
 
     /**
      * @brief Get the current interpolated value
      * @return Param The current interpolated value
-     * 
+     *
      * Returns the interpolated value at the current position between start and stop values.
      */
     Param get_value();
 
     /**
      * @brief Advance to the next interpolation step
-     * 
+     *
      * Increments the internal position counter and calculates the next interpolated value.
      * Should be called once per interpolation step.
      */
     void next_step();
 
+    /**
+     * @brief Write the interpolated values of the current segment into a buffer
+     * @param out Destination buffer with at least len elements
+     * @param len Number of values to write
+     *
+     * Writes the values of positions 0..len-1 in one pass and leaves the position at the
+     * end of the written range. Positions beyond the segment repeat the stop value.
+     */
+    void fill(Param* out, size_t len);
+
   private:
-    Param inter_val;   ///< Current interpolated value calculated based on position
-    Param start_val;   ///< Starting value of interpolation range
-    Param stop_val;    ///< Ending value of interpolation range
+    InterpolationMode interp_mode = InterpolationMode::LINEAR; ///< Active interpolation curve
+
+    Param inter_val  = 0.0; ///< Current interpolated value calculated based on position
+    Param start_val  = 0.0; ///< Starting value of interpolation range
+    Param stop_val   = 0.0; ///< Ending value of interpolation range
+    Param before_val = 0.0; ///< Start value of the previous segment, used by the cubic mode
+
+    Param step_val = 0.0; ///< Precomputed increment per step (linear) or of t (cubic)
+    Param coef[4]  = {};  ///< Precomputed cubic polynomial coefficients in t
+
+    int n_steps  = 0; ///< Total number of interpolation steps to reach stop value
+    int position = 0; ///< Current step position in the interpolation sequence
+
+    /**
+     * @brief Evaluate the interpolation curve at a given step position
+     * @param pos Step position inside the segment
+     * @return Param The interpolated value
+     */
+    inline Param _value_at(int pos) const
+    {
+        if (pos >= n_steps - 1)
+            return stop_val;
 
-    int n_steps;       ///< Total number of interpolation steps to reach stop value
-    int position;      ///< Current step position in the interpolation sequence
+        switch (interp_mode) {
+        case InterpolationMode::HOLD:
+            return stop_val;
+        case InterpolationMode::CUBIC: {
+            Param t = (Param)pos * step_val;
+            return ((coef[3] * t + coef[2]) * t + coef[1]) * t + coef[0];
+        }
+        default:
+            return start_val + (Param)pos * step_val;
+        }
+    }
 };
 
 }  // namespace zerr
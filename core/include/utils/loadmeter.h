@@ -0,0 +1,134 @@
+/**
+ * @file loadmeter.h
+ * @author Zeyu Yang (zeyuuyang42@gmail.com)
+ * @brief Per-instance timing of perform() calls, read from a non-real-time thread
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2023-2026
+ */
+#ifndef LOADMETER_H
+#define LOADMETER_H
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+#include "configs.h"
+#include "types.h"
+
+namespace zerr {
+
+/**
+ * @brief Summary of the perform() times in the window of a LoadMeter
+ */
+struct LoadStats {
+    uint64_t blocks = 0;   ///< Blocks measured since the last reset
+    size_t window   = 0;   ///< Blocks the window statistics are computed from
+    double mean_us  = 0.0; ///< Mean time per block in the window
+    double p50_us   = 0.0; ///< Median time per block in the window
+    double p95_us   = 0.0; ///< 95th percentile in the window
+    double p99_us   = 0.0; ///< 99th percentile in the window
+    double max_us   = 0.0; ///< Longest block since the last reset
+    double load     = 0.0; ///< Mean time as a fraction of the block period, 0 if unknown
+    double peak     = 0.0; ///< Longest block as a fraction of the block period, 0 if unknown
+};
+
+/**
+ * @class LoadMeter
+ * @brief Measures how long each perform() of a module takes
+ *
+ * A module opens a LoadMeter::Scope at the top of perform(). While the meter is disabled, the
+ * default, the scope only tests one flag. While it is enabled, the scope reads the monotonic
+ * clock on entry and exit and stores the duration in a window of the last LOAD_METER_WINDOW
+ * blocks. Each slot is a relaxed atomic, so get_stats() can copy the window from another
+ * thread at any time without locking the audio thread; a snapshot may mix two neighbouring
+ * blocks, which does not matter for the statistics.
+ *
+ *     LoadMeter::Scope measure(load_meter);
+ */
+class LoadMeter {
+  public:
+    using Clock = std::chrono::steady_clock;
+
+    LoadMeter() = default;
+
+    LoadMeter(const LoadMeter&)            = delete;
+    LoadMeter& operator=(const LoadMeter&) = delete;
+
+    /**
+     * @brief Start or stop measuring, may be called from any thread
+     * @param enabled Whether perform() is timed
+     */
+    void set_enabled(bool enabled) { this->enabled.store(enabled, std::memory_order_relaxed); }
+    /**
+     * @brief Whether perform() is timed
+     */
+    bool is_enabled() const { return enabled.load(std::memory_order_relaxed); }
+    /**
+     * @brief Set the block period the load is relative to
+     * @param system_configs Sample rate and block size of the module
+     */
+    void set_period(SystemConfigs system_configs);
+    /**
+     * @brief Record the duration of one block, audio thread only
+     * @param start Time at which the block started
+     */
+    void record(Clock::time_point start);
+    /**
+     * @brief Compute the statistics of the current window, not real-time safe
+     * @return LoadStats Statistics in microseconds
+     */
+    LoadStats get_stats() const;
+    /**
+     * @brief Summarise the statistics in one line, for a console or a log
+     * @return std::string e.g. "1500 blocks, mean 12.1 us, ... load 0.9% (peak 3.2%)"
+     */
+    std::string report() const;
+    /**
+     * @brief Forget all measurements, takes effect at the next record()
+     */
+    void reset() { reset_requested.store(true, std::memory_order_relaxed); }
+
+    /**
+     * @class Scope
+     * @brief Times the enclosing block if the meter is enabled
+     */
+    class Scope {
+      public:
+        explicit Scope(LoadMeter& meter)
+            : meter(meter.is_enabled() ? &meter : nullptr)
+        {
+            if (this->meter) {
+                start = Clock::now();
+            }
+        }
+        ~Scope()
+        {
+            if (meter) {
+                meter->record(start);
+            }
+        }
+
+        Scope(const Scope&)            = delete;
+        Scope& operator=(const Scope&) = delete;
+
+      private:
+        LoadMeter* meter;        ///< Meter to record into, null while disabled
+        Clock::time_point start; ///< Entry time of the scope
+    };
+
+  private:
+    std::atomic<bool> enabled{false};         ///< Whether perform() is timed
+    std::atomic<bool> reset_requested{false}; ///< Whether record() should start over
+
+    std::array<std::atomic<uint32_t>, LOAD_METER_WINDOW> durations{}; ///< Last blocks in ns
+    std::atomic<uint64_t> count{0};                                   ///< Blocks recorded
+    std::atomic<uint32_t> max_ns{0};                                  ///< Longest block
+
+    std::atomic<double> period_ns{0.0}; ///< Duration of one block in real time
+};
+
+} // namespace zerr
+#endif // LOADMETER_H
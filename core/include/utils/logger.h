@@ -12,33 +12,30 @@
 #ifndef LOGGER_H
 #define LOGGER_H
 
+#include <atomic>
 #include <ctime>
 #include <iostream>
+#include <memory>
 #include <sstream>
 #include <string>
 #include <functional>
 
 #include "configs.h"
+#include "logqueue.h"
 
 namespace zerr {
 
-/**
- * @brief Defines different severity levels for logging messages
- */
-enum class LogLevel {
-    DEBUG,
-    INFO,
-    WARNING,
-    ERROR
-};
-
-
 /**
  * @brief A logging utility class for recording application events and messages
  *
  * This class provides methods for logging messages at different severity levels
  * (INFO, WARNING, ERROR, DEBUG). Messages can be filtered based on the current
  * log level setting.
+ *
+ * Printing allocates and usually takes a lock of the host, so it must not happen on the audio
+ * thread. With setDeferred(true), messages logged inside a RealtimeScope are captured in a
+ * lock-free queue instead and printed by flush(), which the host calls from its scheduler.
+ * Messages that do not fit into the queue are counted and reported by the next flush().
  */
 class Logger {
  public:
@@ -93,11 +90,94 @@ class Logger {
         printer_ = std::move(newPrinter);
     }
 
+    /**
+     * @brief Log a printf style message without allocating on the audio thread
+     *
+     * Inside a RealtimeScope of a deferred logger the format and the arguments are queued and
+     * formatted by flush(), otherwise the message is printed at once.
+     *
+     * @param level The severity level of the message
+     * @param format Format string, must outlive the queue, i.e. be a string literal
+     * @param args Numbers or strings, at most LogRecord::MAX_ARGS
+     */
+    template <typename... Args> void logFormat(LogLevel level, const char* format, const Args&... args)
+    {
+        if (logLevel > level)
+            return;
+
+        LogRecord record;
+        record.level  = level;
+        record.format = format;
+        (record.add(args), ...);
+        if (realtimeThread && queue_) {
+            enqueue_(record);
+        }
+        else {
+            printer_(formatLog_(level, formatLogRecord(record)));
+        }
+    }
+
+    /**
+     * @brief Queue the messages of real-time threads instead of printing them
+     * @param deferred Whether to defer, allocates the queue of LOG_QUEUE_SIZE records
+     */
+    void setDeferred(bool deferred);
+
+    /**
+     * @brief Print the queued messages and the number of dropped messages, not real-time safe
+     */
+    void flush();
+
+    /**
+     * @brief Whether flush() has something to print, real-time safe
+     */
+    bool hasPending() const;
+
+    /**
+     * @brief Number of messages dropped because the queue was full
+     */
+    size_t getDroppedCount() const { return dropped.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Marks the current thread as real-time while in scope, e.g. in perform()
+     */
+    class RealtimeScope {
+     public:
+        RealtimeScope() : previous(realtimeThread) { realtimeThread = true; }
+        ~RealtimeScope() { realtimeThread = previous; }
+
+        RealtimeScope(const RealtimeScope&)            = delete;
+        RealtimeScope& operator=(const RealtimeScope&) = delete;
+
+     private:
+        bool previous;
+    };
+
  private:
     LogLevel logLevel; ///< The current minimum severity level for logging
 
     PrintStrategy printer_; ///< Interchangable
 
+    std::unique_ptr<LogQueue> queue_; ///< Deferred messages, null if printing directly
+
+    std::atomic<size_t> dropped{0}; ///< Messages lost because the queue was full
+
+    std::atomic<size_t> reportedDrops{0}; ///< Dropped messages already reported by flush()
+
+    static inline thread_local bool realtimeThread = false; ///< Inside a RealtimeScope
+
+    /**
+     * @brief Print a message, or queue it on a real-time thread
+     * @param level The severity level of the message
+     * @param message The message to log
+     */
+    void log_(LogLevel level, const std::string& message);
+
+    /**
+     * @brief Queue a record, counting it as dropped if the queue is full
+     */
+    void enqueue_(const LogRecord& record);
+
     /**
      * @brief Internal method to perform the actual logging
      * @param level The severity level of the message
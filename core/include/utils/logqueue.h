@@ -0,0 +1,186 @@
+/**
+ * @file logqueue.h
+ * @author Zeyu Yang (zeyuuyang42@gmail.com)
+ * @brief Lock-free queue of fixed-size log records, formatted later on a non-real-time thread
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2023-2026
+ */
+#ifndef LOGQUEUE_H
+#define LOGQUEUE_H
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <type_traits>
+
+namespace zerr {
+
+/**
+ * @brief Defines different severity levels for logging messages
+ */
+enum class LogLevel {
+    DEBUG,
+    INFO,
+    WARNING,
+    ERROR
+};
+
+/**
+ * @brief One argument of a deferred log message
+ */
+struct LogArg {
+    enum class Type : uint8_t { INT, UINT, FLOAT, TEXT };
+
+    Type type;
+    union {
+        long long i;
+        unsigned long long u;
+        double f;
+        size_t offset; ///< Start of the copied string in LogRecord::text
+    };
+};
+
+/**
+ * @brief A log message that is captured without allocating
+ *
+ * The record keeps the printf format string, which has to be a string literal, together with
+ * the argument values. String arguments are copied into the text buffer and truncated when it
+ * is full. A record without a format holds a finished message in the text buffer.
+ */
+struct LogRecord {
+    static constexpr size_t MAX_ARGS  = 6;   ///< Further arguments are ignored
+    static constexpr size_t TEXT_SIZE = 160; ///< Bytes for the message or string arguments
+
+    LogLevel level       = LogLevel::INFO;
+    const char* format   = nullptr; ///< Static format string, nullptr for a plain message
+    uint8_t n_args       = 0;       ///< Number of captured arguments
+    uint16_t text_used   = 0;       ///< Bytes used in text
+    LogArg args[MAX_ARGS];          ///< Captured arguments
+    char text[TEXT_SIZE];           ///< Plain message or copied string arguments
+
+    /**
+     * @brief Store a finished message, truncated to the text buffer
+     */
+    void set_text(const char* message)
+    {
+        format    = nullptr;
+        n_args    = 0;
+        text_used = 0;
+        _copy(message);
+    }
+
+    /**
+     * @brief Capture one printf argument
+     */
+    template <typename T> void add(const T& value)
+    {
+        if (n_args == MAX_ARGS) {
+            return;
+        }
+        LogArg& arg = args[n_args++];
+        if constexpr (std::is_floating_point_v<T>) {
+            arg.type = LogArg::Type::FLOAT;
+            arg.f    = (double)value;
+        }
+        else if constexpr (std::is_integral_v<T> && std::is_signed_v<T>) {
+            arg.type = LogArg::Type::INT;
+            arg.i    = (long long)value;
+        }
+        else if constexpr (std::is_integral_v<T> || std::is_enum_v<T>) {
+            arg.type = LogArg::Type::UINT;
+            arg.u    = (unsigned long long)value;
+        }
+        else if constexpr (std::is_same_v<T, std::string>) {
+            arg.type   = LogArg::Type::TEXT;
+            arg.offset = _copy(value.c_str());
+        }
+        else {
+            static_assert(std::is_convertible_v<T, const char*>, "unsupported log argument");
+            arg.type   = LogArg::Type::TEXT;
+            arg.offset = _copy(value);
+        }
+    }
+
+ private:
+    /**
+     * @brief Append a string to the text buffer
+     * @return size_t Offset of the copied string
+     */
+    size_t _copy(const char* s)
+    {
+        size_t offset = text_used < TEXT_SIZE ? text_used : TEXT_SIZE - 1;
+        size_t n      = s ? strnlen(s, TEXT_SIZE - 1 - offset) : 0;
+        std::memcpy(text + offset, s, n);
+        text[offset + n] = '\0';
+        text_used        = (uint16_t)(offset + n + 1 < TEXT_SIZE ? offset + n + 1 : TEXT_SIZE);
+        return offset;
+    }
+};
+
+/**
+ * @brief Format a captured record like printf would have
+ * @param record Captured log record
+ * @return std::string The formatted message, without the level prefix
+ */
+std::string formatLogRecord(const LogRecord& record);
+
+/**
+ * @class LogQueue
+ * @brief Bounded multi-producer, single-consumer queue of log records
+ *
+ * Any thread may push, the audio thread included: a push claims a slot with one
+ * compare-and-swap and copies the record, it never blocks or allocates. When the consumer
+ * falls behind the queue is full and push() fails, so the caller can count the record as
+ * dropped. Only one thread at a time may pop, usually a timer or idle callback of the host.
+ */
+class LogQueue {
+ public:
+    /**
+     * @brief Allocate the queue
+     * @param capacity Number of records, rounded up to a power of two
+     */
+    explicit LogQueue(size_t capacity);
+
+    LogQueue(const LogQueue&)            = delete;
+    LogQueue& operator=(const LogQueue&) = delete;
+
+    /**
+     * @brief Append a record, real-time safe
+     * @param record Record to copy into the queue
+     * @return bool False if the queue is full and the record was not stored
+     */
+    bool push(const LogRecord& record);
+    /**
+     * @brief Take the oldest record, consumer thread only
+     * @param record Receives the record
+     * @return bool False if the queue is empty
+     */
+    bool pop(LogRecord& record);
+    /**
+     * @brief Whether records are waiting, may be called from any thread
+     */
+    bool empty() const;
+
+ private:
+    static constexpr size_t CACHE_LINE_SIZE = 64;
+
+    /**
+     * @brief A slot with the sequence number that tells producers and consumer its state
+     */
+    struct Cell {
+        std::atomic<size_t> sequence;
+        LogRecord record;
+    };
+
+    std::unique_ptr<Cell[]> cells;
+    size_t mask;
+
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> write_pos{0}; ///< Next slot to claim
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> read_pos{0};  ///< Next slot to read
+};
+
+} // namespace zerr
+#endif // LOGQUEUE_H
@@ -48,12 +48,12 @@ class OnsetDetector {
     void setDebounceThreshold(int newThreshold);
     /**
      * @brief Function to detect onsets in blocks of the signal
-     * @param block Reference to the audio block to analyze for onsets
+     * @param block View of the audio block to analyze, debounced triggers are cleared in place
      *
      * Analyzes a block of audio samples to detect onset events by comparing
      * consecutive samples and identifying significant amplitude increases.
      */
-    void detectOnsetInBlock(Block& block);
+    void detectOnsetInBlock(ChannelView block);
 
   private:
     int lastSample;        ///< Previous sample value for amplitude comparison
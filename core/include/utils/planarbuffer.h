@@ -0,0 +1,138 @@
+/**
+ * @file planarbuffer.h
+ * @author Zeyu Yang (zeyuuyang42@gmail.com)
+ * @brief Multichannel audio buffer with all channels in one aligned allocation
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2023-2026
+ */
+#ifndef PLANARBUFFER_H
+#define PLANARBUFFER_H
+
+#include <cassert>
+
+#include "types.h"
+
+namespace zerr {
+
+/**
+ * @class PlanarBuffer
+ * @brief Planar multichannel buffer backed by a single 64-byte aligned arena
+ *
+ * Blocks keeps every channel in its own heap allocation, scattered in memory and without an
+ * alignment guarantee. A PlanarBuffer stores the channels one after another in one arena. The
+ * arena starts on a cache line and the distance between two channels, the stride, is padded
+ * to a multiple of 64 bytes. Every channel therefore starts on a cache line, which suits
+ * aligned SIMD loads, and a loop over all channels walks memory linearly.
+ *
+ * Channels are accessed through non-owning views: operator[] returns a writable ChannelView,
+ * or a SampleView on a const buffer. The views stay valid until the buffer is resized.
+ * Copying a buffer of the same shape reuses the arena, so assigning buffers in the audio
+ * callback does not allocate.
+ */
+class PlanarBuffer {
+  public:
+    static constexpr size_t ALIGNMENT = 64; ///< Alignment of every channel in bytes
+
+    /**
+     * @brief Construct a new Planar Buffer filled with zeros
+     * @param n_channels Number of channels
+     * @param size Number of samples per channel
+     */
+    explicit PlanarBuffer(size_t n_channels = 0, size_t size = 0);
+    /**
+     * @brief Construct a new Planar Buffer from blocks of equal size
+     * @param blocks One block per channel
+     */
+    explicit PlanarBuffer(const Blocks& blocks);
+
+    PlanarBuffer(const PlanarBuffer& other);
+    PlanarBuffer(PlanarBuffer&& other) noexcept;
+    PlanarBuffer& operator=(const PlanarBuffer& other);
+    PlanarBuffer& operator=(PlanarBuffer&& other) noexcept;
+    ~PlanarBuffer();
+
+    /**
+     * @brief Change the shape of the buffer, all samples are set to zero
+     * @param n_channels Number of channels
+     * @param size Number of samples per channel
+     */
+    void resize(size_t n_channels, size_t size);
+    /**
+     * @brief Set all samples of all channels
+     * @param value The new sample value
+     */
+    void fill(Sample value);
+    /**
+     * @brief Copy blocks into the buffer, resizing it if the shape differs
+     * @param blocks One block per channel, all of the same size
+     */
+    void assign(const Blocks& blocks);
+    /**
+     * @brief Copy the buffer into separate blocks
+     * @return Blocks One block per channel
+     */
+    Blocks to_blocks() const;
+
+    /**
+     * @brief Get the number of channels
+     * @return size_t Number of channels
+     */
+    size_t get_n_channels() const { return n_channels; }
+    /**
+     * @brief Get the number of samples per channel
+     * @return size_t Samples per channel
+     */
+    size_t get_size() const { return size; }
+    /**
+     * @brief Get the distance between the first samples of two neighbouring channels
+     * @return size_t Stride in samples, a multiple of ALIGNMENT bytes
+     */
+    size_t get_stride() const { return stride; }
+
+    /**
+     * @brief Get the first sample of a channel
+     * @param ch The channel
+     * @return Sample* Aligned pointer to the channel
+     */
+    Sample* channel(size_t ch)
+    {
+        assert(ch < n_channels);
+        return arena + ch * stride;
+    }
+    const Sample* channel(size_t ch) const
+    {
+        assert(ch < n_channels);
+        return arena + ch * stride;
+    }
+    /**
+     * @brief Get a writable view of a channel
+     * @param ch The channel
+     * @return ChannelView View of size get_size()
+     */
+    ChannelView operator[](size_t ch) { return ChannelView(channel(ch), size); }
+    /**
+     * @brief Get a read-only view of a channel
+     * @param ch The channel
+     * @return SampleView View of size get_size()
+     */
+    SampleView operator[](size_t ch) const { return SampleView(channel(ch), size); }
+
+  private:
+    /**
+     * @brief Allocate an arena for the current shape, all samples zero
+     */
+    void _allocate();
+    /**
+     * @brief Free the arena
+     */
+    void _release();
+
+    Sample* arena     = nullptr; ///< All channels, aligned to ALIGNMENT bytes
+    size_t n_channels = 0;       ///< Number of channels
+    size_t size       = 0;       ///< Samples per channel
+    size_t stride     = 0;       ///< Samples between two channels, size padded to ALIGNMENT
+};
+
+} // namespace zerr
+#endif // PLANARBUFFER_H
@@ -13,6 +13,7 @@
 #include <iostream>
 #include <vector>
 
+#include "planarbuffer.h"
 #include "types.h"
 
 namespace zerr {
@@ -24,14 +25,23 @@ namespace zerr {
  * This class provides a fixed-size circular buffer implementation optimized for
  * audio processing applications. It allows for efficient enqueueing of sample blocks
  * and retrieval of samples in a FIFO manner.
+ *
+ * The storage of each channel is rounded up to a power of two, so positions wrap with a bit
+ * mask, and every sample is written twice, one storage length apart. Because of this mirror,
+ * the latest samples are always contiguous in memory and view() can return them without
+ * copying. Blocks are written with at most two memcpy calls per copy.
+ *
+ * A ring buffer can hold several channels in one contiguous allocation. The channels are
+ * stored one after another and share the same read and write positions.
  */
 class RingBuffer {
   public:
     /**
      * @brief Construct a new Ring Buffer with specified capacity
-     * @param capacity The maximum number of samples the buffer can hold
+     * @param capacity The maximum number of samples the buffer can hold per channel
+     * @param n_channels The number of channels stored in the buffer
      */
-    explicit RingBuffer(size_t capacity);
+    explicit RingBuffer(size_t capacity, size_t n_channels = 1);
 
     /**
      * @brief Get the current number of samples in the buffer
@@ -41,28 +51,86 @@ class RingBuffer {
 
     /**
      * @brief Get the maximum capacity of the buffer
-     * @return size_t Maximum number of samples the buffer can hold
+     * @return size_t Maximum number of samples the buffer can hold per channel
      */
     size_t get_capacity() const;
 
+    /**
+     * @brief Get the number of channels of the buffer
+     * @return size_t Number of channels
+     */
+    size_t get_n_channels() const { return n_channels; }
+
     /**
      * @brief Add a block of samples to the buffer
-     * @param block Block of samples to enqueue
+     * @param block Block of samples to enqueue, throws if it is longer than the capacity
      */
     void enqueue(const Block& block);
 
     /**
-     * @brief Retrieve samples from the buffer
+     * @brief Add one block of samples per channel to the buffer
+     * @param blocks Blocks of equal size, one for each channel, at most the capacity long
+     */
+    void enqueue(const Blocks& blocks);
+
+    /**
+     * @brief Add one block of samples per channel to the buffer
+     * @param blocks Planar buffer with one channel for each channel of the ring buffer, at most
+     * the capacity long
+     */
+    void enqueue(const PlanarBuffer& blocks);
+
+    /**
+     * @brief Retrieve the most recent samples from the buffer, oldest first
      * @param ptr_buffer Pointer to destination buffer for samples
-     * @param buf_len Number of samples to retrieve
+     * @param buf_len Number of samples to retrieve, at most the buffer capacity
+     * @param channel The channel to read from
      */
-    void get_samples(Sample* ptr_buffer, size_t buf_len);
+    void get_samples(Sample* ptr_buffer, size_t buf_len, size_t channel = 0) const;
+
+    /**
+     * @brief Get the most recent samples in place, oldest first
+     *
+     * The view points into the buffer and stays valid until the next enqueue.
+     *
+     * @param len Number of samples, at most the buffer capacity
+     * @param channel The channel to read from
+     * @return SampleView Contiguous view of the latest len samples
+     */
+    SampleView view(size_t len, size_t channel = 0) const
+    {
+        assert(len <= capacity && "View length should not exceed ringbuffer size!");
+        assert(channel < n_channels && "Channel index out of range!");
+
+        return SampleView(buffer.data() + channel * 2 * storage + ((tail - len) & mask), len);
+    }
 
   private:
-    Samples buffer; ///< Storage for audio samples
-    size_t head;    ///< Index where next sample will be written
-    size_t tail;    ///< Index where next sample will be read
-    size_t size;    ///< Current number of samples in buffer
+    /**
+     * @brief Throw if a block is longer than the capacity
+     * @param len Number of samples of the block
+     */
+    void _check_block_size(size_t len) const;
+    /**
+     * @brief Write samples of one channel at the write position, into both copies
+     * @param channel The channel to write
+     * @param samples Pointer to the samples
+     * @param len Number of samples, at most the storage length
+     */
+    void _write(size_t channel, const Sample* samples, size_t len);
+    /**
+     * @brief Advance the write position after all channels have been written
+     * @param len Number of written samples
+     */
+    void _advance(size_t len);
+
+    Samples buffer;    ///< Mirrored storage of all channels, 2 * storage samples per channel
+    size_t capacity;   ///< Number of samples per channel
+    size_t n_channels; ///< Number of channels
+    size_t storage;    ///< Power of two storage length per channel, at least capacity
+    size_t mask;       ///< storage - 1, wraps positions
+    size_t tail;       ///< Index where next sample will be written
+    size_t size;       ///< Current number of samples in buffer
 };
 
 } // namespace zerr
@@ -0,0 +1,71 @@
+/**
+ * @file silencegate.h
+ * @author Zeyu Yang (zeyuuyang42@gmail.com)
+ * @brief Per-block silence detection with hysteresis, used to bypass idle processing
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2023-2026
+ */
+#ifndef SILENCEGATE_H
+#define SILENCEGATE_H
+
+#include "configs.h"
+#include "types.h"
+
+namespace zerr {
+
+/**
+ * @class SilenceGate
+ * @brief Decides block by block whether a signal is active
+ *
+ * The gate compares the peak of every block with a threshold. It opens as soon as a block
+ * reaches the threshold and closes only after the signal stayed below half the threshold for
+ * the hold time, so a signal hovering around the threshold does not toggle the gate. A module
+ * skips its work while the gate is closed and holds or clears its outputs instead.
+ *
+ * A threshold of 0 disables the gate, it then stays open.
+ */
+class SilenceGate {
+  public:
+    /**
+     * @brief Construct a new Silence Gate, it starts open
+     * @param threshold Peak level at which the gate opens, 0 keeps it always open
+     * @param hold Number of quiet samples before the gate closes
+     */
+    explicit SilenceGate(Sample threshold = SILENCE_THRESHOLD, size_t hold = 0);
+    /**
+     * @brief Set the peak level at which the gate opens
+     * @param threshold Opening level, the gate closes below half of it. 0 disables the gate
+     */
+    void set_threshold(Sample threshold);
+    /**
+     * @brief Set how long the signal has to be quiet before the gate closes
+     * @param hold Number of quiet samples
+     */
+    void set_hold(size_t hold) { this->hold = hold; }
+    /**
+     * @brief Update the gate with the next block
+     * @param block Input block
+     * @return bool Whether the gate is open for this block
+     */
+    bool process(SampleView block);
+    /**
+     * @brief Whether the gate was open for the last block
+     * @return bool True if the signal is active
+     */
+    bool is_open() const { return open; }
+    /**
+     * @brief Open the gate and restart the hold time
+     */
+    void reset();
+
+  private:
+    Sample open_threshold;  ///< Peak level that opens the gate
+    Sample close_threshold; ///< Peak level below which a block counts as quiet
+    size_t hold;            ///< Number of quiet samples before the gate closes
+    size_t quiet;           ///< Number of quiet samples since the last loud block
+    bool open;              ///< Whether the gate is open
+};
+
+} // namespace zerr
+#endif // SILENCEGATE_H
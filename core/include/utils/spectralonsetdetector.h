@@ -0,0 +1,137 @@
+/**
+ * @file spectralonsetdetector.h
+ * @author Zeyu Yang (zeyuuyang42@gmail.com)
+ * @brief Streaming onset detection on spectral frames with adaptive thresholding
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2023-2026
+ */
+#ifndef SPECTRALONSETDETECTOR_H
+#define SPECTRALONSETDETECTOR_H
+
+#include <vector>
+
+#include "types.h"
+
+namespace zerr {
+
+/**
+ * @brief Defines the onset detection function (ODF) computed on each spectral frame
+ */
+enum class OnsetFunction {
+    SPECTRAL_FLUX,         ///< Half-wave rectified magnitude difference between frames
+    COMPLEX_DOMAIN,        ///< Distance to the magnitude and phase predicted from past frames
+    HIGH_FREQUENCY_CONTENT ///< Frequency-weighted spectral energy
+};
+
+/**
+ * @class SpectralOnsetDetector
+ * @brief Detects onsets in a stream of complex spectral frames
+ *
+ * Every call of process() consumes one spectral frame, computes the selected onset
+ * detection function and compares it with an adaptive threshold:
+ *
+ *     threshold(n) = offset + scale * median(odf(n - M + 1) ... odf(n))
+ *
+ * A frame is reported as onset when it is a local maximum of the detection function above
+ * its threshold. The decision needs the following frame, so onsets are reported one hop
+ * late. The position inside the hop is refined by parabolic interpolation of the peak,
+ * giving a sample offset instead of a block-quantized trigger. A minimum interval between
+ * onsets suppresses double triggers of the same event.
+ */
+class SpectralOnsetDetector {
+  public:
+    /**
+     * @brief Construct a new Spectral Onset Detector object
+     * @param odf The onset detection function to use
+     */
+    explicit SpectralOnsetDetector(OnsetFunction odf = OnsetFunction::SPECTRAL_FLUX);
+    /**
+     * @brief Allocate the internal state for the given frame layout
+     * @param numBins Number of bins of the incoming spectral frames (frame size / 2 + 1)
+     * @param hopSize Number of samples between two consecutive frames
+     */
+    void initialize(size_t numBins, size_t hopSize);
+    /**
+     * @brief Clear the frame history, keeping the configuration
+     */
+    void reset();
+    /**
+     * @brief Select the onset detection function
+     * @param odf The onset detection function to use
+     */
+    void setOnsetFunction(OnsetFunction odf) { odfType = odf; }
+    /**
+     * @brief Set the adaptive threshold parameters
+     * @param scale Multiplier applied to the moving median of the detection function
+     * @param offset Constant added to the scaled median
+     */
+    void setThreshold(Param scale, Param offset);
+    /**
+     * @brief Set the number of frames in the moving median window
+     * @param numFrames Window length in frames, at least 1
+     */
+    void setMedianLength(size_t numFrames);
+    /**
+     * @brief Set the minimum distance between two reported onsets
+     * @param numSamples Minimum interval in samples
+     */
+    void setMinInterval(size_t numSamples) { minInterval = numSamples; }
+    /**
+     * @brief Consume one spectral frame and run the peak picking
+     * @param spectrum Complex spectrum of the newest frame with numBins bins
+     * @return int Sample offset of a detected onset inside the current hop, -1 if none
+     */
+    int process(const FFTBuffer& spectrum);
+    /**
+     * @brief Get the detection function value of the newest frame
+     * @return Param The onset detection function value
+     */
+    Param getOdfValue() const { return odfCurr; }
+    /**
+     * @brief Get the adaptive threshold of the newest frame
+     * @return Param The threshold value
+     */
+    Param getThresholdValue() const { return thresholdCurr; }
+
+  private:
+    OnsetFunction odfType; ///< Active onset detection function
+
+    size_t numBins;     ///< Number of bins per spectral frame
+    size_t hopSize;     ///< Number of samples between frames
+    size_t minInterval; ///< Minimum samples between two onsets
+
+    Param thresholdScale;  ///< Median multiplier of the adaptive threshold
+    Param thresholdOffset; ///< Constant offset of the adaptive threshold
+
+    Samples prvMagnitude;   ///< Magnitudes of the previous frame
+    Samples prvPhase;       ///< Phases of the previous frame
+    Samples prvPrvPhase;    ///< Phases of the frame before the previous one
+    Samples odfHistory;     ///< Circular history of detection function values
+    Samples medianScratch;  ///< Preallocated workspace for the median computation
+    size_t historyPos;      ///< Next write position in odfHistory
+    size_t historyFill;     ///< Number of valid values in odfHistory
+
+    Param odfPrvPrv;     ///< Detection function two frames ago
+    Param odfPrv;        ///< Detection function one frame ago
+    Param odfCurr;       ///< Detection function of the newest frame
+    Param thresholdPrv;  ///< Threshold one frame ago
+    Param thresholdCurr; ///< Threshold of the newest frame
+
+    size_t samplesSinceOnset; ///< Samples elapsed since the last onset, at the end of the hop
+
+    /**
+     * @brief Compute the selected detection function and update the frame history
+     * @param spectrum Complex spectrum of the newest frame
+     * @return Param The detection function value
+     */
+    Param _computeOdf(const FFTBuffer& spectrum);
+    /**
+     * @brief Compute the median of the valid detection function history
+     * @return Param The median value
+     */
+    Param _median();
+};
+
+} // namespace zerr
+#endif // SPECTRALONSETDETECTOR_H
@@ -0,0 +1,149 @@
+/**
+ * @file spscringbuffer.h
+ * @author Zeyu Yang (zeyuuyang42@gmail.com)
+ * @brief Lock-free single-producer/single-consumer ring buffer for passing audio between threads
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2023-2026
+ */
+#ifndef SPSCRINGBUFFER_H
+#define SPSCRINGBUFFER_H
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+#include "types.h"
+
+namespace zerr {
+
+/**
+ * @class SPSCRingBuffer
+ * @brief Passes audio samples from exactly one writer thread to exactly one reader thread
+ *
+ * Unlike RingBuffer, which keeps the latest frame for the analysis on one thread, this buffer
+ * is a FIFO between two threads, typically the audio callback writing blocks and an analysis
+ * thread reading them. Neither side locks or allocates after construction. The write and read
+ * indices only grow, are published with release stores and read with acquire loads, and sit
+ * on separate cache lines so the two threads do not invalidate each other's line. The storage
+ * is rounded up to a power of two so indices wrap with a mask, while the number of buffered
+ * samples is limited to the requested capacity.
+ *
+ * When the reader falls behind, write() stores as many samples as fit and drops the rest. The
+ * dropped samples and the number of overruns are counted and can be queried from any thread.
+ *
+ * Several channels can be stored in one buffer. All channels share the indices and are
+ * written and read together.
+ */
+class SPSCRingBuffer {
+  public:
+    static constexpr size_t CACHE_LINE_SIZE = 64; ///< Alignment that separates the indices
+
+    /**
+     * @brief Construct a new SPSC ring buffer
+     * @param capacity Maximum number of buffered samples per channel
+     * @param n_channels Number of channels
+     */
+    explicit SPSCRingBuffer(size_t capacity, size_t n_channels = 1);
+
+    SPSCRingBuffer(const SPSCRingBuffer&)            = delete;
+    SPSCRingBuffer& operator=(const SPSCRingBuffer&) = delete;
+
+    /**
+     * @brief Write samples of a single channel buffer, writer thread only
+     *
+     * Throws std::invalid_argument if the buffer has more than one channel.
+     * @param data Pointer to the samples
+     * @param len Number of samples
+     * @return size_t Number of samples written, less than len on overrun
+     */
+    size_t write(const Sample* data, size_t len);
+    /**
+     * @brief Write one block per channel, writer thread only
+     * @param blocks Blocks of equal size, one for each channel, throws otherwise
+     * @return size_t Number of samples written per channel, less than the block size on overrun
+     */
+    size_t write(const Blocks& blocks);
+    /**
+     * @brief Read samples of a single channel buffer, reader thread only
+     *
+     * Throws std::invalid_argument if the buffer has more than one channel.
+     * @param data Destination of the samples
+     * @param len Maximum number of samples
+     * @return size_t Number of samples read
+     */
+    size_t read(Sample* data, size_t len);
+    /**
+     * @brief Read samples of all channels, reader thread only
+     * @param blocks Destination blocks, one for each channel with at least len samples,
+     * throws otherwise
+     * @param len Maximum number of samples per channel
+     * @return size_t Number of samples read per channel
+     */
+    size_t read(Blocks& blocks, size_t len);
+
+    /**
+     * @brief Number of samples per channel that can be read
+     * @return size_t Readable samples
+     */
+    size_t get_read_available() const;
+    /**
+     * @brief Number of samples per channel that can be written without overrun
+     * @return size_t Free space in samples
+     */
+    size_t get_write_available() const;
+    /**
+     * @brief Get the capacity per channel
+     * @return size_t Maximum number of buffered samples
+     */
+    size_t get_capacity() const { return capacity; }
+    /**
+     * @brief Get the number of channels
+     * @return size_t Number of channels
+     */
+    size_t get_n_channels() const { return n_channels; }
+    /**
+     * @brief Get how often a write did not fit into the buffer
+     * @return uint64_t Number of overruns since construction
+     */
+    uint64_t get_overruns() const { return overruns.load(std::memory_order_relaxed); }
+    /**
+     * @brief Get how many samples per channel were dropped by overruns
+     * @return uint64_t Number of dropped samples since construction
+     */
+    uint64_t get_dropped_samples() const { return dropped.load(std::memory_order_relaxed); }
+
+  private:
+    /**
+     * @brief Reserve space for a write and count what does not fit
+     * @param len Number of samples to write
+     * @return size_t Number of samples that fit
+     */
+    size_t _reserve(size_t len);
+    /**
+     * @brief Copy samples into one channel at the given index
+     */
+    void _copy_in(size_t channel, size_t index, const Sample* data, size_t len);
+    /**
+     * @brief Copy samples out of one channel at the given index
+     */
+    void _copy_out(size_t channel, size_t index, Sample* data, size_t len) const;
+
+    const size_t capacity;   ///< Maximum number of buffered samples per channel
+    const size_t storage;    ///< Allocated samples per channel, a power of two >= capacity
+    const size_t mask;       ///< storage - 1, wraps indices
+    const size_t n_channels; ///< Number of channels
+    Samples buffer;          ///< Storage of all channels, one after another
+
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> write_index; ///< Next sample to write
+    size_t cached_read_index; ///< Writer's last seen read index, avoids touching the reader line
+
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> read_index; ///< Next sample to read
+    size_t cached_write_index; ///< Reader's last seen write index
+
+    alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> overruns; ///< Writes that did not fit
+    std::atomic<uint64_t> dropped;                           ///< Samples lost by overruns
+};
+
+} // namespace zerr
+#endif // SPSCRINGBUFFER_H
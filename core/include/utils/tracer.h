@@ -0,0 +1,169 @@
+/**
+ * @file tracer.h
+ * @author Zeyu Yang (zeyuuyang42@gmail.com)
+ * @brief Timeline of the processing stages of every block, exported as Chrome trace JSON
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2023-2026
+ */
+#ifndef TRACER_H
+#define TRACER_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "configs.h"
+
+namespace zerr {
+
+/**
+ * @class Tracer
+ * @brief Records when each processing stage of a block began and ended
+ *
+ * The modules mark their stages with ZERR_TRACE_SCOPE, e.g. FeatureBank::perform(), the FFT
+ * of every resolution and every feature extractor. The marks compile to nothing unless the
+ * core is built with ZERR_CORE_TRACING, which defines ZERR_TRACING. Even then nothing is
+ * recorded until start() is called.
+ *
+ * The events go into one preallocated ring of TRACE_BUFFER_SIZE events shared by all threads,
+ * so the ring always holds the latest events. A thread claims a slot with one atomic increment
+ * and writes it like a seqlock, so recording neither blocks nor allocates. write_json() copies
+ * the ring from another thread and skips the slots that are being overwritten meanwhile. The
+ * file opens in Perfetto (ui.perfetto.dev) or chrome://tracing.
+ *
+ * To catch a slow callback, the host calls mark_xrun() on the audio thread when a block missed
+ * its deadline, and dump_xrun() from a non-real-time thread, which writes the trace once per
+ * xrun. The xrun shows up as an instant event at the end of the slow block.
+ */
+class Tracer {
+  public:
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * @brief The tracer of the process
+     */
+    static Tracer& instance();
+
+    Tracer(const Tracer&)            = delete;
+    Tracer& operator=(const Tracer&) = delete;
+
+    /**
+     * @brief Allocate the ring on first use and start recording, not real-time safe
+     */
+    void start();
+    /**
+     * @brief Stop recording, the recorded events stay in the ring
+     */
+    void stop() { enabled.store(false, std::memory_order_relaxed); }
+    /**
+     * @brief Whether events are recorded
+     */
+    bool is_enabled() const { return enabled.load(std::memory_order_relaxed); }
+    /**
+     * @brief Record a complete event, real-time safe
+     * @param category Static string grouping the events, e.g. "module"
+     * @param name Name of the stage, copied and truncated to TRACE_NAME_SIZE - 1 characters
+     * @param begin Time the stage began
+     * @param end Time the stage ended
+     */
+    void record(const char* category, const char* name, Clock::time_point begin,
+                Clock::time_point end);
+    /**
+     * @brief Mark the current time as an xrun and request a dump, real-time safe
+     */
+    void mark_xrun();
+    /**
+     * @brief Write the trace if an xrun was marked since the last dump, not real-time safe
+     * @param path Output file
+     * @return bool Whether a trace was written
+     */
+    bool dump_xrun(const std::string& path);
+    /**
+     * @brief Format the events in the ring as Chrome trace JSON, not real-time safe
+     * @return std::string The trace, oldest event first
+     */
+    std::string to_json() const;
+    /**
+     * @brief Write the events in the ring to a Chrome trace JSON file, not real-time safe
+     * @param path Output file
+     * @return bool Whether the file was written
+     */
+    bool write_json(const std::string& path) const;
+
+    /**
+     * @class Scope
+     * @brief Records the enclosing block as one event if the tracer is enabled
+     */
+    class Scope {
+      public:
+        Scope(const char* category, const char* name)
+            : tracer(Tracer::instance().is_enabled() ? &Tracer::instance() : nullptr)
+            , category(category)
+            , name(name)
+        {
+            if (tracer) {
+                begin = Clock::now();
+            }
+        }
+        ~Scope()
+        {
+            if (tracer) {
+                tracer->record(category, name, begin, Clock::now());
+            }
+        }
+
+        Scope(const Scope&)            = delete;
+        Scope& operator=(const Scope&) = delete;
+
+      private:
+        Tracer* tracer;          ///< Tracer to record into, null while disabled
+        const char* category;    ///< Category of the event
+        const char* name;        ///< Name of the event, must outlive the scope
+        Clock::time_point begin; ///< Entry time of the scope
+    };
+
+  private:
+    /**
+     * @brief One slot of the ring
+     */
+    struct Event {
+        std::atomic<uint64_t> sequence{0}; ///< Odd while written, 2 * (index + 1) when complete
+        const char* category;              ///< Static category string
+        char name[TRACE_NAME_SIZE];        ///< Copied stage name
+        int64_t begin_ns;                  ///< Begin relative to the epoch
+        int64_t end_ns;                    ///< End relative to the epoch, equal to begin if instant
+        uint32_t thread;                   ///< Small id of the recording thread
+    };
+
+    Tracer() = default;
+
+    /**
+     * @brief Write one event into the next slot of the ring
+     */
+    void _write(const char* category, const char* name, int64_t begin_ns, int64_t end_ns);
+
+    std::unique_ptr<Event[]> events;     ///< Ring of TRACE_BUFFER_SIZE events, never reallocated
+    std::atomic<uint64_t> head{0};       ///< Number of events claimed so far
+    std::atomic<bool> enabled{false};    ///< Whether events are recorded
+    std::atomic<bool> xrun{false};       ///< Whether an xrun was marked since the last dump
+    Clock::time_point epoch;             ///< Time of the first start(), zero of the timeline
+};
+
+} // namespace zerr
+
+#ifdef ZERR_TRACING
+#define ZERR_TRACE_CONCAT_(a, b) a##b
+#define ZERR_TRACE_CONCAT(a, b) ZERR_TRACE_CONCAT_(a, b)
+/**
+ * @brief Trace the rest of the enclosing block as one event of the given category and name
+ */
+#define ZERR_TRACE_SCOPE(category, name) \
+    zerr::Tracer::Scope ZERR_TRACE_CONCAT(zerr_trace_, __LINE__)(category, name)
+#else
+#define ZERR_TRACE_SCOPE(category, name) ((void)0)
+#endif // ZERR_TRACING
+
+#endif // TRACER_H
@@ -0,0 +1,74 @@
+/**
+ * @file triplebuffer.h
+ * @author Zeyu Yang (zeyuuyang42@gmail.com)
+ * @brief Lock-free triple buffer handing the latest value from one thread to another
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2023-2026
+ */
+#ifndef TRIPLEBUFFER_H
+#define TRIPLEBUFFER_H
+
+#include <atomic>
+
+namespace zerr {
+
+/**
+ * @class TripleBuffer
+ * @brief Passes the most recent value from one writer thread to one reader thread
+ *
+ * The writer fills its back slot and publishes it by swapping it with the middle slot. The
+ * reader swaps its front slot with the middle slot when a new value has been published since
+ * its last read. Both sides only exchange one atomic index, never wait on each other and
+ * never copy the value. Values published while the reader is not looking are overwritten,
+ * so the reader always gets the latest complete value.
+ *
+ * @tparam T Type of the value, slots are allocated once and reused
+ */
+template <typename T> class TripleBuffer {
+  public:
+    /**
+     * @brief Construct a new Triple Buffer with all slots set to the same value
+     * @param initial Value returned by read() until the first publish()
+     */
+    explicit TripleBuffer(const T& initial = T()) : slots{initial, initial, initial} {}
+
+    TripleBuffer(const TripleBuffer&)            = delete;
+    TripleBuffer& operator=(const TripleBuffer&) = delete;
+
+    /**
+     * @brief Get the slot the writer fills next, writer thread only
+     * @return T& The back slot
+     */
+    T& back() { return slots[back_slot]; }
+    /**
+     * @brief Publish the back slot to the reader, writer thread only
+     */
+    void publish()
+    {
+        back_slot = middle.exchange(back_slot | FRESH, std::memory_order_acq_rel) & INDEX;
+    }
+    /**
+     * @brief Get the latest published value, reader thread only
+     * @return const T& The front slot, valid until the next call of read()
+     */
+    const T& read()
+    {
+        if (middle.load(std::memory_order_relaxed) & FRESH) {
+            front_slot = middle.exchange(front_slot, std::memory_order_acq_rel) & INDEX;
+        }
+        return slots[front_slot];
+    }
+
+  private:
+    static constexpr int INDEX = 3; ///< Bits of the slot index
+    static constexpr int FRESH = 4; ///< Set while the middle slot has not been read
+
+    T slots[3];                     ///< Front, middle and back values
+    int front_slot = 0;             ///< Slot owned by the reader
+    int back_slot  = 2;             ///< Slot owned by the writer
+    std::atomic<int> middle{1};     ///< Slot in between, with the FRESH flag
+};
+
+} // namespace zerr
+#endif // TRIPLEBUFFER_H
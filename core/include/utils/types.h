@@ -17,7 +17,12 @@
 
 namespace zerr {
 // basic types
+#ifdef ZERR_SAMPLE_FLOAT
+using Sample = float; /**< Base type for audio sample values, float in zerr_core_float */
+#else
 using Sample = double; /**< Base type for audio sample values */
+#endif
+using Accum  = double; /**< Type of sums over many samples, double for either Sample type */
 using Param  = float;  /**< Base type for parameter values used in audio processing */
 using Index  = int;    /**< Base type for indexing and counting */
 
@@ -38,10 +43,54 @@ using AudioBuffers =
 using FFTBuffer  = std::vector<Complex>; /**< Buffer for storing FFT results as complex numbers */
 using SpecBuffer = std::vector<Sample>;  /**< Buffer for storing spectral power values */
 
+/**
+ * @brief Read-only view of contiguous samples owned by someone else
+ */
+class SampleView {
+  public:
+    SampleView() : ptr(nullptr), len(0) {}
+    SampleView(const Sample* data, size_t size) : ptr(data), len(size) {}
+    SampleView(const Samples& samples) : ptr(samples.data()), len(samples.size()) {}
+
+    const Sample* data() const { return ptr; }
+    size_t size() const { return len; }
+    const Sample* begin() const { return ptr; }
+    const Sample* end() const { return ptr + len; }
+    const Sample& operator[](size_t i) const { return ptr[i]; }
+
+  private:
+    const Sample* ptr; /**< First sample of the view */
+    size_t len;        /**< Number of samples in the view */
+};
+
+/**
+ * @brief Writable view of contiguous samples owned by someone else, e.g. one channel of a
+ * PlanarBuffer
+ */
+class ChannelView {
+  public:
+    ChannelView() : ptr(nullptr), len(0) {}
+    ChannelView(Sample* data, size_t size) : ptr(data), len(size) {}
+    ChannelView(Samples& samples) : ptr(samples.data()), len(samples.size()) {}
+
+    Sample* data() const { return ptr; }
+    size_t size() const { return len; }
+    bool empty() const { return len == 0; }
+    Sample* begin() const { return ptr; }
+    Sample* end() const { return ptr + len; }
+    Sample& operator[](size_t i) const { return ptr[i]; }
+    operator SampleView() const { return SampleView(ptr, len); }
+
+  private:
+    Sample* ptr; /**< First sample of the view */
+    size_t len;  /**< Number of samples in the view */
+};
+
 struct AudioInputs {
-    Block block;      /**< Single block of audio samples for processing */
-    AudioBuffer wave; /**< Buffered audio frame for temporal analysis */
+    Block block;     /**< Single block of audio samples for processing */
+    SampleView wave; /**< Buffered audio frame for temporal analysis, read in place */
     SpecBuffer spec;  /**< Spectral power data for frequency analysis */
+    FFTBuffer fft;    /**< Complex spectrum, only filled when a feature requests it */
 }; /**< Consolidated structure for different types of audio input data */
 
 using FeatureName  = std::string;              /**< String identifier for audio features */
@@ -96,6 +145,7 @@ using Pair = std::pair<Index, Index>; /**< Pair of indices for representing conn
 typedef struct {
     size_t sample_rate; /**< Audio sampling rate in Hz */
     size_t block_size;  /**< Size of processing blocks in samples */
+    size_t frame_size = AUDIO_BUFFER_SIZE; /**< Size of the analysis frame in samples */
 } SystemConfigs;
 
 } // namespace zerr
@@ -70,6 +70,19 @@ inline float get_hann_sample(int pos, int L)
     float val = 0.5 * (1.0 - cos((2.0 * PI * (float)pos) / (float)L));
     return val;
 }
+/**
+ * @brief Round up to the next power of two
+ * @param n The minimum value
+ * @return size_t The smallest power of two not less than n, 1 for n = 0
+ */
+inline size_t next_power_of_two(size_t n)
+{
+    size_t p = 1;
+    while (p < n) {
+        p <<= 1;
+    }
+    return p;
+}
 /**
  * @brief Check if an element exists in a vector
  * @param element The element to search for
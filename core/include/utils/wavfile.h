@@ -0,0 +1,110 @@
+/**
+ * @file wavfile.h
+ * @author Zeyu Yang (zeyuuyang42@gmail.com)
+ * @brief Minimal WAV reader over a memory-mapped file and a float WAV writer
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2023-2026
+ */
+#ifndef WAVFILE_H
+#define WAVFILE_H
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace zerr {
+
+/**
+ * @class WavReader
+ * @brief Reads the samples of a WAV file as float, one block at a time
+ *
+ * The file is mapped into memory, so reading a block only converts the samples in place of
+ * the mapping. Integer PCM with 16, 24 or 32 bits and float with 32 or 64 bits are read, also
+ * inside WAVE_FORMAT_EXTENSIBLE. The host is assumed to be little-endian like the format.
+ */
+class WavReader {
+  public:
+    /**
+     * @brief Map a file and parse its header, throws if it is not a supported WAV file
+     * @param path WAV file
+     */
+    explicit WavReader(const std::string& path);
+    ~WavReader();
+
+    WavReader(const WavReader&)            = delete;
+    WavReader& operator=(const WavReader&) = delete;
+
+    int get_n_channels() const { return n_channels; }
+    size_t get_sample_rate() const { return sample_rate; }
+    size_t get_n_frames() const { return n_frames; }
+
+    /**
+     * @brief Read the next frames, zeros past the end of the file
+     * @param channels One buffer of n samples per channel of the file
+     * @param n Number of frames
+     * @return size_t Number of frames read from the file
+     */
+    size_t read(float* const* channels, size_t n);
+
+  private:
+    const uint8_t* data = nullptr; /**< Start of the mapping or of the copy */
+    size_t size         = 0;       /**< Bytes of the file */
+    std::vector<uint8_t> copy;     /**< The file where it cannot be mapped */
+
+    const uint8_t* samples = nullptr; /**< First sample of the data chunk */
+    int n_channels         = 0;
+    size_t sample_rate     = 0;
+    size_t n_frames        = 0;
+    int bytes_per_sample   = 0;
+    bool is_float          = false;
+    size_t position        = 0; /**< Next frame to read */
+
+    void _parse(const std::string& path);
+    float _sample(const uint8_t* p) const;
+};
+
+/**
+ * @class WavWriter
+ * @brief Writes 32-bit float WAV files, the sizes in the header are filled in by close()
+ */
+class WavWriter {
+  public:
+    /**
+     * @brief Create the file, throws if it cannot be opened
+     * @param path WAV file
+     * @param n_channels Number of channels
+     * @param sample_rate Sample rate
+     */
+    WavWriter(const std::string& path, int n_channels, size_t sample_rate);
+    ~WavWriter();
+
+    WavWriter(const WavWriter&)            = delete;
+    WavWriter& operator=(const WavWriter&) = delete;
+
+    /**
+     * @brief Interleave and append frames
+     * @param channels One buffer of n samples per channel
+     * @param n Number of frames
+     */
+    void write(const float* const* channels, size_t n);
+    /**
+     * @brief Complete the header and close the file
+     * @return bool Whether all samples were written
+     */
+    bool close();
+
+  private:
+    std::FILE* file = nullptr;
+    int n_channels;
+    size_t sample_rate;
+    uint64_t n_frames = 0;
+    bool failed       = false;
+    std::vector<float> interleaved;
+
+    void _write_header();
+};
+
+} // namespace zerr
+#endif // WAVFILE_H
@@ -24,38 +24,24 @@ void Centroid::initialize(SystemConfigs sys_cfg)
 
 void Centroid::extract()
 {
-    double centroid       = 0.0;
-    double totalMagnitude = 0.0;
-
-    int fft_size = x.size();
-    for (int i = 0; i < fft_size; ++i) {
-        centroid += (i * freq_max / fft_size) * x[i];
-        totalMagnitude += x[i];
-    }
-
-    if (totalMagnitude > 0.0) {
-        centroid /= totalMagnitude;
+    begin(x.data(), x.size());
+    for (size_t i = 0; i < x.size(); ++i) {
+        accumulate(x[i], i);
     }
-
-    crr_y = centroid;
+    finish(x.data(), x.size());
 }
 
 void Centroid::reset() { _reset_param(); }
 
-void Centroid::fetch(AudioInputs in)
+void Centroid::fetch(const AudioInputs& in)
 {
-    x     = in.spec;
-    prv_y = crr_y;
+    x = in.spec;
 }
 
-FeatureVals Centroid::send()
+const FeatureVals& Centroid::send()
 {
     linear_interpolator.set_value(prv_y, crr_y, system_configs.block_size);
-
-    for (size_t i = 0; i < system_configs.block_size; ++i) {
-        y[i] = linear_interpolator.get_value();
-        linear_interpolator.next_step();
-    }
+    linear_interpolator.fill(y.data(), y.size());
 
     return y;
 }
@@ -26,43 +26,25 @@ void CrestFactor::initialize(SystemConfigs sys_cfg)
 
 void CrestFactor::extract()
 {
-    double square_sum = 0.0;
-    double square_root = 0.0;
-    double peak_max = 0.0;
-    double peak_tmp = 0.0;
-    int x_size = x.size();
-
-    for (int i = 0; i < x_size; ++i)
+    begin(frame.data(), frame.size());
+    for (size_t i = 0; i < frame.size(); ++i)
     {
-        square_sum += x[i] * x[i];
-
-        peak_tmp = abs(x[i]);
-        peak_max = peak_tmp > peak_max ? peak_tmp : peak_max;
+        accumulate(frame[i], i);
     }
-
-    square_sum = square_sum / x_size;
-    square_root = std::sqrt(square_sum);
-
-    crr_y = peak_max / square_root;
+    finish(frame.data(), frame.size());
 }
 
 void CrestFactor::reset() { _reset_param(); }
 
-void CrestFactor::fetch(AudioInputs in)
+void CrestFactor::fetch(const AudioInputs& in)
 {
-    x = in.wave;
-    prv_y = crr_y;
+    frame = in.wave;
 }
 
-FeatureVals CrestFactor::send()
+const FeatureVals& CrestFactor::send()
 {
     linear_interpolator.set_value(prv_y, crr_y, system_configs.block_size);
-
-    for (size_t i = 0; i < system_configs.block_size; ++i)
-    {
-        y[i] = linear_interpolator.get_value();
-        linear_interpolator.next_step();
-    }
+    linear_interpolator.fill(y.data(), y.size());
 
     return y;
 }
@@ -70,6 +52,7 @@ FeatureVals CrestFactor::send()
 void CrestFactor::_reset_param()
 {
     x.resize(AUDIO_BUFFER_SIZE, 0.0f);
+    frame = SampleView(x);
 
     prv_y = 0.0;
     crr_y = 0.0;
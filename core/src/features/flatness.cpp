@@ -1,5 +1,4 @@
 // #include "utils.h"
-#include <numeric>
 
 #include "flatness.h"
 
@@ -26,44 +25,23 @@ void Flatness::initialize(SystemConfigs sys_cfg) {
 }
 
 void Flatness::extract() {
-    // Calculate the sum of logarithms
-    double logSum = 0.0;
-    const double smallConstant =
-        1e-10;  // Small constant to avoid taking log of 0
-    for (double sample : x) {
-        logSum += std::log(sample + smallConstant);
+    // sum of logarithms and of values in one pass, for the geometric and arithmetic mean
+    begin(x.data(), x.size());
+    for (size_t i = 0; i < x.size(); ++i) {
+        accumulate(x[i], i);
     }
-
-    // Calculate the geometric mean using exponentiation
-    double geometricMean = std::exp(logSum / x.size());
-
-    // Calculate the arithmetic mean
-    double sum = std::accumulate(x.begin(), x.end(), 0.0);
-    double arithmeticMean = sum / x.size();
-
-    // Calculate the spectral flatness
-    double flatness = 0.0;
-    if (arithmeticMean != 0.0) {
-        flatness = geometricMean / arithmeticMean;
-    }
-
-    crr_y = flatness;
+    finish(x.data(), x.size());
 }
 
 void Flatness::reset() { _reset_param(); }
 
-void Flatness::fetch(AudioInputs in) {
+void Flatness::fetch(const AudioInputs& in) {
     x = in.spec;
-    prv_y = crr_y;
 }
 
-FeatureVals Flatness::send() {
+const FeatureVals& Flatness::send() {
     linear_interpolator.set_value(prv_y, crr_y, system_configs.block_size);
-
-    for (size_t i = 0; i < system_configs.block_size; ++i) {
-        y[i] = linear_interpolator.get_value();
-        linear_interpolator.next_step();
-    }
+    linear_interpolator.fill(y.data(), y.size());
 
     return y;
 }
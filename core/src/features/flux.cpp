@@ -21,34 +21,22 @@ void Flux::initialize(SystemConfigs sys_cfg) {
 }
 
 void Flux::extract() {
-    Param flux = 0.0;
-    Param diff = 0.0;
-
+    begin(x.data(), x.size());
     for (size_t i = 0; i < x.size(); ++i) {
-        diff = x[i] - prv_x[i];
-        flux += diff * diff;
+        accumulate(x[i], i);
     }
-
-    crr_y = std::sqrt(flux);
+    finish(x.data(), x.size());
 }
 
 void Flux::reset() { _reset_param(); }
 
-void Flux::fetch(AudioInputs in) {
-    prv_x = x;
+void Flux::fetch(const AudioInputs& in) {
     x = in.spec;
-
-    prv_y = crr_y;
 }
 
-FeatureVals Flux::send() {
+const FeatureVals& Flux::send() {
     linear_interpolator.set_value(prv_y, crr_y, system_configs.block_size);
-
-    for (size_t i = 0; i < system_configs.block_size; ++i) {
-        y[i] = linear_interpolator.get_value();
-
-        linear_interpolator.next_step();
-    }
+    linear_interpolator.fill(y.data(), y.size());
 
     return y;
 }
@@ -0,0 +1,53 @@
+#include "onset.h"
+#include "utils.h"
+
+using namespace zerr;
+using namespace feature;
+
+const std::string Onset::name     = "Onset";
+const std::string Onset::category = "Sample-Level";
+const std::string Onset::description =
+    "Onset detection locates the beginning of musical events by picking peaks of a "
+    "spectral onset detection function above an adaptive median threshold.";
+
+void Onset::initialize(SystemConfigs sys_cfg)
+{
+    system_configs = sys_cfg;
+
+    detector.initialize(system_configs.frame_size / 2 + 1, system_configs.block_size);
+    // the moving median spans about 100ms independent of the block size
+    detector.setMedianLength(system_configs.sample_rate / 10 / system_configs.block_size + 1);
+    // at least 50ms between two onsets
+    detector.setMinInterval(system_configs.sample_rate / 20);
+
+    _reset_param();
+    if (is_initialized() == false) {
+        set_initialize_statue(true);
+    }
+}
+
+void Onset::extract()
+{
+    int offset = detector.process(spectrum);
+
+    if (offset >= 0 && (size_t)offset < y.size()) {
+        y[offset] = 1.0;
+    }
+}
+
+void Onset::reset() { _reset_param(); }
+
+void Onset::fetch(const AudioInputs& in)
+{
+    spectrum = in.fft;
+    std::fill(y.begin(), y.end(), 0.0f);
+}
+
+const FeatureVals& Onset::send() { return y; }
+
+void Onset::_reset_param()
+{
+    spectrum.assign(system_configs.frame_size / 2 + 1, Complex{0.0, 0.0});
+    y.assign(system_configs.block_size, 0.0f);
+    detector.reset();
+}
@@ -1,5 +1,4 @@
 // #include "utils.h"
-#include <numeric>
 
 #include "rolloff.h"
 
@@ -26,18 +25,24 @@ void Rolloff::initialize(SystemConfigs sys_cfg) {
 
 void Rolloff::extract() {
     // Calculate the total energy in the spectrum
-    double totalEnergy = std::accumulate(x.begin(), x.end(), 0.0);
+    begin(x.data(), x.size());
+    for (size_t i = 0; i < x.size(); ++i) {
+        accumulate(x[i], i);
+    }
+    finish(x.data(), x.size());
+}
 
+void Rolloff::finish(const Sample* data, size_t n) {
     // Calculate the energy threshold for the rolloff
-    double rolloffThreshold = totalEnergy * rolloffPercent;
+    double rolloffThreshold = total_energy * rolloffPercent;
 
     // Find the rolloff frequency
     double sumEnergy = 0.0;
-    for (size_t i = 0; i < x.size(); ++i) {
-        sumEnergy += x[i];
+    for (size_t i = 0; i < n; ++i) {
+        sumEnergy += data[i];
         if (sumEnergy >= rolloffThreshold) {
             // Calculate the frequency corresponding to the bin index
-            crr_y = (double)i * freq_max / (double)x.size();
+            crr_y = (double)i * freq_max / (double)n;
             return;
         }
     }
@@ -47,18 +52,13 @@ void Rolloff::extract() {
 
 void Rolloff::reset() { _reset_param(); }
 
-void Rolloff::fetch(AudioInputs in) {
+void Rolloff::fetch(const AudioInputs& in) {
     x = in.spec;
-    prv_y = crr_y;
 }
 
-FeatureVals Rolloff::send() {
+const FeatureVals& Rolloff::send() {
     linear_interpolator.set_value(prv_y, crr_y, system_configs.block_size);
-
-    for (size_t i = 0; i < system_configs.block_size; ++i) {
-        y[i] = linear_interpolator.get_value();
-        linear_interpolator.next_step();
-    }
+    linear_interpolator.fill(y.data(), y.size());
 
     return y;
 }
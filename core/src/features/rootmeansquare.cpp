@@ -21,39 +21,29 @@ void RootMeanSquare::initialize(SystemConfigs sys_cfg) {
 }
 
 void RootMeanSquare::extract() {
-    double square_sum = 0;
-    double square_root = 0;
-    int x_size = x.size();
-
-    for (int i = 0; i < x_size; ++i) {
-        square_sum += x[i] * x[i];
+    begin(frame.data(), frame.size());
+    for (size_t i = 0; i < frame.size(); ++i) {
+        accumulate(frame[i], i);
     }
-    square_sum = square_sum / x_size;
-    square_root = std::sqrt(square_sum);
-
-    crr_y = square_root;
+    finish(frame.data(), frame.size());
 }
 
 void RootMeanSquare::reset() { _reset_param(); }
 
-void RootMeanSquare::fetch(AudioInputs in) {
-    x = in.wave;
-    prv_y = crr_y;
+void RootMeanSquare::fetch(const AudioInputs& in) {
+    frame = in.wave;
 }
 
-FeatureVals RootMeanSquare::send() {
+const FeatureVals& RootMeanSquare::send() {
     linear_interpolator.set_value(prv_y, crr_y, system_configs.block_size);
-
-    for (size_t i = 0; i < system_configs.block_size; ++i) {
-        y[i] = linear_interpolator.get_value();
-        linear_interpolator.next_step();
-    }
+    linear_interpolator.fill(y.data(), y.size());
 
     return y;
 }
 
 void RootMeanSquare::_reset_param() {
     x.resize(AUDIO_BUFFER_SIZE, 0.0f);
+    frame = SampleView(x);
 
     prv_y = 0.0;
     crr_y = 0.0;
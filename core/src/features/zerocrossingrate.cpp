@@ -25,38 +25,29 @@ void ZeroCrossingRate::initialize(SystemConfigs sys_cfg) {
 void ZeroCrossingRate::extract() {
     assert(is_initialized());
 
-    int zero_crossings = 0;
-    int x_size = x.size();
-
-    for (int i = 1; i < x_size; ++i) {
-        if ((x[i] >= 0 && x[i - 1] < 0) || (x[i] < 0 && x[i - 1] >= 0)) {
-            ++zero_crossings;
-        }
+    begin(frame.data(), frame.size());
+    for (size_t i = 0; i < frame.size(); ++i) {
+        accumulate(frame[i], i);
     }
-
-    crr_y = static_cast<Param>(zero_crossings) / (x_size - 1);
+    finish(frame.data(), frame.size());
 }
 
 void ZeroCrossingRate::reset() { _reset_param(); }
 
-void ZeroCrossingRate::fetch(AudioInputs in) {
-    x = in.wave;
-    prv_y = crr_y;
+void ZeroCrossingRate::fetch(const AudioInputs& in) {
+    frame = in.wave;
 }
 
-FeatureVals ZeroCrossingRate::send() {
+const FeatureVals& ZeroCrossingRate::send() {
     linear_interpolator.set_value(prv_y, crr_y, system_configs.block_size);
-
-    for (size_t i = 0; i < system_configs.block_size; ++i) {
-        y[i] = linear_interpolator.get_value();
-        linear_interpolator.next_step();
-    }
+    linear_interpolator.fill(y.data(), y.size());
 
     return y;
 }
 
 void ZeroCrossingRate::_reset_param() {
     x.resize(AUDIO_BUFFER_SIZE, 0.0f);
+    frame = SampleView(x);
 
     prv_y = 0.0;
     crr_y = 0.0;
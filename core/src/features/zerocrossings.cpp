@@ -31,13 +31,13 @@ void ZeroCrossings::extract() {
 
 void ZeroCrossings::reset() { _reset_param(); }
 
-void ZeroCrossings::fetch(AudioInputs in) {
+void ZeroCrossings::fetch(const AudioInputs& in) {
     x = in.block;
     y.clear();
     y.resize(x.size(), 0.0f);
 }
 
-FeatureVals ZeroCrossings::send() { return y; }
+const FeatureVals& ZeroCrossings::send() { return y; }
 
 void ZeroCrossings::_reset_param() {
     x.resize(system_configs.block_size, 0.0f);
@@ -0,0 +1,135 @@
+#include "asyncfeaturebank.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+#include "tracer.h"
+using namespace zerr;
+
+AsyncFeatureBank::~AsyncFeatureBank() { stop(); }
+
+void AsyncFeatureBank::initialize(FeatureNames feature_names, SystemConfigs system_configs,
+                                  size_t n_channels, size_t max_latency)
+{
+    if (running.load()) {
+        throw std::runtime_error("AsyncFeatureBank is already running");
+    }
+    if (system_configs.block_size < 1) {
+        throw std::runtime_error("AsyncFeatureBank needs a block size of at least one sample");
+    }
+
+    bank.initialize(feature_names, system_configs, n_channels);
+    bank.set_interpolation_mode(interpolation_mode);
+
+    this->n_channels = n_channels;
+    block_size       = system_configs.block_size;
+
+    // the largest frame is what the worker may need to catch up with after a stall
+    if (max_latency == 0) {
+        max_latency = system_configs.frame_size;
+        for (const auto& name : feature_names) {
+            size_t at_pos = name.find('@');
+            if (at_pos != std::string::npos) {
+                max_latency = std::max<size_t>(max_latency, std::stoul(name.substr(at_pos + 1)));
+            }
+        }
+    }
+    size_t max_blocks = std::max<size_t>(1, (max_latency + block_size - 1) / block_size);
+    this->max_latency = max_blocks * block_size;
+
+    input = std::make_unique<SPSCRingBuffer>(this->max_latency, n_channels);
+
+    Frame initial;
+    initial.values.assign(n_channels * feature_names.size(), FeatureVals(block_size, 0.0f));
+    initial.position = 0;
+    frames = std::make_unique<TripleBuffer<Frame>>(initial);
+
+    pushed = 0;
+    latency.store(0);
+    load_meter.set_period(system_configs);
+
+    // the idle worker checks the input four times per block
+    poll_interval = std::chrono::microseconds(
+        std::max<size_t>(1, 250000 * block_size / std::max<size_t>(system_configs.sample_rate, 1)));
+
+    running.store(true);
+    worker = std::thread(&AsyncFeatureBank::_run, this);
+}
+
+const FeaturesVals& AsyncFeatureBank::perform(const Block& in)
+{
+    if (n_channels != 1 || in.size() != block_size) {
+        throw std::invalid_argument("AsyncFeatureBank expects " + std::to_string(n_channels) +
+                                    " input blocks of " + std::to_string(block_size) +
+                                    " samples");
+    }
+
+    LoadMeter::Scope measure(load_meter);
+    ZERR_TRACE_SCOPE("module", "AsyncFeatureBank::perform");
+    pushed += input->write(in.data(), in.size());
+
+    return _fetch();
+}
+
+const FeaturesVals& AsyncFeatureBank::perform(const Blocks& in)
+{
+    // a block shorter than the others would be read past its end
+    bool sized = in.size() == n_channels;
+    for (size_t ch = 0; sized && ch < in.size(); ++ch) {
+        sized = in[ch].size() == block_size;
+    }
+    if (!sized) {
+        throw std::invalid_argument("AsyncFeatureBank expects " + std::to_string(n_channels) +
+                                    " input blocks of " + std::to_string(block_size) +
+                                    " samples");
+    }
+
+    LoadMeter::Scope measure(load_meter);
+    ZERR_TRACE_SCOPE("module", "AsyncFeatureBank::perform");
+    pushed += input->write(in);
+
+    return _fetch();
+}
+
+void AsyncFeatureBank::stop()
+{
+    if (!worker.joinable()) {
+        return;
+    }
+    running.store(false);
+    wake.notify_one();
+    worker.join();
+}
+
+const FeaturesVals& AsyncFeatureBank::_fetch()
+{
+    // the worker is not signalled, notify_one() may enter the kernel on the audio thread
+    const Frame& frame = frames->read();
+    latency.store(pushed - frame.position, std::memory_order_relaxed);
+
+    return frame.values;
+}
+
+void AsyncFeatureBank::_run()
+{
+    Blocks in(n_channels, Block(block_size, 0.0));
+    uint64_t position = 0;
+
+    while (running.load(std::memory_order_acquire)) {
+        if (input->get_read_available() < block_size) {
+            // perform() never signals, the input is polled and only stop() wakes the worker
+            std::unique_lock<std::mutex> lock(wake_mutex);
+            wake.wait_for(lock, poll_interval);
+            continue;
+        }
+
+        // every block is analysed, as extractors and hops depend on the continuous signal
+        input->read(in, block_size);
+        position += block_size;
+
+        Frame& frame   = frames->back();
+        frame.values   = bank.perform(in);
+        frame.position = position;
+        frames->publish();
+    }
+}
@@ -8,6 +8,7 @@
  */
 
 #include "audiodisperser.h"
+#include "tracer.h"
 using namespace zerr;
 
 AudioDisperser::AudioDisperser(int numChannel, zerr::SystemConfigs systemCfgs) {
@@ -24,27 +25,28 @@ AudioDisperser::AudioDisperser(int numChannel, zerr::SystemConfigs systemCfgs) {
 }
 
 bool AudioDisperser::initialize() {
-    inputBuffer.resize(numInlet, Samples(systemCfgs.block_size, 0.0f));
-    outputBuffer.resize(numOutlet, Samples(systemCfgs.block_size, 0.0f));
+    outputBuffer.resize(numOutlet, systemCfgs.block_size);
+    loadMeter.set_period(systemCfgs);
 
     return true;
 }
 
-Blocks AudioDisperser::perfrom(Blocks in) {
-    inputBuffer = in;
+const PlanarBuffer& AudioDisperser::perform(const PlanarBuffer& in) {
+    LoadMeter::Scope measure(loadMeter);
+    ZERR_TRACE_SCOPE("module", "AudioDisperser::perform");
 
-    // clean the output buffer
-    for (auto& buffer : outputBuffer) {
-        buffer.assign(buffer.size(), 0.0f);
-    }
-
-    Samples& source = inputBuffer[0];
+    // every output is written completely, the input is only read
+    const Sample* source = in.channel(0);
 
     for (int i = 1; i < numInlet; ++i) {
+        const Sample* envelope = in.channel(i);
+        Sample* out            = outputBuffer.channel(i - 1);
         for (size_t j = 0; j < systemCfgs.block_size; ++j) {
-            outputBuffer[i - 1][j] = source[j] * inputBuffer[i][j];
+            out[j] = source[j] * envelope[j];
         }
     }
 
     return outputBuffer;
 }
+
+Blocks AudioDisperser::perfrom(Blocks in) { return perform(PlanarBuffer(in)).to_blocks(); }
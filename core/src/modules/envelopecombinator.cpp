@@ -7,6 +7,7 @@
  * @copyright Copyright (c) 2023-2024
  */
 #include "envelopecombinator.h"
+#include "tracer.h"
 using namespace zerr;
 
 EnvelopeCombinator::EnvelopeCombinator(int numSource, int numChannel, SystemConfigs systemCfgs,
@@ -28,8 +29,9 @@ EnvelopeCombinator::EnvelopeCombinator(int numSource, int numChannel, SystemConf
 
 bool EnvelopeCombinator::initialize()
 {
-    inputBuffer.resize(numInlet, Samples(systemCfgs.block_size, 0.0f));
-    outputBuffer.resize(numOutlet, Samples(systemCfgs.block_size, 0.0f));
+    inputBuffer.resize(numInlet, systemCfgs.block_size);
+    outputBuffer.resize(numOutlet, systemCfgs.block_size);
+    loadMeter.set_period(systemCfgs);
 
     if (combMode == "add") {
         processFunc = &EnvelopeCombinator::_process_add;
@@ -48,8 +50,11 @@ bool EnvelopeCombinator::initialize()
     return true;
 }
 
-Blocks EnvelopeCombinator::perform(Blocks in)
+const PlanarBuffer& EnvelopeCombinator::perform(const PlanarBuffer& in)
 {
+    LoadMeter::Scope measure(loadMeter);
+    ZERR_TRACE_SCOPE("module", "EnvelopeCombinator::perform");
+
     inputBuffer = in;
 
     if (processFunc) {
@@ -59,17 +64,19 @@ Blocks EnvelopeCombinator::perform(Blocks in)
     return outputBuffer;
 }
 
+Blocks EnvelopeCombinator::perform(Blocks in) { return perform(PlanarBuffer(in)).to_blocks(); }
+
 void EnvelopeCombinator::_process_add()
 {
     // clean the output buffer
-    for (auto& buffer : outputBuffer) {
-        buffer.assign(buffer.size(), 0.0f);
-    }
+    outputBuffer.fill(0.0);
 
     for (int i = 0; i < numChannel; ++i) {
+        Sample* out = outputBuffer.channel(i);
         for (int j = 0; j < numSource; ++j) {
+            const Sample* src = inputBuffer.channel(i + j * numChannel);
             for (size_t k = 0; k < systemCfgs.block_size; ++k) {
-                outputBuffer[i][k] += inputBuffer[i + j * numChannel][k];
+                out[k] += src[k];
             }
         }
     }
@@ -77,42 +84,36 @@ void EnvelopeCombinator::_process_add()
 
 void EnvelopeCombinator::_process_root()
 {
-    // clean the output buffer
-    for (auto& buffer : outputBuffer) {
-        buffer.assign(buffer.size(), 0.0f);
-    }
-
     double exponent = 1.0 / (double)numSource;
-    Sample multi_tmp;
     for (int i = 0; i < numChannel; ++i) {
+        // multiply the sources into the output, then take the root in place
+        Sample* out = outputBuffer.channel(i);
+        std::fill(out, out + systemCfgs.block_size, 1.0);
+        for (int j = 0; j < numSource; ++j) {
+            const Sample* src = inputBuffer.channel(i + j * numChannel);
+            for (size_t k = 0; k < systemCfgs.block_size; ++k) {
+                out[k] *= src[k];
+            }
+        }
         // TODO: use systemcfg.block_size could cause bug(sometimes smaller)
         for (size_t k = 0; k < systemCfgs.block_size; ++k) {
-            multi_tmp = 1;
-            for (int j = 0; j < numSource; ++j) {
-                multi_tmp *= inputBuffer[i + j * numChannel][k];
-            }
-            outputBuffer[i][k] = std::pow(std::abs(multi_tmp), exponent);
+            out[k] = std::pow(std::abs(out[k]), exponent);
         }
     }
 }
 
 void EnvelopeCombinator::_process_max()
 {
-    // clean the output buffer
-    for (auto& buffer : outputBuffer) {
-        buffer.assign(buffer.size(), 0.0f);
-    }
+    // the maximum starts at 0, negative envelopes are clipped
+    outputBuffer.fill(0.0);
 
-    Sample maxVal;
-    Sample tmp;
     for (int i = 0; i < numChannel; ++i) {
-        for (size_t k = 0; k < systemCfgs.block_size; ++k) {
-            maxVal = 0;
-            for (int j = 0; j < numSource; ++j) {
-                tmp    = inputBuffer[i + j * numChannel][k];
-                maxVal = tmp > maxVal ? tmp : maxVal;
+        Sample* out = outputBuffer.channel(i);
+        for (int j = 0; j < numSource; ++j) {
+            const Sample* src = inputBuffer.channel(i + j * numChannel);
+            for (size_t k = 0; k < systemCfgs.block_size; ++k) {
+                out[k] = src[k] > out[k] ? src[k] : out[k];
             }
-            outputBuffer[i][k] = maxVal;
         }
     }
 }
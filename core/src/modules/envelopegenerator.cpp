@@ -7,8 +7,12 @@
  * @copyright Copyright (c) 2023-2025
  */
 #include "envelopegenerator.h"
+#include "tracer.h"
+
+#include <algorithm>
 
 using zerr::Blocks;
+using zerr::ChannelView;
 using zerr::EnvelopeGenerator;
 using zerr::Param;
 
@@ -25,6 +29,8 @@ EnvelopeGenerator::EnvelopeGenerator(SystemConfigs systemCfgs, std::string speak
 
     onsetDetector = new OnsetDetector(50);
 
+    volumeGate.set_threshold(VOLUME_THRESHOLD);
+
 #ifdef TESTMODE
     logger->setLogLevel(LogLevel::INFO);
 #endif // TESTMODE
@@ -53,11 +59,18 @@ bool EnvelopeGenerator::initialize()
     ;
 
     // initialize the inputbuffer and outputbuffer size.
-    inputBuffers.resize(numInlet, Samples(systemCfgs.block_size, 0.0f));
-    outputBuffers.resize(numOutlet, Samples(systemCfgs.block_size, 0.0f));
+    inputBuffers.resize(numInlet, systemCfgs.block_size);
+    outputBuffers.resize(numOutlet, systemCfgs.block_size);
+    loadMeter.set_period(systemCfgs);
 
-    // setup index to channel reverse lookup table
+    // setup index to channel reverse lookup table, a flat table so that perform() neither
+    // searches nor inserts
     Indexes indexes = speakerManager->getActiveSpeakerIndexes();
+    Index maxIndex  = 0;
+    for (Index index : indexes) {
+        maxIndex = std::max(maxIndex, index);
+    }
+    indexChannelLookup.assign(maxIndex + 1, 0);
     for (size_t i = 0; i < indexes.size(); ++i) {
         indexChannelLookup[indexes[i]] = i;
     }
@@ -72,10 +85,15 @@ bool EnvelopeGenerator::initialize()
     return true;
 }
 
-Blocks EnvelopeGenerator::perform(Blocks in)
+const zerr::PlanarBuffer& EnvelopeGenerator::perform(const PlanarBuffer& in)
 {
-    // fetch
+    Logger::RealtimeScope realtime;
+    LoadMeter::Scope measure(loadMeter);
+    ZERR_TRACE_SCOPE("module", "EnvelopeGenerator::perform");
+
+    // fetch, the trigger detection clears debounced triggers in the input copy
     inputBuffers = in;
+    volumeGate.process(inputBuffers[2]);
 
     // process
     if (processFunc) {
@@ -86,6 +104,8 @@ Blocks EnvelopeGenerator::perform(Blocks in)
     return outputBuffers;
 }
 
+Blocks EnvelopeGenerator::perform(Blocks in) { return perform(PlanarBuffer(in)).to_blocks(); }
+
 int EnvelopeGenerator::getNumSpeakers() { return speakerManager->getNumAllSpeakers(); }
 
 void EnvelopeGenerator::setCurrentSpeaker(Index newIdx)
@@ -115,6 +135,15 @@ void EnvelopeGenerator::setTriggerInterval(Param newInterval)
     onsetDetector->setDebounceThreshold(newThreshold);
 }
 
+void EnvelopeGenerator::setSeed(unsigned int seed)
+{
+    speakerManager->setSeed(seed);
+    // the first speaker of the trigger mode was drawn by initialize()
+    if (genMode == "trigger") {
+        speakerManager->setCurrentSpeaker(speakerManager->getRandomIndex());
+    }
+}
+
 void EnvelopeGenerator::printParameters() { speakerManager->printParameters(); }
 
 EnvelopeGenerator::~EnvelopeGenerator()
@@ -132,29 +161,51 @@ void EnvelopeGenerator::setPrinter(Logger::PrintStrategy newPrinter)
     speakerManager->setPrinter(newPrinter);
 }
 
+void EnvelopeGenerator::setLogDeferred(bool deferred)
+{
+    logger->setDeferred(deferred);
+    speakerManager->logger->setDeferred(deferred);
+}
+
+void EnvelopeGenerator::flushLog()
+{
+    logger->flush();
+    speakerManager->logger->flush();
+}
+
+bool EnvelopeGenerator::hasPendingLog() const
+{
+    return logger->hasPending() || speakerManager->logger->hasPending();
+}
+
 void EnvelopeGenerator::_processTrigger()
 {
     size_t channel;
-    Params distances; // distances between speakers
-    Param powerSum;   // the overall power
+    Param powerSum; // the overall power
     Param gain;
     Index currIdx;
 
     // empty the outputBuffers
-    for (auto& buffer : outputBuffers) {
-        buffer.assign(buffer.size(), 0.0f);
-    }
+    outputBuffers.fill(0.0);
 
     // input signals references
-    Samples& triggr = inputBuffers[0];
-    Samples& spread = inputBuffers[1];
-    Samples& volume = inputBuffers[2];
+    ChannelView triggr = inputBuffers[0];
+    ChannelView spread = inputBuffers[1];
+    ChannelView volume = inputBuffers[2];
 
     // process trigger blocks: detect onsets
     onsetDetector->detectOnsetInBlock(triggr);
 
+    // a muted source only follows its triggers, the envelopes stay zero
+    if (!volumeGate.is_open()) {
+        for (size_t cnt = 0; cnt < triggr.size(); ++cnt) {
+            speakerManager->getIndexesByTrigger(triggr[cnt], triggerMode);
+        }
+        return;
+    }
+
     // calculate the envelopes TODO: add interpolator
-    for (size_t cnt = 0; cnt < inputBuffers[0].size(); ++cnt) {
+    for (size_t cnt = 0; cnt < triggr.size(); ++cnt) {
         // find main speaker
         currIdx = speakerManager->getIndexesByTrigger(triggr[cnt], triggerMode);
         channel = indexChannelLookup[currIdx]; // get the channel of the
@@ -163,8 +214,8 @@ void EnvelopeGenerator::_processTrigger()
         powerSum                    = 1.0;
 
         // calculate spread gains
-        distances = speakerManager->getDistanceVector(currIdx);
-        for (size_t chnl = 0; chnl < outputBuffers.size(); ++chnl) {
+        const Params& distances = speakerManager->getDistanceVector(currIdx);
+        for (size_t chnl = 0; chnl < outputBuffers.get_n_channels(); ++chnl) {
             if (chnl == channel) {
                 continue;
             }
@@ -174,7 +225,7 @@ void EnvelopeGenerator::_processTrigger()
         }
 
         // normalize the overall power
-        for (size_t chnl = 0; chnl < outputBuffers.size(); ++chnl) {
+        for (size_t chnl = 0; chnl < outputBuffers.get_n_channels(); ++chnl) {
             outputBuffers[chnl][cnt] = sqrt(outputBuffers[chnl][cnt] / powerSum) * volume[cnt];
         }
     }
@@ -189,13 +240,13 @@ void EnvelopeGenerator::_processTrajectory()
 
     Params distances;
 
-    for (auto& buffer : outputBuffers) {
-        buffer.assign(buffer.size(), 0.0f);
+    outputBuffers.fill(0.0);
+    if (!volumeGate.is_open()) {
+        return;
     }
 
-    Samples& trjcty = inputBuffers[0];
-    Samples& spread = inputBuffers[1];
-    Samples& volume = inputBuffers[2];
+    ChannelView trjcty = inputBuffers[0];
+    ChannelView volume = inputBuffers[2];
 
     for (size_t cnt = 0; cnt < trjcty.size(); ++cnt) {
         speakerPair = speakerManager->getIndexesByTrajectory(trjcty[cnt]);
@@ -1,8 +1,14 @@
 #include "featurebank.h"
+
+#include <algorithm>
+#include <cassert>
+#include <stdexcept>
+
+#include "tracer.h"
 using namespace zerr;
 using namespace feature;
 
-FeatureBank::FeatureBank() : ring_buffer(AUDIO_BUFFER_SIZE), freq_transformer(AUDIO_BUFFER_SIZE)
+FeatureBank::FeatureBank() : ring_buffer(AUDIO_BUFFER_SIZE)
 {
     _regist_all();
 }
@@ -23,7 +29,7 @@ void FeatureBank::print_all_features()
 void FeatureBank::print_active_features()
 {
     std::cout << "All activated features: " << std::endl;
-    for (size_t i = 0; i < activated_features.size(); ++i) {
+    for (size_t i = 0; i < activated_features.size(); i += n_channels) {
         std::cout << "  -Name: " << activated_features[i]->get_name() << std::endl;
         std::cout << "  -Category: " << activated_features[i]->get_category() << std::endl;
         std::cout << "  -Description: " << activated_features[i]->get_description() << std::endl;
@@ -31,53 +37,246 @@ void FeatureBank::print_active_features()
     }
 }
 
-void FeatureBank::initialize(FeatureNames feature_names, SystemConfigs system_configs)
+void FeatureBank::initialize(FeatureNames feature_names, SystemConfigs system_configs,
+                             size_t n_channels)
 {
+    if (n_channels < 1) {
+        throw std::runtime_error("FeatureBank needs at least one input channel");
+    }
+    this->n_channels     = n_channels;
+    this->system_configs = system_configs;
+
+    // the default resolution keeps the behaviour of a single analysis frame
+    _get_resolution(AUDIO_BUFFER_SIZE, 0);
+
     for (auto name : feature_names) {
-        activated_features.push_back(_create(name));
+        const std::string full_name = name;
+        // split "name@frame_size/hop_size" into its parts
+        size_t frame_size = AUDIO_BUFFER_SIZE;
+        size_t hop_size   = 0;
+        size_t at_pos     = name.find('@');
+        if (at_pos != std::string::npos) {
+            std::string spec  = name.substr(at_pos + 1);
+            name              = name.substr(0, at_pos);
+            size_t slash_pos  = spec.find('/');
+            try {
+                frame_size = std::stoul(spec.substr(0, slash_pos));
+                if (slash_pos != std::string::npos) {
+                    hop_size = std::stoul(spec.substr(slash_pos + 1));
+                }
+            }
+            catch (const std::exception&) {
+                throw std::runtime_error("Feature |" + name + "| has an invalid resolution |" +
+                                         spec + "|");
+            }
+        }
+        // every channel runs its own extractor, as extractors keep state between frames
+        for (size_t ch = 0; ch < n_channels; ++ch) {
+            activated_features.push_back(_create(name));
+            trace_labels.push_back(n_channels > 1 ? name + "/" + std::to_string(ch) : name);
+            bus_labels.push_back(n_channels > 1 ? full_name + "/" + std::to_string(ch)
+                                                : full_name);
+        }
+        feature_resolution.push_back(_get_resolution(frame_size, hop_size));
     }
 
-    n_features = activated_features.size();
-    for (int i = 0; i < n_features; ++i) {
-        activated_features[i]->initialize(system_configs);
+    // order the resolutions by frame size, so that the largest one is analysed first
+    std::vector<size_t> order(resolutions.size());
+    for (size_t i = 0; i < order.size(); ++i) {
+        order[i] = i;
+    }
+    std::stable_sort(order.begin(), order.end(), [this](size_t a, size_t b) {
+        return resolutions[a].frame_size > resolutions[b].frame_size;
+    });
+    std::vector<size_t> position(order.size());
+    std::vector<Resolution> sorted;
+    for (size_t i = 0; i < order.size(); ++i) {
+        position[order[i]] = i;
+        sorted.push_back(std::move(resolutions[order[i]]));
+    }
+    resolutions = std::move(sorted);
+    for (auto& index : feature_resolution) {
+        index = position[index];
     }
+
+    ring_buffer = RingBuffer(resolutions[0].frame_size, n_channels);
+    input_views.resize(n_channels);
+
+    const Resolution& largest = resolutions[0];
+    for (auto& res : resolutions) {
+        // derivation needs an integer bin ratio and analyses aligned with the largest frame
+        size_t largest_hop = std::max(largest.hop_size, system_configs.block_size);
+        size_t hop         = std::max(res.hop_size, system_configs.block_size);
+        res.derive = res.derive && &res != &largest && largest.frame_size % res.frame_size == 0 &&
+                     hop % largest_hop == 0;
+
+        res.due     = false;
+        res.elapsed = 0;
+        res.x.resize(n_channels);
+        // all analysis inputs are sized here, so that perform() does not allocate
+        for (auto& x : res.x) {
+            x.block.assign(system_configs.block_size, 0.0);
+            x.spec.assign(res.frame_size / 2 + 1, 0.0);
+            x.fft.assign(res.frame_size / 2 + 1, Complex{0.0, 0.0});
+        }
+
+        if (!res.derive && !res.freq_transformer) {
+            // the sliding DFT pays per sample, it only wins when a spectrum is due every sample
+            // or two, see bench/sliding_dft.cpp
+            SpectrumMode mode = spectrum_mode;
+            if (mode == SpectrumMode::AUTO) {
+                size_t hop = std::max(res.hop_size, system_configs.block_size);
+                mode = hop <= SLIDING_DFT_MAX_HOP ? SpectrumMode::SLIDING_DFT : SpectrumMode::FFT;
+            }
+            res.freq_transformer =
+                std::make_unique<FrequencyTransformer>(res.frame_size, n_channels, mode);
+        }
+    }
+
+    n_features = feature_resolution.size();
     y.resize(activated_features.size());
+    feature_triggers.assign(activated_features.size(), false);
+    for (size_t i = 0; i < activated_features.size(); ++i) {
+        Resolution& res = resolutions[feature_resolution[i / n_channels]];
 
-    x.wave.resize(AUDIO_BUFFER_SIZE);
+        // sample-level features produce a new value in every block
+        feature_triggers[i] = activated_features[i]->get_category() == "Sample-Level";
+        if (feature_triggers[i] && res.hop_size > system_configs.block_size) {
+            throw std::runtime_error("Feature |" + activated_features[i]->get_name() +
+                                     "| needs a hop size equal to the block size");
+        }
+        // a derived spectrum keeps the time resolution and latency of the largest frame and
+        // has no complex bins
+        if (res.derive && (activated_features[i]->requires_time_resolution() ||
+                           activated_features[i]->requires_complex_spectrum())) {
+            throw std::runtime_error("Feature |" + activated_features[i]->get_name() +
+                                     "| needs the spectrum of its own frame size and "
+                                     "cannot use a derived one");
+        }
+
+        SystemConfigs feature_configs = system_configs;
+        feature_configs.frame_size    = res.frame_size;
+        activated_features[i]->initialize(feature_configs);
+
+        y[i].assign(system_configs.block_size, 0.0f);
+    }
+
+    feature_enabled.assign(n_features, true);
+    _update_resolutions();
+
+    // a channel is bypassed only after every resolution analysed two silent frames and the
+    // onset thresholds adapted to silence, so the held values are the ones of silence
+    size_t hold = (size_t)(SILENCE_HOLD_TIME * system_configs.sample_rate);
+    for (const auto& res : resolutions) {
+        size_t hop = std::max(res.hop_size, system_configs.block_size);
+        hold       = std::max(hold, res.frame_size + 2 * hop + system_configs.block_size);
+    }
+    silence_gates.assign(n_channels, SilenceGate(silence_threshold, hold));
+    load_meter.set_period(system_configs);
+}
+
+void FeatureBank::add_resolution(size_t frame_size, size_t hop_size, bool derive)
+{
+    size_t index               = _get_resolution(frame_size, hop_size);
+    resolutions[index].derive = derive;
 }
 
-FeaturesVals FeatureBank::perform(Block in)
+const FeaturesVals& FeatureBank::perform(const Block& in)
 {
+    LoadMeter::Scope measure(load_meter);
+    ZERR_TRACE_SCOPE("module", "FeatureBank::perform");
+
+    // a single block only feeds a single-channel bank
+    if (n_channels != 1) {
+        throw std::invalid_argument("FeatureBank expects " + std::to_string(n_channels) +
+                                    " input blocks");
+    }
+
     // fetch
-    Sample* buf_ptr = nullptr;
-    size_t buf_len;
     ring_buffer.enqueue(in);
 
-    x.block.clear();
-    x.block = in;
+    SampleView view(in);
+    return _process(&view);
+}
 
-    buf_ptr = x.wave.data();
-    buf_len = x.wave.size();
-    ring_buffer.get_samples(buf_ptr, buf_len);
+const FeaturesVals& FeatureBank::perform(const Blocks& in)
+{
+    LoadMeter::Scope measure(load_meter);
+    ZERR_TRACE_SCOPE("module", "FeatureBank::perform");
 
-    buf_ptr = freq_transformer.fft_input();
-    buf_len = freq_transformer.get_frame_size();
-    ring_buffer.get_samples(buf_ptr, buf_len);
-    freq_transformer.windowing();
-    freq_transformer.fft();
-    freq_transformer.power_spectrum();
-    x.spec = freq_transformer.get_power_spectrum();
+    if (in.size() != n_channels) {
+        throw std::invalid_argument("FeatureBank expects " + std::to_string(n_channels) +
+                                    " input blocks");
+    }
 
-    // process:
-    // TODO: use multi-thread
-    for (size_t i = 0; i < activated_features.size(); ++i) {
-        activated_features[i]->fetch(x);
-        activated_features[i]->extract();
-        y[i] = activated_features[i]->send();
+    // fetch
+    ring_buffer.enqueue(in);
+
+    for (size_t ch = 0; ch < n_channels; ++ch) {
+        input_views[ch] = SampleView(in[ch]);
     }
+    return _process(input_views.data());
+}
 
-    // send
-    return y;
+const FeaturesVals& FeatureBank::perform(const PlanarBuffer& in)
+{
+    LoadMeter::Scope measure(load_meter);
+    ZERR_TRACE_SCOPE("module", "FeatureBank::perform");
+
+    if (in.get_n_channels() != n_channels) {
+        throw std::invalid_argument("FeatureBank expects " + std::to_string(n_channels) +
+                                    " input channels");
+    }
+
+    // fetch
+    ring_buffer.enqueue(in);
+
+    for (size_t ch = 0; ch < n_channels; ++ch) {
+        input_views[ch] = in[ch];
+    }
+    return _process(input_views.data());
+}
+
+void FeatureBank::set_silence_threshold(Sample threshold)
+{
+    silence_threshold = threshold;
+    for (auto& gate : silence_gates) {
+        gate.set_threshold(threshold);
+    }
+}
+
+void FeatureBank::publish(const std::string& name)
+{
+    // the old bus is removed first, so that the bank can publish again under the same name
+    bus.reset();
+    if (!name.empty()) {
+        bus = std::make_unique<FeatureBusWriter>(name, bus_labels, system_configs);
+    }
+}
+
+void FeatureBank::set_feature_enabled(size_t index, bool enabled)
+{
+    if (index >= feature_enabled.size()) {
+        throw std::out_of_range("FeatureBank has no feature " + std::to_string(index));
+    }
+    if (feature_enabled[index] == enabled) {
+        return;
+    }
+    feature_enabled[index] = enabled;
+
+    for (size_t ch = 0; ch < n_channels; ++ch) {
+        FeatureVals& out = y[index * n_channels + ch];
+        std::fill(out.begin(), out.end(), 0.0f);
+    }
+
+    _update_resolutions();
+}
+
+void FeatureBank::set_interpolation_mode(InterpolationMode mode)
+{
+    for (auto& feature : activated_features) {
+        feature->set_interpolation_mode(mode);
+    }
 }
 
 // TODO(Zeyu yang): make this an external function
@@ -91,6 +290,10 @@ void FeatureBank::_regist_all()
     _regist("cf", []() { return fe_ptr(new CrestFactor()); });       // Crest Factor
     _regist("flt", []() { return fe_ptr(new Flatness()); });         // Spectral Flatness
     _regist("zc", []() { return fe_ptr(new ZeroCrossings()); });     // Zero Crossings
+    // Onset triggers from spectral flux, complex domain and high frequency content
+    _regist("osf", []() { return fe_ptr(new Onset(OnsetFunction::SPECTRAL_FLUX)); });
+    _regist("ocd", []() { return fe_ptr(new Onset(OnsetFunction::COMPLEX_DOMAIN)); });
+    _regist("ohf", []() { return fe_ptr(new Onset(OnsetFunction::HIGH_FREQUENCY_CONTENT)); });
 }
 
 void FeatureBank::_regist(const std::string& className, CreateFunc createFunc)
@@ -107,3 +310,194 @@ std::unique_ptr<FeatureExtractor> FeatureBank::_create(const std::string& classN
 
     throw std::runtime_error("Feature |" + className + "| not found, please check your spelling");
 }
+
+size_t FeatureBank::_get_resolution(size_t frame_size, size_t hop_size)
+{
+    if (frame_size < 2) {
+        throw std::runtime_error("Analysis frame size " + std::to_string(frame_size) +
+                                 " is too small");
+    }
+
+    for (size_t i = 0; i < resolutions.size(); ++i) {
+        if (resolutions[i].frame_size == frame_size) {
+            if (hop_size != 0) {
+                resolutions[i].hop_size = hop_size;
+            }
+            return i;
+        }
+    }
+
+    Resolution res;
+    res.frame_size   = frame_size;
+    res.hop_size     = hop_size;
+    res.derive       = false;
+    res.enabled      = true;
+    res.spectrum     = true;
+    res.restart      = false;
+    res.complex_spec = false;
+    res.due          = false;
+    res.elapsed      = 0;
+    resolutions.push_back(std::move(res));
+
+    return resolutions.size() - 1;
+}
+
+void FeatureBank::_analyse_spectrum(Resolution& res)
+{
+    ZERR_TRACE_SCOPE("stage", "fft");
+
+    if (res.derive) {
+        // average groups of bins of the larger power spectrum
+        const Resolution& largest = resolutions[0];
+        const size_t ratio        = largest.frame_size / res.frame_size;
+        for (size_t ch = 0; ch < n_channels; ++ch) {
+            const AudioInputs& src = largest.x[ch];
+            AudioInputs& dst       = res.x[ch];
+            const size_t n_bins    = src.spec.size();
+            for (size_t k = 0; k < dst.spec.size(); ++k) {
+                size_t begin = k * ratio;
+                size_t end   = std::min(begin + ratio, n_bins);
+                double sum   = 0.0;
+                for (size_t j = begin; j < end; ++j) {
+                    sum += src.spec[j];
+                }
+                dst.spec[k] = end > begin ? sum / (double)(end - begin) : 0.0;
+            }
+        }
+        return;
+    }
+
+    // all channels go through one batched transform, the sliding DFT is already up to date
+    FrequencyTransformer& transformer = *res.freq_transformer;
+    if (transformer.get_mode() == SpectrumMode::FFT) {
+        for (size_t ch = 0; ch < n_channels; ++ch) {
+            std::copy(res.x[ch].wave.begin(), res.x[ch].wave.end(), transformer.fft_input(ch));
+        }
+    }
+    transformer.windowing();
+    transformer.fft();
+    transformer.power_spectrum();
+    for (size_t ch = 0; ch < n_channels; ++ch) {
+        transformer.get_power_spectrum(res.x[ch].spec, ch);
+        if (res.complex_spec) {
+            transformer.get_complex_spectrum(res.x[ch].fft, ch);
+        }
+    }
+}
+
+void FeatureBank::_update_resolutions()
+{
+    for (auto& res : resolutions) {
+        // a sliding DFT that is not needed skips samples
+        res.restart      = res.restart || !res.spectrum;
+        res.enabled      = false;
+        res.spectrum     = false;
+        res.complex_spec = false;
+    }
+    for (size_t i = 0; i < activated_features.size(); ++i) {
+        if (!feature_enabled[i / n_channels]) {
+            continue;
+        }
+        FeatureExtractor& feature = *activated_features[i];
+        Resolution& res           = resolutions[feature_resolution[i / n_channels]];
+        res.enabled               = true;
+        res.complex_spec          = res.complex_spec || feature.requires_complex_spectrum();
+        res.spectrum = res.spectrum || res.complex_spec || feature.requires_spectrum();
+    }
+
+    // a derived spectrum is computed from the spectrum of the largest frame
+    for (auto& res : resolutions) {
+        if (res.derive && res.spectrum) {
+            // initialize() refuses features that read complex bins on a derived resolution
+            assert(!res.complex_spec && "A derived resolution only provides a power spectrum");
+            resolutions[0].enabled  = true;
+            resolutions[0].spectrum = true;
+        }
+    }
+}
+
+const FeaturesVals& FeatureBank::_process(const SampleView* in)
+{
+    const size_t block_size = in[0].size();
+
+    bool active = false;
+    for (size_t ch = 0; ch < n_channels; ++ch) {
+        const bool was_open = silence_gates[ch].is_open();
+        if (silence_gates[ch].process(in[ch]) && !was_open) {
+            // the sliding DFT skipped the silence, restart it from an empty frame
+            for (auto& res : resolutions) {
+                if (res.freq_transformer) {
+                    res.freq_transformer->clear_slide(ch);
+                }
+            }
+        }
+        active = active || silence_gates[ch].is_open();
+    }
+
+    for (auto& res : resolutions) {
+        // the sliding DFT sees every sample of an active channel, also between two analyses
+        if (res.spectrum && res.freq_transformer &&
+            res.freq_transformer->get_mode() == SpectrumMode::SLIDING_DFT) {
+            if (res.restart) {
+                for (size_t ch = 0; ch < n_channels; ++ch) {
+                    res.freq_transformer->clear_slide(ch);
+                }
+                res.restart = false;
+            }
+            for (size_t ch = 0; ch < n_channels; ++ch) {
+                if (silence_gates[ch].is_open()) {
+                    res.freq_transformer->slide(in[ch].data(), in[ch].size(), ch);
+                }
+            }
+        }
+
+        res.elapsed += block_size;
+        res.due = res.elapsed >= res.hop_size;
+        if (!res.due)
+            continue;
+        res.elapsed = res.hop_size > 0 ? res.elapsed % res.hop_size : 0;
+        // the hops keep their timing while all channels are silent or the features disabled
+        if (!active || !res.enabled)
+            continue;
+
+        for (size_t ch = 0; ch < n_channels; ++ch) {
+            res.x[ch].block.assign(in[ch].begin(), in[ch].end());
+            // the frame is read in place from the ring buffer
+            res.x[ch].wave = ring_buffer.view(res.frame_size, ch);
+        }
+        if (res.spectrum) {
+            _analyse_spectrum(res);
+        }
+    }
+
+    // process:
+    // TODO: use multi-thread
+    for (size_t i = 0; i < activated_features.size(); ++i) {
+        if (!feature_enabled[i / n_channels]) {
+            continue;
+        }
+        Resolution& res = resolutions[feature_resolution[i / n_channels]];
+        if (!silence_gates[i % n_channels].is_open()) {
+            // continuous features hold their last value until the end of silence, triggers
+            // are released so that one fired in the last active block does not latch
+            std::fill(y[i].begin(), y[i].end(), feature_triggers[i] ? 0.0f : y[i].back());
+            continue;
+        }
+        if (!res.due) {
+            // hold the last value until the next hop of this resolution
+            std::fill(y[i].begin(), y[i].end(), y[i].back());
+            continue;
+        }
+        ZERR_TRACE_SCOPE("feature", trace_labels[i].c_str());
+        activated_features[i]->fetch(res.x[i % n_channels]);
+        activated_features[i]->extract();
+        y[i] = activated_features[i]->send();
+    }
+
+    if (bus) {
+        bus->publish(y);
+    }
+
+    // send
+    return y;
+}
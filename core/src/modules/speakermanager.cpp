@@ -31,28 +31,28 @@ void Speaker::printAll()
     _print_orientation();
 }
 
-void Speaker::_print_index() { logger->logInfo(formatString("Speaker ID: %d", index)); }
+void Speaker::_print_index() { logger->logFormat(LogLevel::INFO, "Speaker ID: %d", index); }
 
 void Speaker::_print_position()
 {
     logger->logInfo("Cartesian Position: ");
-    logger->logInfo(formatString("    x: %.2f", position.cartesian.x));
-    logger->logInfo(formatString("    y: %.2f", position.cartesian.y));
-    logger->logInfo(formatString("    z: %.2f", position.cartesian.z));
+    logger->logFormat(LogLevel::INFO, "    x: %.2f", position.cartesian.x);
+    logger->logFormat(LogLevel::INFO, "    y: %.2f", position.cartesian.y);
+    logger->logFormat(LogLevel::INFO, "    z: %.2f", position.cartesian.z);
     logger->logInfo("Spherical Position: ");
-    logger->logInfo(formatString("    azimuth:   : %.2f", position.spherical.azimuth));
-    logger->logInfo(formatString("    elevation: : %.2f", position.spherical.elevation));
-    logger->logInfo(formatString("    distance:  : %.2f", position.spherical.distance));
+    logger->logFormat(LogLevel::INFO, "    azimuth:   : %.2f", position.spherical.azimuth);
+    logger->logFormat(LogLevel::INFO, "    elevation: : %.2f", position.spherical.elevation);
+    logger->logFormat(LogLevel::INFO, "    distance:  : %.2f", position.spherical.distance);
 }
 
 void Speaker::_print_orientation()
 {
     logger->logInfo("Orientation: ");
-    logger->logInfo(formatString("    yaw:   : %.2f", orientation.yaw));
-    logger->logInfo(formatString("    pitch: : %.2f", orientation.pitch));
+    logger->logFormat(LogLevel::INFO, "    yaw:   : %.2f", orientation.yaw);
+    logger->logFormat(LogLevel::INFO, "    pitch: : %.2f", orientation.pitch);
 }
 
-SpeakerManager::SpeakerManager(ConfigPath spkrArry)
+SpeakerManager::SpeakerManager(ConfigPath spkrArry) : randomEngine(std::random_device{}())
 {
     this->speakerArrayPath = spkrArry;
 
@@ -168,7 +168,7 @@ Indexes SpeakerManager::getActiveSpeakerIndexes() { return actvSpkIdx; }
 
 Index SpeakerManager::getRandomIndex()
 {
-    return actvSpkIdx[_getRandomIndexes(actvSpkIdx.size(), 1)[0]];
+    return actvSpkIdx[_getRandomIndex(actvSpkIdx.size())];
 }
 
 Speaker SpeakerManager::getSpeakerByIndex(Index spkrIdx)
@@ -255,21 +255,25 @@ Pair SpeakerManager::get_indexs_by_geometry(std::vector<Param> pos, std::vector<
     return std::make_pair(smallest, second_small);
 }
 
-Index SpeakerManager::getIndexesByTrigger(Param trigger, Mode mode)
+Index SpeakerManager::getIndexesByTrigger(Param trigger, const Mode& mode)
 {
     // just return the original one when trigger doesn't close to 1.0
     if (!isEqualTo1(trigger, TRIGGER_THRESHOLD))
         return currIdx;
     Index selected;
-    // load all connected speakers from the topology matrix
-    Indexes candidates = topoMatrix[currIdx];
-    int numCandidates  = candidates.size();
+    // load all connected speakers from the topology matrix, a speaker without
+    // connections stays selected
+    auto connected = topoMatrix.find(currIdx);
+    if (connected == topoMatrix.end() || connected->second.empty())
+        return currIdx;
+    const Indexes& candidates = connected->second;
+    int numCandidates         = candidates.size();
     // if only one speaker connected to the current one, just return it
     if (numCandidates == 1) {
         selected = candidates[0];
     }
     else {
-        selected = candidates[_getRandomIndexes(numCandidates, 1)[0]];
+        selected = candidates[_getRandomIndex(numCandidates)];
     }
 
     // int n_candidates = candidates.size();
@@ -290,7 +294,13 @@ Index SpeakerManager::getIndexesByTrigger(Param trigger, Mode mode)
     return currIdx;
 }
 
-Params SpeakerManager::getDistanceVector(Index spkrIdx) { return distanceMatrix[spkrIdx]; }
+const Params& SpeakerManager::getDistanceVector(Index spkrIdx) const
+{
+    static const Params unknown;
+
+    auto it = distanceMatrix.find(spkrIdx);
+    return it != distanceMatrix.end() ? it->second : unknown;
+}
 
 void SpeakerManager::setActiveSpeakers(std::string action, Indexes spkrIdxes)
 {
@@ -317,8 +327,9 @@ void SpeakerManager::setTrajectoryVector(Indexes spkrIdxes)
     Indexes tmpTrajVector;
     for (size_t i = 0; i < spkrIdxes.size(); ++i) {
         if (!isInVec<Index>(spkrIdxes[i], actvSpkIdx)) {
-            logger->logError(
-                formatString("SpeakerManager: speaker %d is not activated!", spkrIdxes[i]));
+            logger->logFormat(LogLevel::ERROR,
+                              "SpeakerManager: speaker %d is not activated!",
+                              spkrIdxes[i]);
             return;
         }
         else {
@@ -353,7 +364,7 @@ void SpeakerManager::setTopoMatrix(std::string action, Indexes spkrIdxes)
 void SpeakerManager::setCurrentSpeaker(Index newIdx)
 {
     if (!isInVec<Index>(newIdx, actvSpkIdx)) {
-        logger->logError(formatString("SpeakerManager: speaker %d is not activated!", newIdx));
+        logger->logFormat(LogLevel::ERROR, "SpeakerManager: speaker %d is not activated!", newIdx);
         return;
     }
     else {
@@ -361,14 +372,14 @@ void SpeakerManager::setCurrentSpeaker(Index newIdx)
     }
 
 #ifdef TESTMODE
-    logger->logDebug(formatString("EnvelopeGenerator::initialize currIdx %d", currIdx));
+    logger->logFormat(LogLevel::DEBUG, "EnvelopeGenerator::initialize currIdx %d", currIdx);
 #endif // TESTMODE
 }
 
 bool SpeakerManager::_isActivated(Index idx)
 {
     if (!isInVec<Index>(idx, actvSpkIdx)) {
-        logger->logError(formatString("Speaker %d is not activated!", idx));
+        logger->logFormat(LogLevel::ERROR, "Speaker %d is not activated!", idx);
         return false;
     }
     return true;
@@ -490,22 +501,12 @@ Param SpeakerManager::_calculateDistance(Speaker s1, Speaker s2)
     return distance;
 }
 
-Indexes SpeakerManager::_getRandomIndexes(int l, int n)
+int SpeakerManager::_getRandomIndex(int l)
 {
-    assert(l >= n);
-    int idx;
-    std::vector<int> random_indexs;
-
-    std::random_device rd;
-    std::mt19937 gen(rd());
+    assert(l > 0);
     std::uniform_int_distribution<> dis(0, l - 1);
 
-    for (int i = 0; i < n; ++i) {
-        idx = dis(gen);
-        random_indexs.push_back(idx);
-    }
-
-    return random_indexs;
+    return dis(randomEngine);
 }
 
 Cartesian SpeakerManager::_spherical2cartesian(Spherical spherical)
@@ -538,15 +539,16 @@ void SpeakerManager::_setActiveSpeakerIndexs(Indexes spkrIdxes)
     for (size_t i = 0; i < spkrIdxes.size(); ++i) {
         auto it = speakers.find(spkrIdxes[i]);
         if (it == speakers.end()) {
-            logger->logError(formatString("SpeakerManager::_set_actvSpkIdx_indexs unknow "
-                                          "speaker index %d!",
-                                          spkrIdxes[i]));
+            logger->logFormat(LogLevel::ERROR,
+                              "SpeakerManager::_set_actvSpkIdx_indexs unknow speaker index %d!",
+                              spkrIdxes[i]);
             return;
         }
         // add to actvSpkIdx
         if (isInVec<Index>(spkrIdxes[i], actvSpkIdx)) {
-            logger->logWarning(
-                formatString("SpeakerManager: index %d already added, ignored", spkrIdxes[i]));
+            logger->logFormat(LogLevel::WARNING,
+                              "SpeakerManager: index %d already added, ignored",
+                              spkrIdxes[i]);
         }
         else {
             actvSpkIdx.push_back(spkrIdxes[i]);
@@ -579,8 +581,9 @@ void SpeakerManager::_addActiveSpeakerIndexs(Indexes spkrIdxes)
         }
         // add to actvSpkIdx
         if (isInVec<Index>(spkrIdxes[i], actvSpkIdx)) {
-            logger->logWarning(
-                formatString("SpeakerManager: index %d already added, ignored", spkrIdxes[i]));
+            logger->logFormat(LogLevel::WARNING,
+                              "SpeakerManager: index %d already added, ignored",
+                              spkrIdxes[i]);
         }
         else {
             actvSpkIdx.push_back(spkrIdxes[i]);
@@ -598,8 +601,9 @@ void SpeakerManager::_delActiveSpeakerIndexs(Indexes spkrIdxes)
         }
         // remove from actvSpkIdx
         if (!isInVec<Index>(spkrIdxes[i], actvSpkIdx)) {
-            logger->logWarning(
-                formatString("SpeakerManager index %d already removed, ignored", spkrIdxes[i]));
+            logger->logFormat(LogLevel::WARNING,
+                              "SpeakerManager index %d already removed, ignored",
+                              spkrIdxes[i]);
         }
         else {
             actvSpkIdx.erase(std::remove(actvSpkIdx.begin(), actvSpkIdx.end(), spkrIdxes[i]),
@@ -607,8 +611,9 @@ void SpeakerManager::_delActiveSpeakerIndexs(Indexes spkrIdxes)
         }
         // remove from trajVector
         if (!isInVec<Index>(spkrIdxes[i], trajVector)) {
-            logger->logWarning(
-                formatString("SpeakerManager index %d already removed, ignored", spkrIdxes[i]));
+            logger->logFormat(LogLevel::WARNING,
+                              "SpeakerManager index %d already removed, ignored",
+                              spkrIdxes[i]);
         }
         else {
             trajVector.erase(std::remove(trajVector.begin(), trajVector.end(), spkrIdxes[i]),
@@ -0,0 +1,338 @@
+/**
+ * @file featurebus.cpp
+ * @author Zeyu Yang (zeyuuyang42@gmail.com)
+ * @brief Named shared-memory bus carrying the latest feature frames to other objects and processes
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2023-2026
+ */
+#include "featurebus.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <dirent.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define ZERR_FEATURE_BUS_SHM
+#endif
+
+using namespace zerr;
+
+namespace {
+
+constexpr const char* SHM_PREFIX = "zerr.";
+constexpr size_t ALIGN           = 64;
+
+size_t round_up(size_t n, size_t alignment)
+{
+    return (n + alignment - 1) / alignment * alignment;
+}
+
+/**
+ * @brief Name of the shared memory object of a bus, throws if the bus name is unusable
+ */
+std::string shm_name_of(const std::string& name)
+{
+    if (name.empty() || name.size() > 200 || name.find('/') != std::string::npos) {
+        throw std::runtime_error("|" + name + "| is not a valid feature bus name");
+    }
+    return "/" + std::string(SHM_PREFIX) + name;
+}
+
+#ifdef ZERR_FEATURE_BUS_SHM
+/**
+ * @brief Whether an existing bus was left behind, i.e. its writer is gone
+ */
+bool is_stale(const std::string& shm_name)
+{
+    int fd = shm_open(shm_name.c_str(), O_RDONLY, 0);
+    if (fd < 0) {
+        return true;
+    }
+    struct stat st;
+    bool stale = true;
+    if (fstat(fd, &st) == 0 && (size_t)st.st_size >= sizeof(FeatureBusHeader)) {
+        void* map = mmap(nullptr, sizeof(FeatureBusHeader), PROT_READ, MAP_SHARED, fd, 0);
+        if (map != MAP_FAILED) {
+            const auto* header = static_cast<const FeatureBusHeader*>(map);
+            stale = std::memcmp(header->magic, FEATURE_BUS_MAGIC, sizeof(header->magic)) != 0 ||
+                    header->closed.load(std::memory_order_acquire) != 0 ||
+                    (kill((pid_t)header->writer_pid, 0) != 0 && errno == ESRCH);
+            munmap(map, sizeof(FeatureBusHeader));
+        }
+    }
+    close(fd);
+    return stale;
+}
+#endif
+
+} // namespace
+
+FeatureBusWriter::FeatureBusWriter(const std::string& name, const FeatureNames& feature_names,
+                                   SystemConfigs system_configs, size_t capacity)
+    : name(name)
+    , shm_name(shm_name_of(name))
+    , n_features(feature_names.size())
+{
+#ifdef ZERR_FEATURE_BUS_SHM
+    size_t n_slots = 2;
+    while (n_slots < capacity) {
+        n_slots *= 2;
+    }
+    const size_t slot_offset =
+        round_up(sizeof(FeatureBusHeader) + n_features * FEATURE_BUS_NAME_SIZE, ALIGN);
+    const size_t slot_size = round_up(sizeof(FeatureBusSlot) + n_features * sizeof(float), ALIGN);
+    size                   = slot_offset + n_slots * slot_size;
+
+    int fd = shm_open(shm_name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+    if (fd < 0 && errno == EEXIST && is_stale(shm_name)) {
+        // the writer of the old bus crashed, its readers keep their mapping
+        shm_unlink(shm_name.c_str());
+        fd = shm_open(shm_name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+    }
+    if (fd < 0) {
+        throw std::runtime_error(errno == EEXIST
+                                     ? "feature bus |" + name + "| is already published"
+                                     : "cannot create feature bus |" + name + "|");
+    }
+    if (ftruncate(fd, (off_t)size) != 0) {
+        close(fd);
+        shm_unlink(shm_name.c_str());
+        throw std::runtime_error("cannot allocate feature bus |" + name + "|");
+    }
+    memory = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (memory == MAP_FAILED) {
+        memory = nullptr;
+        shm_unlink(shm_name.c_str());
+        throw std::runtime_error("cannot map feature bus |" + name + "|");
+    }
+
+    // the new object is zero-filled, so all slots start out empty
+    header              = new (memory) FeatureBusHeader{};
+    header->version     = FEATURE_BUS_VERSION;
+    header->n_features  = (uint32_t)n_features;
+    header->capacity    = (uint32_t)n_slots;
+    header->slot_size   = (uint32_t)slot_size;
+    header->name_size   = FEATURE_BUS_NAME_SIZE;
+    header->block_size  = (uint32_t)system_configs.block_size;
+    header->sample_rate = (double)system_configs.sample_rate;
+    header->slot_offset = slot_offset;
+    header->writer_pid  = (uint32_t)getpid();
+
+    char* names = static_cast<char*>(memory) + sizeof(FeatureBusHeader);
+    for (size_t i = 0; i < n_features; ++i) {
+        std::strncpy(names + i * FEATURE_BUS_NAME_SIZE, feature_names[i].c_str(),
+                     FEATURE_BUS_NAME_SIZE - 1);
+    }
+    for (size_t i = 0; i < n_slots; ++i) {
+        new (static_cast<char*>(memory) + slot_offset + i * slot_size) FeatureBusSlot{};
+    }
+
+    // readers accept the bus once the magic is there
+    std::atomic_thread_fence(std::memory_order_release);
+    std::memcpy(header->magic, FEATURE_BUS_MAGIC, sizeof(header->magic));
+#else
+    (void)system_configs;
+    (void)capacity;
+    throw std::runtime_error("feature buses need POSIX shared memory");
+#endif
+}
+
+FeatureBusWriter::~FeatureBusWriter()
+{
+#ifdef ZERR_FEATURE_BUS_SHM
+    if (memory) {
+        header->closed.store(1, std::memory_order_release);
+        munmap(memory, size);
+        shm_unlink(shm_name.c_str());
+    }
+#endif
+}
+
+float* FeatureBusWriter::_begin_frame()
+{
+    char* base = static_cast<char*>(memory) + header->slot_offset;
+    auto* slot = reinterpret_cast<FeatureBusSlot*>(
+        base + (frame & (header->capacity - 1)) * header->slot_size);
+
+    // readers skip the slot while the sequence is odd or belongs to another frame
+    slot->sequence.store(2 * frame + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    slot->frame   = frame;
+    slot->time_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                        std::chrono::steady_clock::now().time_since_epoch())
+                        .count();
+    return reinterpret_cast<float*>(slot + 1);
+}
+
+void FeatureBusWriter::_end_frame()
+{
+    char* base = static_cast<char*>(memory) + header->slot_offset;
+    auto* slot = reinterpret_cast<FeatureBusSlot*>(
+        base + (frame & (header->capacity - 1)) * header->slot_size);
+
+    slot->sequence.store(2 * frame + 2, std::memory_order_release);
+    header->published.store(++frame, std::memory_order_release);
+}
+
+void FeatureBusWriter::publish(const FeaturesVals& y)
+{
+    float* values = _begin_frame();
+    for (size_t i = 0; i < n_features; ++i) {
+        values[i] = i < y.size() && !y[i].empty() ? (float)y[i].back() : 0.0f;
+    }
+    _end_frame();
+}
+
+void FeatureBusWriter::publish(const float* values)
+{
+    std::memcpy(_begin_frame(), values, n_features * sizeof(float));
+    _end_frame();
+}
+
+FeatureBusReader::FeatureBusReader(const std::string& name)
+    : name(name)
+{
+#ifdef ZERR_FEATURE_BUS_SHM
+    const std::string shm_name = shm_name_of(name);
+    int fd                     = shm_open(shm_name.c_str(), O_RDONLY, 0);
+    if (fd < 0) {
+        throw std::runtime_error("feature bus |" + name + "| does not exist");
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(FeatureBusHeader)) {
+        close(fd);
+        throw std::runtime_error("|" + name + "| is not a feature bus");
+    }
+    size   = (size_t)st.st_size;
+    inode  = (uint64_t)st.st_ino;
+    memory = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (memory == MAP_FAILED) {
+        memory = nullptr;
+        throw std::runtime_error("cannot map feature bus |" + name + "|");
+    }
+    header = static_cast<const FeatureBusHeader*>(memory);
+
+    const bool valid =
+        std::memcmp(header->magic, FEATURE_BUS_MAGIC, sizeof(header->magic)) == 0 &&
+        header->version == FEATURE_BUS_VERSION && header->name_size == FEATURE_BUS_NAME_SIZE &&
+        header->capacity > 0 && (header->capacity & (header->capacity - 1)) == 0 &&
+        header->slot_size >= sizeof(FeatureBusSlot) + header->n_features * sizeof(float) &&
+        header->slot_offset >=
+            sizeof(FeatureBusHeader) + (uint64_t)header->n_features * FEATURE_BUS_NAME_SIZE &&
+        header->slot_offset + (uint64_t)header->capacity * header->slot_size <= size;
+    if (!valid) {
+        munmap(const_cast<void*>(memory), size);
+        throw std::runtime_error("|" + name + "| is not a feature bus of version " +
+                                 std::to_string(FEATURE_BUS_VERSION));
+    }
+    std::atomic_thread_fence(std::memory_order_acquire);
+
+    const char* names = static_cast<const char*>(memory) + sizeof(FeatureBusHeader);
+    for (uint32_t i = 0; i < header->n_features; ++i) {
+        const char* feature = names + i * FEATURE_BUS_NAME_SIZE;
+        feature_names.emplace_back(feature, strnlen(feature, FEATURE_BUS_NAME_SIZE));
+    }
+#else
+    throw std::runtime_error("feature buses need POSIX shared memory");
+#endif
+}
+
+FeatureBusReader::~FeatureBusReader()
+{
+#ifdef ZERR_FEATURE_BUS_SHM
+    if (memory) {
+        munmap(const_cast<void*>(memory), size);
+    }
+#endif
+}
+
+bool FeatureBusReader::is_replaced() const
+{
+#ifdef ZERR_FEATURE_BUS_SHM
+    int fd = shm_open(shm_name_of(name).c_str(), O_RDONLY, 0);
+    if (fd < 0) {
+        return true;
+    }
+    struct stat st;
+    const bool replaced = fstat(fd, &st) != 0 || (uint64_t)st.st_ino != inode;
+    close(fd);
+    return replaced;
+#else
+    return true;
+#endif
+}
+
+int FeatureBusReader::find(const std::string& feature) const
+{
+    auto it = std::find(feature_names.begin(), feature_names.end(), feature);
+    return it == feature_names.end() ? -1 : (int)(it - feature_names.begin());
+}
+
+bool FeatureBusReader::read(uint64_t frame, FeatureFrame& out) const
+{
+    const uint64_t published = get_published();
+    if (frame >= published || published - frame > header->capacity) {
+        return false;
+    }
+
+    // copy the slot and keep it only if the writer did not touch it meanwhile
+    const FeatureBusSlot* slot = _slot(frame);
+    const uint64_t sequence    = slot->sequence.load(std::memory_order_acquire);
+    if (sequence != 2 * frame + 2) {
+        return false;
+    }
+    out.values.resize(feature_names.size());
+    std::memcpy(out.values.data(), slot + 1, feature_names.size() * sizeof(float));
+    out.time_ns = slot->time_ns;
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (slot->sequence.load(std::memory_order_relaxed) != sequence) {
+        return false;
+    }
+    out.frame = frame;
+    return true;
+}
+
+bool FeatureBusReader::read_latest(FeatureFrame& out) const
+{
+    // a torn read means a newer frame is complete, which the next attempt finds
+    for (int attempt = 0; attempt < 4; ++attempt) {
+        const uint64_t published = get_published();
+        if (published == 0) {
+            return false;
+        }
+        if (read(published - 1, out)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+FeatureNames zerr::list_feature_buses()
+{
+    FeatureNames names;
+#if defined(ZERR_FEATURE_BUS_SHM) && defined(__linux__)
+    if (DIR* dir = opendir("/dev/shm")) {
+        const size_t prefix = std::strlen(SHM_PREFIX);
+        while (dirent* entry = readdir(dir)) {
+            if (std::strncmp(entry->d_name, SHM_PREFIX, prefix) == 0) {
+                names.emplace_back(entry->d_name + prefix);
+            }
+        }
+        closedir(dir);
+    }
+    std::sort(names.begin(), names.end());
+#endif
+    return names;
+}
@@ -0,0 +1,155 @@
+/**
+ * @file fftwbackend.cpp
+ * @author Zeyu Yang (zeyuuyang42@gmail.com)
+ * @brief FFTBackend on top of FFTW3
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2023-2026
+ */
+#include <fftw3.h>
+
+#include <mutex>
+#include <type_traits>
+
+#include "fftbackend.h"
+
+using namespace zerr;
+
+namespace {
+
+// only the execution of a plan is thread-safe in FFTW, planning and destroying are serialised
+// so that banks can be built on several threads at once
+std::mutex planner_mutex;
+
+// overloads selecting the fftw_ or fftwf_ interface by the sample type
+
+fftw_plan plan_forward(int n, int howmany, double* in, double* out)
+{
+    if (howmany == 1)
+        return fftw_plan_dft_r2c_1d(n, in, (fftw_complex*)out, FFTW_ESTIMATE);
+    // one batched plan over all frames, frames and spectra are stored contiguously
+    return fftw_plan_many_dft_r2c(1, &n, howmany, in, NULL, 1, n, (fftw_complex*)out, NULL, 1,
+                                  n / 2 + 1, FFTW_ESTIMATE);
+}
+
+fftw_plan plan_inverse(int n, int howmany, double* in, double* out)
+{
+    if (howmany == 1)
+        return fftw_plan_dft_c2r_1d(n, (fftw_complex*)out, in, FFTW_ESTIMATE);
+    return fftw_plan_many_dft_c2r(1, &n, howmany, (fftw_complex*)out, NULL, 1, n / 2 + 1, in,
+                                  NULL, 1, n, FFTW_ESTIMATE);
+}
+
+void allocate(double*& ptr, int n) { ptr = (double*)fftw_malloc(sizeof(double) * n); }
+
+void release(double* ptr) { fftw_free(ptr); }
+
+void run(fftw_plan p) { fftw_execute(p); }
+
+void destroy(fftw_plan p) { fftw_destroy_plan(p); }
+
+#ifdef ZERR_CORE_FFT_FLOAT
+fftwf_plan plan_forward(int n, int howmany, float* in, float* out)
+{
+    if (howmany == 1)
+        return fftwf_plan_dft_r2c_1d(n, in, (fftwf_complex*)out, FFTW_ESTIMATE);
+    return fftwf_plan_many_dft_r2c(1, &n, howmany, in, NULL, 1, n, (fftwf_complex*)out, NULL, 1,
+                                   n / 2 + 1, FFTW_ESTIMATE);
+}
+
+fftwf_plan plan_inverse(int n, int howmany, float* in, float* out)
+{
+    if (howmany == 1)
+        return fftwf_plan_dft_c2r_1d(n, (fftwf_complex*)out, in, FFTW_ESTIMATE);
+    return fftwf_plan_many_dft_c2r(1, &n, howmany, (fftwf_complex*)out, NULL, 1, n / 2 + 1, in,
+                                   NULL, 1, n, FFTW_ESTIMATE);
+}
+
+void allocate(float*& ptr, int n) { ptr = (float*)fftwf_malloc(sizeof(float) * n); }
+
+void release(float* ptr) { fftwf_free(ptr); }
+
+void run(fftwf_plan p) { fftwf_execute(p); }
+
+void destroy(fftwf_plan p) { fftwf_destroy_plan(p); }
+#endif
+
+} // namespace
+
+template <typename T>
+struct FFTBackend<T>::Plan {
+    using plan_t = decltype(plan_forward(0, 0, (T*)nullptr, (T*)nullptr));
+
+    int frame_size;
+    int n_frames;
+    plan_t p_fft;
+    plan_t p_ifft;
+};
+
+template <typename T>
+FFTBackend<T>::FFTBackend(int frame_size, int n_frames) : plan(new Plan)
+{
+    const int n_in  = frame_size * n_frames;
+    const int n_out = (frame_size / 2 + 1) * 2 * n_frames;
+
+    allocate(in, n_in);
+    allocate(out, n_out);
+    for (int i = 0; i < n_in; i++)
+        in[i] = 0;
+    for (int i = 0; i < n_out; i++)
+        out[i] = 0;
+
+    std::lock_guard<std::mutex> lock(planner_mutex);
+    plan->frame_size = frame_size;
+    plan->n_frames   = n_frames;
+    plan->p_fft      = plan_forward(frame_size, n_frames, in, out);
+    plan->p_ifft     = NULL;
+}
+
+template <typename T>
+FFTBackend<T>::~FFTBackend()
+{
+    {
+        std::lock_guard<std::mutex> lock(planner_mutex);
+        destroy(plan->p_fft);
+        if (plan->p_ifft)
+            destroy(plan->p_ifft);
+    }
+    release(in);
+    release(out);
+    delete plan;
+}
+
+template <typename T>
+void FFTBackend<T>::forward()
+{
+    run(plan->p_fft);
+}
+
+template <typename T>
+void FFTBackend<T>::inverse()
+{
+    if (!plan->p_ifft) {
+        std::lock_guard<std::mutex> lock(planner_mutex);
+        plan->p_ifft = plan_inverse(plan->frame_size, plan->n_frames, in, out);
+    }
+    run(plan->p_ifft);
+}
+
+template <typename T>
+const char* FFTBackend<T>::name()
+{
+    return "FFTW";
+}
+
+template <typename T>
+bool FFTBackend<T>::computes_in_float()
+{
+    // fftw for double, fftwf for float
+    return std::is_same<T, float>::value;
+}
+
+template class zerr::FFTBackend<double>;
+#ifdef ZERR_CORE_FFT_FLOAT
+template class zerr::FFTBackend<float>;
+#endif
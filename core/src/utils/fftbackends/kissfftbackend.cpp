@@ -0,0 +1,130 @@
+/**
+ * @file kissfftbackend.cpp
+ * @author Zeyu Yang (zeyuuyang42@gmail.com)
+ * @brief FFTBackend on top of KissFFT
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2023-2026
+ */
+#include <kiss_fftr.h>
+
+#include <cstdlib>
+#include <stdexcept>
+#include <type_traits>
+
+#include "fftbackend.h"
+
+using namespace zerr;
+
+/**
+ * KissFFT computes one frame per call in the precision it was built with (kiss_fft_scalar).
+ * Frames of another sample type are converted around the transform.
+ */
+template <typename T>
+struct FFTBackend<T>::Plan {
+    int frame_size;
+    int n_frames;
+    kiss_fftr_cfg cfg_fft;
+    kiss_fftr_cfg cfg_ifft;
+    kiss_fft_scalar* frame;  ///< Frame in the KissFFT precision
+    kiss_fft_cpx* spectrum; ///< Spectrum in the KissFFT precision
+};
+
+template <typename T>
+FFTBackend<T>::FFTBackend(int frame_size, int n_frames) : plan(new Plan)
+{
+    if (frame_size % 2 != 0) {
+        delete plan;
+        throw std::runtime_error("KissFFT real transforms need an even frame size");
+    }
+
+    plan->frame_size = frame_size;
+    plan->n_frames   = n_frames;
+    plan->cfg_fft    = kiss_fftr_alloc(frame_size, 0, NULL, NULL);
+    plan->cfg_ifft   = NULL;
+    plan->frame      = (kiss_fft_scalar*)malloc(sizeof(kiss_fft_scalar) * frame_size);
+    plan->spectrum   = (kiss_fft_cpx*)malloc(sizeof(kiss_fft_cpx) * (frame_size / 2 + 1));
+
+    const int n_in  = frame_size * n_frames;
+    const int n_out = (frame_size / 2 + 1) * 2 * n_frames;
+    in              = new T[n_in]();
+    out             = new T[n_out]();
+}
+
+template <typename T>
+FFTBackend<T>::~FFTBackend()
+{
+    kiss_fftr_free(plan->cfg_fft);
+    if (plan->cfg_ifft)
+        kiss_fftr_free(plan->cfg_ifft);
+    free(plan->frame);
+    free(plan->spectrum);
+    delete[] in;
+    delete[] out;
+    delete plan;
+}
+
+template <typename T>
+void FFTBackend<T>::forward()
+{
+    const int n      = plan->frame_size;
+    const int n_bins = n / 2 + 1;
+    constexpr bool is_native = std::is_same<T, kiss_fft_scalar>::value;
+
+    for (int f = 0; f < plan->n_frames; f++) {
+        T* frame_in = in + f * n;
+        T* spectrum = out + f * n_bins * 2;
+
+        if constexpr (is_native) {
+            // kiss_fft_cpx is a pair of scalars, so it maps onto the interleaved layout
+            kiss_fftr(plan->cfg_fft, (const kiss_fft_scalar*)frame_in, (kiss_fft_cpx*)spectrum);
+        }
+        else {
+            for (int i = 0; i < n; i++)
+                plan->frame[i] = (kiss_fft_scalar)frame_in[i];
+            kiss_fftr(plan->cfg_fft, plan->frame, plan->spectrum);
+            for (int k = 0; k < n_bins; k++) {
+                spectrum[2 * k]     = plan->spectrum[k].r;
+                spectrum[2 * k + 1] = plan->spectrum[k].i;
+            }
+        }
+    }
+}
+
+template <typename T>
+void FFTBackend<T>::inverse()
+{
+    if (!plan->cfg_ifft)
+        plan->cfg_ifft = kiss_fftr_alloc(plan->frame_size, 1, NULL, NULL);
+
+    const int n      = plan->frame_size;
+    const int n_bins = n / 2 + 1;
+
+    for (int f = 0; f < plan->n_frames; f++) {
+        T* frame_out = in + f * n;
+        T* spectrum  = out + f * n_bins * 2;
+
+        for (int k = 0; k < n_bins; k++) {
+            plan->spectrum[k].r = (kiss_fft_scalar)spectrum[2 * k];
+            plan->spectrum[k].i = (kiss_fft_scalar)spectrum[2 * k + 1];
+        }
+        kiss_fftri(plan->cfg_ifft, plan->spectrum, plan->frame);
+        for (int i = 0; i < n; i++)
+            frame_out[i] = plan->frame[i];
+    }
+}
+
+template <typename T>
+const char* FFTBackend<T>::name()
+{
+    return "KissFFT";
+}
+
+template <typename T>
+bool FFTBackend<T>::computes_in_float()
+{
+    return !std::is_same<kiss_fft_scalar, double>::value;
+}
+
+template class zerr::FFTBackend<double>;
+template class zerr::FFTBackend<float>;
@@ -0,0 +1,148 @@
+/**
+ * @file pffftbackend.cpp
+ * @author Zeyu Yang (zeyuuyang42@gmail.com)
+ * @brief FFTBackend on top of PFFFT
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2023-2026
+ */
+#include <pffft.h>
+
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+#include "fftbackend.h"
+
+using namespace zerr;
+
+/**
+ * PFFFT works in single precision on frames which are a multiple of 32 samples. The double
+ * variant converts to float around the transform. The ordered real spectrum of PFFFT packs
+ * the Nyquist bin into the imaginary part of the DC bin, so it is unpacked into the
+ * frame_size / 2 + 1 bins of the FFTW layout after each transform.
+ */
+template <typename T>
+struct FFTBackend<T>::Plan {
+    int frame_size;
+    int n_frames;
+    PFFFT_Setup* setup;
+    float* frame;  ///< Aligned real frame
+    float* packed; ///< Aligned packed spectrum
+    float* work;   ///< Aligned work area
+};
+
+namespace {
+
+float* allocate_floats(int n) { return (float*)pffft_aligned_malloc(sizeof(float) * n); }
+
+} // namespace
+
+template <typename T>
+FFTBackend<T>::FFTBackend(int frame_size, int n_frames) : plan(new Plan)
+{
+    plan->frame_size = frame_size;
+    plan->n_frames   = n_frames;
+    plan->setup      = pffft_new_setup(frame_size, PFFFT_REAL);
+    if (!plan->setup) {
+        delete plan;
+        throw std::runtime_error("PFFFT does not support a frame size of " +
+                                 std::to_string(frame_size) + ", use a multiple of 32 samples");
+    }
+
+    plan->frame  = allocate_floats(frame_size);
+    plan->packed = allocate_floats(frame_size);
+    plan->work   = allocate_floats(frame_size);
+
+    const int n_in  = frame_size * n_frames;
+    const int n_out = (frame_size / 2 + 1) * 2 * n_frames;
+    in              = (T*)pffft_aligned_malloc(sizeof(T) * n_in);
+    out             = (T*)pffft_aligned_malloc(sizeof(T) * n_out);
+    for (int i = 0; i < n_in; i++)
+        in[i] = 0;
+    for (int i = 0; i < n_out; i++)
+        out[i] = 0;
+}
+
+template <typename T>
+FFTBackend<T>::~FFTBackend()
+{
+    pffft_destroy_setup(plan->setup);
+    pffft_aligned_free(plan->frame);
+    pffft_aligned_free(plan->packed);
+    pffft_aligned_free(plan->work);
+    pffft_aligned_free(in);
+    pffft_aligned_free(out);
+    delete plan;
+}
+
+template <typename T>
+void FFTBackend<T>::forward()
+{
+    const int n      = plan->frame_size;
+    const int n_bins = n / 2 + 1;
+
+    for (int f = 0; f < plan->n_frames; f++) {
+        const T* frame_in = in + f * n;
+        T* spectrum       = out + f * n_bins * 2;
+
+        // float frames are transformed in place, double frames through the float buffer
+        const float* src = nullptr;
+        if constexpr (std::is_same<T, float>::value) {
+            src = frame_in;
+        }
+        else {
+            for (int i = 0; i < n; i++)
+                plan->frame[i] = (float)frame_in[i];
+            src = plan->frame;
+        }
+
+        pffft_transform_ordered(plan->setup, src, plan->packed, plan->work, PFFFT_FORWARD);
+
+        // DC and Nyquist are real, PFFFT stores them in the first two values
+        spectrum[0]                    = plan->packed[0];
+        spectrum[1]                    = 0;
+        spectrum[2 * (n_bins - 1)]     = plan->packed[1];
+        spectrum[2 * (n_bins - 1) + 1] = 0;
+        for (int i = 2; i < n; i++)
+            spectrum[i] = plan->packed[i];
+    }
+}
+
+template <typename T>
+void FFTBackend<T>::inverse()
+{
+    const int n      = plan->frame_size;
+    const int n_bins = n / 2 + 1;
+
+    for (int f = 0; f < plan->n_frames; f++) {
+        T* frame_out      = in + f * n;
+        const T* spectrum = out + f * n_bins * 2;
+
+        plan->packed[0] = (float)spectrum[0];
+        plan->packed[1] = (float)spectrum[2 * (n_bins - 1)];
+        for (int i = 2; i < n; i++)
+            plan->packed[i] = (float)spectrum[i];
+
+        pffft_transform_ordered(plan->setup, plan->packed, plan->frame, plan->work,
+                                PFFFT_BACKWARD);
+
+        for (int i = 0; i < n; i++)
+            frame_out[i] = plan->frame[i];
+    }
+}
+
+template <typename T>
+const char* FFTBackend<T>::name()
+{
+    return "PFFFT";
+}
+
+template <typename T>
+bool FFTBackend<T>::computes_in_float()
+{
+    return true;
+}
+
+template class zerr::FFTBackend<double>;
+template class zerr::FFTBackend<float>;
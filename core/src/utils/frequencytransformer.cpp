@@ -1,42 +1,214 @@
 #include "frequencytransformer.h"
+
+#include <algorithm>
+#include <cmath>
 using namespace zerr;
 
-FrequencyTransformer::FrequencyTransformer(int L) {
+template <typename T>
+BasicFrequencyTransformer<T>::BasicFrequencyTransformer(int L, int n_channels, SpectrumMode mode)
+    : backend(L, n_channels) {
     frame_size = L;
     fft_size = (L / 2 + 1);
+    this->n_channels = n_channels;
+    this->mode = mode == SpectrumMode::SLIDING_DFT ? mode : SpectrumMode::FFT;
+
+    power_scale = (T)(1.0 / (2.0 * (double)fft_size));
+
+    fft_in = backend.input();
+    fft_out = (complex*)backend.output();
 
-    fft_in = new double[frame_size];
+    power_spec.resize(fft_size * n_channels);
+
+    window.resize(frame_size);
     for (int i = 0; i < frame_size; i++) {
-        fft_in[i] = 0;
+        window[i] = get_hann_sample(i, frame_size);
     }
 
-    fft_out = new fftw_complex[fft_size];
+    if (mode == SpectrumMode::SLIDING_DFT) {
+        // a damping slightly below 1 keeps the recursion stable against rounding of the twiddles
+        const double damping = 1.0 - 1e-12;
+        damping_n = std::pow(damping, frame_size);
 
-    power_spec.resize(fft_size);
+        twiddle_re.resize(fft_size);
+        twiddle_im.resize(fft_size);
+        for (int k = 0; k < fft_size; k++) {
+            twiddle_re[k] = damping * std::cos(2.0 * PI * k / frame_size);
+            twiddle_im[k] = damping * std::sin(2.0 * PI * k / frame_size);
+        }
 
-    p_fft = fftw_plan_dft_r2c_1d(frame_size, fft_in, fft_out, FFTW_ESTIMATE);
-    p_ifft = fftw_plan_dft_c2r_1d(frame_size, fft_out, fft_in, FFTW_ESTIMATE);
+        set_bin_range(0, fft_size - 1);
+    }
 }
 
-void FrequencyTransformer::fft() { fftw_execute(p_fft); }
+template <typename T>
+BasicFrequencyTransformer<T>::~BasicFrequencyTransformer() = default;
+
+template <typename T>
+void BasicFrequencyTransformer<T>::fft() {
+    if (mode == SpectrumMode::FFT) {
+        backend.forward();
+        return;
+    }
 
-void FrequencyTransformer::ifft() { fftw_execute(p_ifft); }
+    // Hann window as convolution with [-1/4, 1/2, -1/4], mirroring the bins at both ends
+    for (int ch = 0; ch < n_channels; ch++) {
+        const double* re = slide_re.data() + ch * fft_size;
+        const double* im = slide_im.data() + ch * fft_size;
+        complex* out = fft_out + ch * fft_size;
 
-void FrequencyTransformer::power_spectrum() {
-    for (int i = 0; i < fft_size; i++) {
-        power_spec[i] =
-            (1.0 / (2.0 * (float)fft_size)) *
-            (fft_out[i][0] * fft_out[i][0] + fft_out[i][1] * fft_out[i][1]);
+        for (int k = 0; k < fft_size; k++) {
+            if (k < bin_first || k > bin_last) {
+                out[k][0] = 0.0;
+                out[k][1] = 0.0;
+                continue;
+            }
+            int below = k > 0 ? k - 1 : 1;
+            int above = k < fft_size - 1 ? k + 1 : frame_size - k - 1;
+            double im_below = k > 0 ? im[below] : -im[below];
+            double im_above = k < fft_size - 1 ? im[above] : -im[above];
+            out[k][0] = 0.5 * re[k] - 0.25 * (re[below] + re[above]);
+            out[k][1] = 0.5 * im[k] - 0.25 * (im_below + im_above);
+        }
+    }
+}
+
+template <typename T>
+void BasicFrequencyTransformer<T>::slide(const Sample* in, int n, int channel) {
+    if (mode != SpectrumMode::SLIDING_DFT)
+        return;
+
+    // the window needs the neighbours of the requested bins
+    const int lo = std::max(bin_first - 1, 0);
+    const int hi = std::min(bin_last + 1, fft_size - 1);
+
+    double* history = slide_history.data() + channel * frame_size;
+    double* re = slide_re.data() + channel * fft_size;
+    double* im = slide_im.data() + channel * fft_size;
+    int& pos = slide_pos[channel];
+
+    for (int i = 0; i < n; i++) {
+        double delta = in[i] - damping_n * history[pos];
+        history[pos] = in[i];
+        pos = pos + 1 < frame_size ? pos + 1 : 0;
+
+        for (int k = lo; k <= hi; k++) {
+            double a = re[k] + delta;
+            double b = im[k];
+            re[k] = a * twiddle_re[k] - b * twiddle_im[k];
+            im[k] = a * twiddle_im[k] + b * twiddle_re[k];
+        }
+    }
+}
+
+template <typename T>
+void BasicFrequencyTransformer<T>::set_bin_range(int first, int last) {
+    bin_first = std::max(first, 0);
+    bin_last = std::min(last, fft_size - 1);
+
+    slide_history.assign(frame_size * n_channels, 0.0);
+    slide_re.assign(fft_size * n_channels, 0.0);
+    slide_im.assign(fft_size * n_channels, 0.0);
+    slide_pos.assign(n_channels, 0);
+}
+
+template <typename T>
+void BasicFrequencyTransformer<T>::clear_slide(int channel) {
+    if (mode != SpectrumMode::SLIDING_DFT)
+        return;
+
+    std::fill_n(slide_history.begin() + channel * frame_size, frame_size, 0.0);
+    std::fill_n(slide_re.begin() + channel * fft_size, fft_size, 0.0);
+    std::fill_n(slide_im.begin() + channel * fft_size, fft_size, 0.0);
+    slide_pos[channel] = 0;
+}
+
+template <typename T>
+void BasicFrequencyTransformer<T>::ifft() {
+    backend.inverse();
+}
+
+template <typename T>
+void BasicFrequencyTransformer<T>::power_spectrum() {
+    // treat the interleaved output as a flat array, which lets the loop vectorise
+    const T* out = (const T*)fft_out;
+    T* power = power_spec.data();
+    const T scale = power_scale;
+    const int n = fft_size * n_channels;
+    for (int i = 0; i < n; i++) {
+        T re = out[2 * i];
+        T im = out[2 * i + 1];
+        power[i] = scale * (re * re + im * im);
+    }
+}
+
+template <typename T>
+void BasicFrequencyTransformer<T>::windowing() {
+    if (mode == SpectrumMode::SLIDING_DFT)
+        return;
+
+    const T* w = window.data();
+    for (int ch = 0; ch < n_channels; ch++) {
+        T* in = fft_in + ch * frame_size;
+        for (int i = 0; i < frame_size; i++)
+            in[i] *= w[i];
     }
 }
 
-void FrequencyTransformer::windowing() {
-    for (int i = 0; i < frame_size; i++)
-        fft_in[i] = fft_in[i] * get_hann_sample(i, frame_size);
+template <typename T>
+T* BasicFrequencyTransformer<T>::fft_input(int channel) {
+    return fft_in + channel * frame_size;
+}
+
+template <typename T>
+typename BasicFrequencyTransformer<T>::complex* BasicFrequencyTransformer<T>::fft_output(
+    int channel) {
+    return fft_out + channel * fft_size;
 }
 
-double* FrequencyTransformer::fft_input() { return fft_in; }
+template <typename T>
+typename BasicFrequencyTransformer<T>::Buffer BasicFrequencyTransformer<T>::get_power_spectrum() {
+    return Buffer(power_spec.begin(), power_spec.begin() + fft_size);
+}
+
+template <typename T>
+void BasicFrequencyTransformer<T>::get_power_spectrum(Buffer& spectrum, int channel) {
+    auto begin = power_spec.begin() + channel * fft_size;
+    spectrum.assign(begin, begin + fft_size);
+}
 
-fftw_complex* FrequencyTransformer::fft_output() { return fft_out; }
+template <typename T>
+void BasicFrequencyTransformer<T>::get_magnitude_spectrum(Buffer& spectrum, int channel) {
+    const T* out = (const T*)(fft_out + channel * fft_size);
+    spectrum.resize(fft_size);
+    T* magnitude = spectrum.data();
+    for (int i = 0; i < fft_size; i++) {
+        T re = out[2 * i];
+        T im = out[2 * i + 1];
+        magnitude[i] = std::sqrt(re * re + im * im);
+    }
+}
+
+template <typename T>
+void BasicFrequencyTransformer<T>::get_log_power_spectrum(Buffer& spectrum, int channel, T floor) {
+    const T* power = power_spec.data() + channel * fft_size;
+    spectrum.resize(fft_size);
+    T* log_power = spectrum.data();
+    for (int i = 0; i < fft_size; i++) {
+        log_power[i] = (T)10 * std::log10(std::max(power[i], floor));
+    }
+}
+
+template <typename T>
+void BasicFrequencyTransformer<T>::get_complex_spectrum(FFTBuffer& spectrum, int channel) {
+    const complex* out = fft_out + channel * fft_size;
+    spectrum.resize(fft_size);
+    for (int i = 0; i < fft_size; i++) {
+        spectrum[i].real = out[i][0];
+        spectrum[i].img  = out[i][1];
+    }
+}
 
-AudioBuffer FrequencyTransformer::get_power_spectrum() { return power_spec; }
\ No newline at end of file
+template class zerr::BasicFrequencyTransformer<double>;
+#ifdef ZERR_CORE_FFT_FLOAT
+template class zerr::BasicFrequencyTransformer<float>;
+#endif
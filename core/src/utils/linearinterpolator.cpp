@@ -2,16 +2,37 @@
 using namespace zerr;
 
 void LinearInterpolator::set_value(Param start, Param stop, int len) {
-    start_val = start;
-    stop_val = stop;
+    before_val = start_val;
+    start_val  = start;
+    stop_val   = stop;
 
-    n_steps = len;
+    n_steps  = len;
     position = 0;
+
+    if (n_steps <= 1) {
+        // a single step segment only consists of the stop value
+        step_val = 0.0;
+        return;
+    }
+
+    Param inv_span = 1.0 / (Param)(n_steps - 1);
+
+    if (interp_mode == InterpolationMode::CUBIC) {
+        // Catmull-Rom through before, start, stop with the next point extrapolated as
+        // 2 * stop - start, expanded into a polynomial in t = position / (n_steps - 1)
+        coef[0]  = start_val;
+        coef[1]  = 0.5 * (stop_val - before_val);
+        coef[2]  = before_val - 2.0 * start_val + stop_val;
+        coef[3]  = 0.5 * (2.0 * start_val - before_val - stop_val);
+        step_val = inv_span;
+    }
+    else {
+        step_val = (stop_val - start_val) * inv_span;
+    }
 }
 
 Param LinearInterpolator::get_value() {
-    inter_val = start_val + ((Param)position *
-                             ((stop_val - start_val) / (Param)(n_steps - 1)));
+    inter_val = _value_at(position);
 
     return inter_val;
 }
@@ -19,3 +40,37 @@ Param LinearInterpolator::get_value() {
 void LinearInterpolator::next_step() {
     if (position < n_steps) position += 1;
 }
+
+void LinearInterpolator::fill(Param* out, size_t len) {
+    // number of values that lie on the curve, the rest repeats the stop value
+    size_t ramp_len = 0;
+    if (position < n_steps - 1) {
+        ramp_len = std::min(len, (size_t)(n_steps - 1 - position));
+    }
+
+    const Param base = (Param)position;
+
+    switch (interp_mode) {
+    case InterpolationMode::HOLD:
+        ramp_len = 0;
+        break;
+    case InterpolationMode::CUBIC:
+        for (size_t i = 0; i < ramp_len; ++i) {
+            Param t = (base + (Param)i) * step_val;
+            out[i]  = ((coef[3] * t + coef[2]) * t + coef[1]) * t + coef[0];
+        }
+        break;
+    default:
+        for (size_t i = 0; i < ramp_len; ++i) {
+            out[i] = start_val + (base + (Param)i) * step_val;
+        }
+        break;
+    }
+
+    for (size_t i = ramp_len; i < len; ++i) {
+        out[i] = stop_val;
+    }
+
+    position = std::min(position + (int)len, std::max(n_steps, 0));
+    inter_val = len > 0 ? out[len - 1] : inter_val;
+}
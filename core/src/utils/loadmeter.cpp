@@ -0,0 +1,89 @@
+#include "loadmeter.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <vector>
+
+namespace zerr {
+
+void LoadMeter::set_period(SystemConfigs system_configs)
+{
+    double period = system_configs.sample_rate == 0
+                        ? 0.0
+                        : 1e9 * system_configs.block_size / system_configs.sample_rate;
+    period_ns.store(period, std::memory_order_relaxed);
+}
+
+void LoadMeter::record(Clock::time_point start)
+{
+    auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start);
+    uint32_t ns  = (uint32_t)std::min<int64_t>(elapsed.count(), UINT32_MAX);
+
+    if (reset_requested.exchange(false, std::memory_order_relaxed)) {
+        count.store(0, std::memory_order_relaxed);
+        max_ns.store(0, std::memory_order_relaxed);
+    }
+
+    // only this thread writes, so load and store need no read-modify-write
+    uint64_t n = count.load(std::memory_order_relaxed);
+    durations[n % LOAD_METER_WINDOW].store(ns, std::memory_order_relaxed);
+    if (ns > max_ns.load(std::memory_order_relaxed)) {
+        max_ns.store(ns, std::memory_order_relaxed);
+    }
+    count.store(n + 1, std::memory_order_release);
+}
+
+LoadStats LoadMeter::get_stats() const
+{
+    LoadStats stats;
+    stats.blocks = count.load(std::memory_order_acquire);
+    stats.window = (size_t)std::min<uint64_t>(stats.blocks, LOAD_METER_WINDOW);
+    if (stats.window == 0) {
+        return stats;
+    }
+
+    std::vector<uint32_t> window(stats.window);
+    for (size_t i = 0; i < stats.window; ++i) {
+        window[i] = durations[i].load(std::memory_order_relaxed);
+    }
+    std::sort(window.begin(), window.end());
+
+    double sum = 0.0;
+    for (uint32_t ns : window) {
+        sum += ns;
+    }
+    auto percentile = [&](double p) {
+        return window[std::min(window.size() - 1, (size_t)(p * window.size()))] * 1e-3;
+    };
+
+    stats.mean_us = sum / window.size() * 1e-3;
+    stats.p50_us  = percentile(0.50);
+    stats.p95_us  = percentile(0.95);
+    stats.p99_us  = percentile(0.99);
+    stats.max_us  = std::max<double>(max_ns.load(std::memory_order_relaxed), window.back()) * 1e-3;
+
+    double period = period_ns.load(std::memory_order_relaxed);
+    if (period > 0.0) {
+        stats.load = stats.mean_us * 1e3 / period;
+        stats.peak = stats.max_us * 1e3 / period;
+    }
+    return stats;
+}
+
+std::string LoadMeter::report() const
+{
+    if (!is_enabled()) {
+        return "load meter off";
+    }
+    LoadStats stats = get_stats();
+
+    char line[256];
+    std::snprintf(line, sizeof(line),
+                  "%llu blocks, mean %.1f us, p50 %.1f us, p95 %.1f us, p99 %.1f us, "
+                  "max %.1f us, load %.2f%% (peak %.2f%%)",
+                  (unsigned long long)stats.blocks, stats.mean_us, stats.p50_us, stats.p95_us,
+                  stats.p99_us, stats.max_us, 100.0 * stats.load, 100.0 * stats.peak);
+    return line;
+}
+
+} // namespace zerr
@@ -34,8 +34,7 @@ void Logger::logError(const std::string& errorMessage)
     if (logLevel > LogLevel::ERROR)
         return;
 
-    auto logMessage = formatLog_(LogLevel::ERROR, errorMessage);
-    printer_(logMessage);
+    log_(LogLevel::ERROR, errorMessage);
 }
 
 void Logger::logWarning(const std::string& warningMessage)
@@ -43,8 +42,7 @@ void Logger::logWarning(const std::string& warningMessage)
     if (logLevel > LogLevel::WARNING)
         return;
 
-    auto logMessage = formatLog_(LogLevel::WARNING, warningMessage);
-    printer_(logMessage);
+    log_(LogLevel::WARNING, warningMessage);
 }
 
 void Logger::logInfo(const std::string& infoMessage)
@@ -52,8 +50,7 @@ void Logger::logInfo(const std::string& infoMessage)
     if (logLevel > LogLevel::INFO)
         return;
 
-    auto logMessage = formatLog_(LogLevel::INFO, infoMessage);
-    printer_(logMessage);
+    log_(LogLevel::INFO, infoMessage);
 }
 
 void Logger::logDebug(const std::string& debugMessage)
@@ -61,8 +58,62 @@ void Logger::logDebug(const std::string& debugMessage)
     if (logLevel > LogLevel::DEBUG)
         return;
 
-    auto logMessage = formatLog_(LogLevel::DEBUG, debugMessage);
-    printer_(logMessage);
+    log_(LogLevel::DEBUG, debugMessage);
+}
+
+void Logger::setDeferred(bool deferred)
+{
+    if (deferred && !queue_) {
+        queue_ = std::make_unique<LogQueue>(LOG_QUEUE_SIZE);
+    }
+    else if (!deferred && queue_) {
+        flush();
+        queue_.reset();
+    }
+}
+
+void Logger::flush()
+{
+    LogRecord record;
+    while (queue_ && queue_->pop(record)) {
+        printer_(formatLog_(record.level, formatLogRecord(record)));
+    }
+
+    size_t drops    = dropped.load(std::memory_order_relaxed);
+    size_t reported = reportedDrops.load(std::memory_order_relaxed);
+    if (drops != reported) {
+        printer_(formatLog_(LogLevel::WARNING,
+                            std::to_string(drops - reported) +
+                                " log messages dropped, the log queue was full"));
+        reportedDrops.store(drops, std::memory_order_relaxed);
+    }
+}
+
+bool Logger::hasPending() const
+{
+    return (queue_ && !queue_->empty()) ||
+           dropped.load(std::memory_order_relaxed) !=
+               reportedDrops.load(std::memory_order_relaxed);
+}
+
+void Logger::log_(LogLevel level, const std::string& message)
+{
+    if (realtimeThread && queue_) {
+        LogRecord record;
+        record.level = level;
+        record.set_text(message.c_str());
+        enqueue_(record);
+    }
+    else {
+        printer_(formatLog_(level, message));
+    }
+}
+
+void Logger::enqueue_(const LogRecord& record)
+{
+    if (!queue_->push(record)) {
+        dropped.fetch_add(1, std::memory_order_relaxed);
+    }
 }
 
 std::string Logger::formatLog_(LogLevel level, const std::string& message)
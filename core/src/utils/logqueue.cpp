@@ -0,0 +1,139 @@
+#include "logqueue.h"
+
+#include <cstdio>
+
+namespace zerr {
+
+std::string formatLogRecord(const LogRecord& record)
+{
+    if (!record.format) {
+        return std::string(record.text);
+    }
+
+    std::string message;
+    char spec[32];
+    char buffer[256];
+    size_t next = 0;
+
+    for (const char* p = record.format; *p;) {
+        if (*p != '%') {
+            message += *p++;
+            continue;
+        }
+        if (p[1] == '%') {
+            message += '%';
+            p += 2;
+            continue;
+        }
+
+        // copy flags, width and precision, drop the length modifier: the argument type of the
+        // record decides it
+        size_t n  = 0;
+        spec[n++] = *p++;
+        while (*p && std::strchr("-+ #0123456789.", *p) && n < sizeof(spec) - 4) {
+            spec[n++] = *p++;
+        }
+        while (*p && std::strchr("hljztL", *p)) {
+            ++p;
+        }
+        const char conversion = *p ? *p++ : 's';
+        if (next == record.n_args) {
+            continue;
+        }
+        const LogArg& arg = record.args[next++];
+
+        switch (arg.type) {
+        case LogArg::Type::INT:
+        case LogArg::Type::UINT:
+            if (conversion == 'c') {
+                spec[n++] = 'c';
+                spec[n]   = '\0';
+                std::snprintf(buffer, sizeof(buffer), spec, (int)arg.i);
+                break;
+            }
+            spec[n++] = 'l';
+            spec[n++] = 'l';
+            spec[n++] = std::strchr("diouxX", conversion) ? conversion : 'd';
+            spec[n]   = '\0';
+            if (arg.type == LogArg::Type::INT) {
+                std::snprintf(buffer, sizeof(buffer), spec, arg.i);
+            }
+            else {
+                std::snprintf(buffer, sizeof(buffer), spec, arg.u);
+            }
+            break;
+        case LogArg::Type::FLOAT:
+            spec[n++] = std::strchr("fFeEgGaA", conversion) ? conversion : 'g';
+            spec[n]   = '\0';
+            std::snprintf(buffer, sizeof(buffer), spec, arg.f);
+            break;
+        case LogArg::Type::TEXT:
+            spec[n++] = 's';
+            spec[n]   = '\0';
+            std::snprintf(buffer, sizeof(buffer), spec, record.text + arg.offset);
+            break;
+        }
+        message += buffer;
+    }
+    return message;
+}
+
+LogQueue::LogQueue(size_t capacity)
+{
+    size_t size = 2;
+    while (size < capacity) {
+        size <<= 1;
+    }
+    cells.reset(new Cell[size]);
+    mask = size - 1;
+    for (size_t i = 0; i < size; ++i) {
+        cells[i].sequence.store(i, std::memory_order_relaxed);
+    }
+}
+
+bool LogQueue::push(const LogRecord& record)
+{
+    size_t pos = write_pos.load(std::memory_order_relaxed);
+    for (;;) {
+        Cell& cell     = cells[pos & mask];
+        size_t seq     = cell.sequence.load(std::memory_order_acquire);
+        intptr_t delta = (intptr_t)seq - (intptr_t)pos;
+        if (delta == 0) {
+            // the slot is free, claim it unless another producer was faster
+            if (write_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                cell.record = record;
+                cell.sequence.store(pos + 1, std::memory_order_release);
+                return true;
+            }
+        }
+        else if (delta < 0) {
+            return false; // full
+        }
+        else {
+            pos = write_pos.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+bool LogQueue::pop(LogRecord& record)
+{
+    size_t pos = read_pos.load(std::memory_order_relaxed);
+    Cell& cell = cells[pos & mask];
+    size_t seq = cell.sequence.load(std::memory_order_acquire);
+    if ((intptr_t)seq - (intptr_t)(pos + 1) < 0) {
+        return false; // empty, or the producer is still copying
+    }
+    record = cell.record;
+    cell.sequence.store(pos + mask + 1, std::memory_order_release);
+    read_pos.store(pos + 1, std::memory_order_relaxed);
+    return true;
+}
+
+bool LogQueue::empty() const
+{
+    size_t pos = read_pos.load(std::memory_order_relaxed);
+    size_t seq = cells[pos & mask].sequence.load(std::memory_order_acquire);
+    return seq != pos + 1;
+}
+
+} // namespace zerr
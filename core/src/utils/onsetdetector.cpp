@@ -7,6 +7,7 @@
  * @copyright Copyright (c) 2023-2024
  */
 #include "onsetdetector.h"
+#include "utils.h"
 
 using zerr::Block;
 using zerr::Index;
@@ -18,15 +19,15 @@ void OnsetDetector::setDebounceThreshold(int newThreshold)
     lastOnsetPosition = -debounceThreshold; // Reset lastOnsetPosition based on new threshold
 }
 
-void OnsetDetector::detectOnsetInBlock(Block& block)
+void OnsetDetector::detectOnsetInBlock(ChannelView block)
 {
     if (block.empty())
         return;
 
     for (size_t cnt = 0; cnt < block.size(); ++cnt) {
-        if (block[cnt] == 1) {
-            if (cnt - lastOnsetPosition >= debounceThreshold) {
-                lastOnsetPosition = cnt;
+        if (isEqualTo1(block[cnt], TRIGGER_THRESHOLD)) {
+            if (static_cast<int>(cnt) - lastOnsetPosition >= debounceThreshold) {
+                lastOnsetPosition = static_cast<int>(cnt);
             }
             else {
                 block[cnt] = 0;
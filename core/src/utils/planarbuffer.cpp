@@ -0,0 +1,119 @@
+#include "planarbuffer.h"
+
+#include <algorithm>
+#include <cstring>
+#include <new>
+using namespace zerr;
+
+namespace {
+
+const size_t ALIGNED_SAMPLES = PlanarBuffer::ALIGNMENT / sizeof(Sample);
+
+} // namespace
+
+PlanarBuffer::PlanarBuffer(size_t n_channels, size_t size)
+{
+    resize(n_channels, size);
+}
+
+PlanarBuffer::PlanarBuffer(const Blocks& blocks)
+{
+    assign(blocks);
+}
+
+PlanarBuffer::PlanarBuffer(const PlanarBuffer& other)
+{
+    *this = other;
+}
+
+PlanarBuffer::PlanarBuffer(PlanarBuffer&& other) noexcept
+    : arena(other.arena), n_channels(other.n_channels), size(other.size), stride(other.stride)
+{
+    other.arena      = nullptr;
+    other.n_channels = 0;
+    other.size       = 0;
+    other.stride     = 0;
+}
+
+PlanarBuffer& PlanarBuffer::operator=(const PlanarBuffer& other)
+{
+    if (this == &other) {
+        return *this;
+    }
+    if (n_channels != other.n_channels || size != other.size) {
+        resize(other.n_channels, other.size);
+    }
+    if (arena) {
+        std::memcpy(arena, other.arena, n_channels * stride * sizeof(Sample));
+    }
+    return *this;
+}
+
+PlanarBuffer& PlanarBuffer::operator=(PlanarBuffer&& other) noexcept
+{
+    if (this != &other) {
+        _release();
+        std::swap(arena, other.arena);
+        std::swap(n_channels, other.n_channels);
+        std::swap(size, other.size);
+        std::swap(stride, other.stride);
+    }
+    return *this;
+}
+
+PlanarBuffer::~PlanarBuffer() { _release(); }
+
+void PlanarBuffer::resize(size_t n_channels, size_t size)
+{
+    _release();
+    this->n_channels = n_channels;
+    this->size       = size;
+    this->stride     = (size + ALIGNED_SAMPLES - 1) / ALIGNED_SAMPLES * ALIGNED_SAMPLES;
+    _allocate();
+}
+
+void PlanarBuffer::fill(Sample value)
+{
+    // the padding is filled as well, which keeps this a single linear pass
+    std::fill(arena, arena + n_channels * stride, value);
+}
+
+void PlanarBuffer::assign(const Blocks& blocks)
+{
+    const size_t block_size = blocks.empty() ? 0 : blocks[0].size();
+    if (n_channels != blocks.size() || size != block_size) {
+        resize(blocks.size(), block_size);
+    }
+    for (size_t ch = 0; ch < n_channels; ++ch) {
+        assert(blocks[ch].size() == size && "Expect blocks of equal size.");
+        std::memcpy(channel(ch), blocks[ch].data(), size * sizeof(Sample));
+    }
+}
+
+Blocks PlanarBuffer::to_blocks() const
+{
+    Blocks blocks(n_channels);
+    for (size_t ch = 0; ch < n_channels; ++ch) {
+        blocks[ch].assign(channel(ch), channel(ch) + size);
+    }
+    return blocks;
+}
+
+void PlanarBuffer::_allocate()
+{
+    const size_t n_samples = n_channels * stride;
+    if (n_samples == 0) {
+        return;
+    }
+    arena = static_cast<Sample*>(
+        ::operator new(n_samples * sizeof(Sample), std::align_val_t(ALIGNMENT)));
+    std::fill(arena, arena + n_samples, 0.0);
+}
+
+void PlanarBuffer::_release()
+{
+    if (arena) {
+        ::operator delete(arena, std::align_val_t(ALIGNMENT));
+        arena = nullptr;
+    }
+}
@@ -1,38 +1,103 @@
 #include "ringbuffer.h"
+#include "utils.h"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <string>
 using namespace zerr;
 
-RingBuffer::RingBuffer(size_t capacity) : buffer(capacity, 0.0f), head(0), tail(0), size(0) {}
+RingBuffer::RingBuffer(size_t capacity, size_t n_channels)
+    : capacity(capacity), n_channels(n_channels), storage(next_power_of_two(capacity)),
+      mask(storage - 1), tail(0), size(0)
+{
+    buffer.assign(2 * storage * n_channels, 0.0);
+}
 
 size_t RingBuffer::get_size() const { return size; }
 
-size_t RingBuffer::get_capacity() const { return buffer.size(); }
+size_t RingBuffer::get_capacity() const { return capacity; }
 
 void RingBuffer::enqueue(const Block& block)
 {
-    assert(block.size() <= buffer.size() && "Block size must be smaller than buffer size.");
+    if (n_channels != 1) {
+        throw std::invalid_argument("RingBuffer expects one block per channel");
+    }
+    _check_block_size(block.size());
 
-    for (const Sample& sample : block) {
-        buffer[tail] = sample;
-        tail         = (tail + 1) % buffer.size();
+    _write(0, block.data(), block.size());
+    _advance(block.size());
+}
 
-        if (size < buffer.size()) {
-            size++;
-        }
-        else {
-            head = (head + 1) % buffer.size();
+void RingBuffer::enqueue(const Blocks& blocks)
+{
+    if (blocks.size() != n_channels) {
+        throw std::invalid_argument("RingBuffer expects one block per channel");
+    }
+
+    const size_t block_size = blocks[0].size();
+    for (const auto& block : blocks) {
+        if (block.size() != block_size) {
+            throw std::invalid_argument("RingBuffer expects blocks of equal size");
         }
     }
+    _check_block_size(block_size);
+
+    for (size_t ch = 0; ch < n_channels; ++ch) {
+        _write(ch, blocks[ch].data(), block_size);
+    }
+    _advance(block_size);
+}
+
+void RingBuffer::enqueue(const PlanarBuffer& blocks)
+{
+    if (blocks.get_n_channels() != n_channels) {
+        throw std::invalid_argument("RingBuffer expects one block per channel");
+    }
+
+    const size_t block_size = blocks.get_size();
+    _check_block_size(block_size);
+
+    for (size_t ch = 0; ch < n_channels; ++ch) {
+        _write(ch, blocks.channel(ch), block_size);
+    }
+    _advance(block_size);
+}
+
+void RingBuffer::get_samples(Sample* output_buffer, size_t buf_len, size_t channel) const
+{
+    SampleView latest = view(buf_len, channel);
+    std::memcpy(output_buffer, latest.data(), buf_len * sizeof(Sample));
+}
+
+void RingBuffer::_check_block_size(size_t len) const
+{
+    // a longer block would write past the mirrored storage, also in release builds
+    if (len > capacity) {
+        throw std::invalid_argument("Block of " + std::to_string(len) +
+                                    " samples exceeds the ring buffer of " +
+                                    std::to_string(capacity) + " samples");
+    }
 }
 
-void RingBuffer::get_samples(Sample* output_buffer, size_t buf_len)
+void RingBuffer::_write(size_t channel, const Sample* samples, size_t len)
 {
-    // std::cout<<"get_samples:  "<<buf_len<<" | "<<buffer.size()<<std::endl;
+    Sample* data = buffer.data() + channel * 2 * storage;
 
-    assert(buf_len == buffer.size() && "Output buffer size should be equal to ringbuffer size!");
+    // the first part fills up to the end of the storage, the rest wraps to the start
+    const size_t first = std::min(len, storage - tail);
+    const size_t rest  = len - first;
 
-    size_t index = head;
-    for (size_t i = 0; i < buffer.size(); ++i) {
-        output_buffer[i] = buffer[index];
-        index            = (index + 1) % buffer.size();
+    std::memcpy(data + tail, samples, first * sizeof(Sample));
+    std::memcpy(data + storage + tail, samples, first * sizeof(Sample));
+    if (rest > 0) {
+        std::memcpy(data, samples + first, rest * sizeof(Sample));
+        std::memcpy(data + storage, samples + first, rest * sizeof(Sample));
     }
 }
+
+void RingBuffer::_advance(size_t len)
+{
+    tail = (tail + len) & mask;
+    size = std::min(size + len, capacity);
+}
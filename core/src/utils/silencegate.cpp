@@ -0,0 +1,62 @@
+/**
+ * @file silencegate.cpp
+ * @author Zeyu Yang (zeyuuyang42@gmail.com)
+ * @brief Per-block silence detection with hysteresis
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2023-2026
+ */
+#include "silencegate.h"
+
+#include <cmath>
+
+using zerr::SilenceGate;
+
+SilenceGate::SilenceGate(Sample threshold, size_t hold) : hold(hold)
+{
+    set_threshold(threshold);
+    reset();
+}
+
+void SilenceGate::set_threshold(Sample threshold)
+{
+    open_threshold  = threshold > 0.0 ? threshold : 0.0;
+    close_threshold = open_threshold * 0.5;
+    if (open_threshold == 0.0) {
+        reset();
+    }
+}
+
+bool SilenceGate::process(SampleView block)
+{
+    if (open_threshold == 0.0) {
+        return open;
+    }
+
+    // branch free, so that the loop vectorises
+    Sample peak = 0.0;
+    for (Sample v : block) {
+        const Sample a = std::abs(v);
+        peak           = a > peak ? a : peak;
+    }
+
+    if (peak >= open_threshold) {
+        open  = true;
+        quiet = 0;
+    }
+    else if (peak < close_threshold) {
+        quiet += block.size();
+        open = open && quiet < hold;
+    }
+    else {
+        // between the two levels the gate keeps its state
+        quiet = 0;
+    }
+    return open;
+}
+
+void SilenceGate::reset()
+{
+    open  = true;
+    quiet = 0;
+}
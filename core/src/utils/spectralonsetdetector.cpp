@@ -0,0 +1,173 @@
+/**
+ * @file spectralonsetdetector.cpp
+ * @author Zeyu Yang (zeyuuyang42@gmail.com)
+ * @brief streaming spectral onset detector
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2023-2026
+ */
+#include "spectralonsetdetector.h"
+
+#include <algorithm>
+#include <cmath>
+
+using zerr::FFTBuffer;
+using zerr::Param;
+using zerr::SpectralOnsetDetector;
+
+SpectralOnsetDetector::SpectralOnsetDetector(OnsetFunction odf)
+    : odfType(odf)
+    , numBins(0)
+    , hopSize(0)
+    , minInterval(0)
+    , thresholdScale(1.5)
+    , thresholdOffset(1e-3)
+    , odfHistory(11, 0.0)
+    , medianScratch(11, 0.0)
+{
+    reset();
+}
+
+void SpectralOnsetDetector::initialize(size_t numBins, size_t hopSize)
+{
+    this->numBins = numBins;
+    this->hopSize = hopSize;
+
+    prvMagnitude.assign(numBins, 0.0);
+    prvPhase.assign(numBins, 0.0);
+    prvPrvPhase.assign(numBins, 0.0);
+
+    reset();
+}
+
+void SpectralOnsetDetector::reset()
+{
+    std::fill(prvMagnitude.begin(), prvMagnitude.end(), 0.0);
+    std::fill(prvPhase.begin(), prvPhase.end(), 0.0);
+    std::fill(prvPrvPhase.begin(), prvPrvPhase.end(), 0.0);
+    std::fill(odfHistory.begin(), odfHistory.end(), 0.0);
+
+    historyPos  = 0;
+    historyFill = 0;
+
+    odfPrvPrv     = 0.0;
+    odfPrv        = 0.0;
+    odfCurr       = 0.0;
+    thresholdPrv  = 0.0;
+    thresholdCurr = 0.0;
+
+    samplesSinceOnset = minInterval;
+}
+
+void SpectralOnsetDetector::setThreshold(Param scale, Param offset)
+{
+    thresholdScale  = scale < 0.0 ? 0.0 : scale;
+    thresholdOffset = offset;
+}
+
+void SpectralOnsetDetector::setMedianLength(size_t numFrames)
+{
+    numFrames = numFrames < 1 ? 1 : numFrames;
+
+    odfHistory.assign(numFrames, 0.0);
+    medianScratch.assign(numFrames, 0.0);
+    historyPos  = 0;
+    historyFill = 0;
+}
+
+int SpectralOnsetDetector::process(const FFTBuffer& spectrum)
+{
+    // shift the detection function and threshold by one frame
+    odfPrvPrv    = odfPrv;
+    odfPrv       = odfCurr;
+    thresholdPrv = thresholdCurr;
+
+    odfCurr = _computeOdf(spectrum);
+
+    odfHistory[historyPos] = odfCurr;
+    historyPos             = (historyPos + 1) % odfHistory.size();
+    historyFill            = std::min(historyFill + 1, odfHistory.size());
+
+    thresholdCurr = thresholdOffset + thresholdScale * _median();
+
+    // the previous frame is an onset if it is a local maximum above its threshold
+    bool isPeak = odfPrv > odfPrvPrv && odfPrv >= odfCurr && odfPrv > thresholdPrv;
+
+    int onsetOffset = -1;
+    if (isPeak) {
+        // parabolic interpolation of the peak position, in frames relative to the previous one
+        Param curvature = odfPrvPrv - 2.0 * odfPrv + odfCurr;
+        Param shift     = curvature < 0.0 ? 0.5 * (odfPrvPrv - odfCurr) / curvature : 0.0;
+        shift           = std::max<Param>(-0.5, std::min<Param>(0.5, shift));
+
+        // a change within hop n shows up in frame n, map the peak back into the hop
+        long offset = std::lround((0.5 + shift) * (Param)hopSize);
+        offset      = std::max<long>(0, std::min<long>(offset, (long)hopSize - 1));
+
+        if (samplesSinceOnset + (size_t)offset >= minInterval) {
+            onsetOffset       = (int)offset;
+            samplesSinceOnset = hopSize - (size_t)offset;
+            return onsetOffset;
+        }
+    }
+
+    samplesSinceOnset += hopSize;
+    return onsetOffset;
+}
+
+Param SpectralOnsetDetector::_computeOdf(const FFTBuffer& spectrum)
+{
+    const size_t bins = std::min(numBins, spectrum.size());
+
+    double odf = 0.0;
+
+    switch (odfType) {
+    case OnsetFunction::SPECTRAL_FLUX:
+        for (size_t k = 0; k < bins; ++k) {
+            double magnitude = std::hypot(spectrum[k].real, spectrum[k].img);
+            double diff      = magnitude - prvMagnitude[k];
+            odf += diff > 0.0 ? diff : 0.0;
+            prvMagnitude[k] = magnitude;
+        }
+        break;
+
+    case OnsetFunction::COMPLEX_DOMAIN:
+        for (size_t k = 0; k < bins; ++k) {
+            double magnitude = std::hypot(spectrum[k].real, spectrum[k].img);
+            double phase     = std::atan2(spectrum[k].img, spectrum[k].real);
+
+            // predict the bin from a steady magnitude and a constant phase advance
+            double targetPhase = 2.0 * prvPhase[k] - prvPrvPhase[k];
+            double distanceSq  = magnitude * magnitude + prvMagnitude[k] * prvMagnitude[k] -
+                                2.0 * magnitude * prvMagnitude[k] * std::cos(phase - targetPhase);
+            odf += std::sqrt(distanceSq > 0.0 ? distanceSq : 0.0);
+
+            prvPrvPhase[k]  = prvPhase[k];
+            prvPhase[k]     = phase;
+            prvMagnitude[k] = magnitude;
+        }
+        break;
+
+    case OnsetFunction::HIGH_FREQUENCY_CONTENT:
+        for (size_t k = 0; k < bins; ++k) {
+            double power = spectrum[k].real * spectrum[k].real + spectrum[k].img * spectrum[k].img;
+            odf += (double)k * power;
+        }
+        break;
+    }
+
+    return bins > 0 ? (Param)(odf / (double)bins) : 0.0;
+}
+
+Param SpectralOnsetDetector::_median()
+{
+    if (historyFill == 0)
+        return 0.0;
+
+    std::copy(odfHistory.begin(), odfHistory.begin() + historyFill, medianScratch.begin());
+
+    auto middle = medianScratch.begin() + historyFill / 2;
+    std::nth_element(medianScratch.begin(), middle, medianScratch.begin() + historyFill);
+
+    return *middle;
+}
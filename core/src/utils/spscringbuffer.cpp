@@ -0,0 +1,144 @@
+#include "spscringbuffer.h"
+#include "utils.h"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+using namespace zerr;
+
+SPSCRingBuffer::SPSCRingBuffer(size_t capacity, size_t n_channels)
+    : capacity(capacity), storage(next_power_of_two(capacity)), mask(storage - 1),
+      n_channels(n_channels), buffer(storage * n_channels, 0.0), write_index(0),
+      cached_read_index(0), read_index(0), cached_write_index(0), overruns(0), dropped(0)
+{
+}
+
+size_t SPSCRingBuffer::write(const Sample* data, size_t len)
+{
+    if (n_channels != 1) {
+        throw std::invalid_argument("SPSCRingBuffer expects one block per channel");
+    }
+
+    const size_t n     = _reserve(len);
+    const size_t index = write_index.load(std::memory_order_relaxed);
+    _copy_in(0, index, data, n);
+    write_index.store(index + n, std::memory_order_release);
+
+    return n;
+}
+
+size_t SPSCRingBuffer::write(const Blocks& blocks)
+{
+    if (blocks.size() != n_channels) {
+        throw std::invalid_argument("SPSCRingBuffer expects one block per channel");
+    }
+    // every channel is copied with the size of the first block
+    const size_t block_size = blocks[0].size();
+    for (const auto& block : blocks) {
+        if (block.size() != block_size) {
+            throw std::invalid_argument("SPSCRingBuffer expects blocks of equal size");
+        }
+    }
+
+    const size_t n     = _reserve(block_size);
+    const size_t index = write_index.load(std::memory_order_relaxed);
+    for (size_t ch = 0; ch < n_channels; ++ch) {
+        _copy_in(ch, index, blocks[ch].data(), n);
+    }
+    write_index.store(index + n, std::memory_order_release);
+
+    return n;
+}
+
+size_t SPSCRingBuffer::read(Sample* data, size_t len)
+{
+    if (n_channels != 1) {
+        throw std::invalid_argument("SPSCRingBuffer expects one block per channel");
+    }
+
+    const size_t index = read_index.load(std::memory_order_relaxed);
+    if (cached_write_index - index < len) {
+        cached_write_index = write_index.load(std::memory_order_acquire);
+    }
+    const size_t n = std::min(len, cached_write_index - index);
+
+    _copy_out(0, index, data, n);
+    read_index.store(index + n, std::memory_order_release);
+
+    return n;
+}
+
+size_t SPSCRingBuffer::read(Blocks& blocks, size_t len)
+{
+    if (blocks.size() != n_channels) {
+        throw std::invalid_argument("SPSCRingBuffer expects one block per channel");
+    }
+    for (const auto& block : blocks) {
+        if (block.size() < len) {
+            throw std::invalid_argument("Destination block of " + std::to_string(block.size()) +
+                                        " samples is shorter than " + std::to_string(len));
+        }
+    }
+
+    const size_t index = read_index.load(std::memory_order_relaxed);
+    if (cached_write_index - index < len) {
+        cached_write_index = write_index.load(std::memory_order_acquire);
+    }
+    const size_t n = std::min(len, cached_write_index - index);
+
+    for (size_t ch = 0; ch < n_channels; ++ch) {
+        _copy_out(ch, index, blocks[ch].data(), n);
+    }
+    read_index.store(index + n, std::memory_order_release);
+
+    return n;
+}
+
+size_t SPSCRingBuffer::get_read_available() const
+{
+    return write_index.load(std::memory_order_acquire) - read_index.load(std::memory_order_acquire);
+}
+
+size_t SPSCRingBuffer::get_write_available() const
+{
+    return capacity - get_read_available();
+}
+
+size_t SPSCRingBuffer::_reserve(size_t len)
+{
+    const size_t index = write_index.load(std::memory_order_relaxed);
+
+    // only reload the reader's index when the cached one says the block does not fit
+    if (capacity - (index - cached_read_index) < len) {
+        cached_read_index = read_index.load(std::memory_order_acquire);
+    }
+    const size_t free = capacity - (index - cached_read_index);
+
+    if (free < len) {
+        overruns.fetch_add(1, std::memory_order_relaxed);
+        dropped.fetch_add(len - free, std::memory_order_relaxed);
+        return free;
+    }
+    return len;
+}
+
+void SPSCRingBuffer::_copy_in(size_t channel, size_t index, const Sample* data, size_t len)
+{
+    Sample* samples    = buffer.data() + channel * storage;
+    const size_t start = index & mask;
+    const size_t first = std::min(len, storage - start);
+
+    std::memcpy(samples + start, data, first * sizeof(Sample));
+    std::memcpy(samples, data + first, (len - first) * sizeof(Sample));
+}
+
+void SPSCRingBuffer::_copy_out(size_t channel, size_t index, Sample* data, size_t len) const
+{
+    const Sample* samples = buffer.data() + channel * storage;
+    const size_t start    = index & mask;
+    const size_t first    = std::min(len, storage - start);
+
+    std::memcpy(data, samples + start, first * sizeof(Sample));
+    std::memcpy(data + first, samples, (len - first) * sizeof(Sample));
+}
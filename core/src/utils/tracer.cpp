@@ -0,0 +1,173 @@
+#include "tracer.h"
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <vector>
+
+namespace zerr {
+
+namespace {
+
+static_assert((TRACE_BUFFER_SIZE & (TRACE_BUFFER_SIZE - 1)) == 0,
+              "TRACE_BUFFER_SIZE must be a power of two");
+
+/**
+ * @brief Small id of the calling thread, numbered in the order threads first record
+ */
+uint32_t _thread_id()
+{
+    static std::atomic<uint32_t> next{1};
+    thread_local uint32_t id = next.fetch_add(1, std::memory_order_relaxed);
+    return id;
+}
+
+/**
+ * @brief Append a string as a JSON string literal
+ */
+void _append_json_string(std::string& out, const char* s)
+{
+    out += '"';
+    for (; *s; ++s) {
+        if (*s == '"' || *s == '\\') {
+            out += '\\';
+            out += *s;
+        }
+        else if ((unsigned char)*s < 0x20) {
+            out += ' ';
+        }
+        else {
+            out += *s;
+        }
+    }
+    out += '"';
+}
+
+} // namespace
+
+Tracer& Tracer::instance()
+{
+    static Tracer tracer;
+    return tracer;
+}
+
+void Tracer::start()
+{
+    if (!events) {
+        events = std::make_unique<Event[]>(TRACE_BUFFER_SIZE);
+        epoch  = Clock::now();
+    }
+    enabled.store(true, std::memory_order_release);
+}
+
+void Tracer::record(const char* category, const char* name, Clock::time_point begin,
+                    Clock::time_point end)
+{
+    using std::chrono::duration_cast;
+    using std::chrono::nanoseconds;
+    _write(category, name, duration_cast<nanoseconds>(begin - epoch).count(),
+           duration_cast<nanoseconds>(end - epoch).count());
+}
+
+void Tracer::mark_xrun()
+{
+    if (!is_enabled()) {
+        return;
+    }
+    int64_t now = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - epoch)
+                      .count();
+    _write("host", "xrun", now, now);
+    xrun.store(true, std::memory_order_release);
+}
+
+bool Tracer::dump_xrun(const std::string& path)
+{
+    if (!xrun.exchange(false, std::memory_order_acquire)) {
+        return false;
+    }
+    return write_json(path);
+}
+
+void Tracer::_write(const char* category, const char* name, int64_t begin_ns, int64_t end_ns)
+{
+    uint64_t index = head.fetch_add(1, std::memory_order_relaxed);
+    Event& event   = events[index & (TRACE_BUFFER_SIZE - 1)];
+
+    // readers skip the slot while the sequence is odd or belongs to another index
+    event.sequence.store(2 * index + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    event.category = category;
+    std::strncpy(event.name, name, TRACE_NAME_SIZE - 1);
+    event.name[TRACE_NAME_SIZE - 1] = '\0';
+    event.begin_ns                  = begin_ns;
+    event.end_ns                    = end_ns;
+    event.thread                    = _thread_id();
+
+    event.sequence.store(2 * index + 2, std::memory_order_release);
+}
+
+std::string Tracer::to_json() const
+{
+    std::string out = "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+    if (!events) {
+        return out + "]}\n";
+    }
+
+    const uint64_t end   = head.load(std::memory_order_acquire);
+    const uint64_t begin = end > TRACE_BUFFER_SIZE ? end - TRACE_BUFFER_SIZE : 0;
+
+    bool first = true;
+    char numbers[128];
+    for (uint64_t index = begin; index < end; ++index) {
+        const Event& slot = events[index & (TRACE_BUFFER_SIZE - 1)];
+
+        // copy the slot and keep it only if no writer touched it meanwhile
+        uint64_t sequence = slot.sequence.load(std::memory_order_acquire);
+        if (sequence != 2 * index + 2) {
+            continue;
+        }
+        const char* category = slot.category;
+        char name[TRACE_NAME_SIZE];
+        std::memcpy(name, slot.name, TRACE_NAME_SIZE);
+        int64_t begin_ns = slot.begin_ns;
+        int64_t end_ns   = slot.end_ns;
+        uint32_t thread  = slot.thread;
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot.sequence.load(std::memory_order_relaxed) != sequence) {
+            continue;
+        }
+        name[TRACE_NAME_SIZE - 1] = '\0';
+
+        out += first ? "\n{\"name\":" : ",\n{\"name\":";
+        first = false;
+        _append_json_string(out, name);
+        out += ",\"cat\":";
+        _append_json_string(out, category);
+        if (end_ns == begin_ns) {
+            std::snprintf(numbers, sizeof(numbers),
+                          ",\"ph\":\"i\",\"s\":\"g\",\"ts\":%.3f,\"pid\":1,\"tid\":%u}",
+                          begin_ns * 1e-3, thread);
+        }
+        else {
+            std::snprintf(numbers, sizeof(numbers),
+                          ",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":1,\"tid\":%u}",
+                          begin_ns * 1e-3, (end_ns - begin_ns) * 1e-3, thread);
+        }
+        out += numbers;
+    }
+    out += "\n]}\n";
+    return out;
+}
+
+bool Tracer::write_json(const std::string& path) const
+{
+    std::ofstream file(path);
+    if (!file) {
+        return false;
+    }
+    file << to_json();
+    return (bool)file;
+}
+
+} // namespace zerr
@@ -4,26 +4,28 @@ namespace zerr {
 
 std::string formatString(const char* format, ...)
 {
+    // most messages fit on the stack, so vsnprintf runs once and only the result allocates
+    char stackBuffer[256];
+
     va_list args;
     va_start(args, format);
-
-    // Get the required size for the formatted string
-    int size = vsnprintf(nullptr, 0, format, args);
+    int size = vsnprintf(stackBuffer, sizeof(stackBuffer), format, args);
     va_end(args);
 
     if (size <= 0) {
         // Invalid format or error
         return "";
     }
+    if ((size_t)size < sizeof(stackBuffer)) {
+        return std::string(stackBuffer, size);
+    }
 
-    // Allocate memory for the formatted string
-    std::vector<char> buffer(size + 1); // +1 for null-terminator
-
+    std::string formatted(size, '\0');
     va_start(args, format);
-    vsnprintf(buffer.data(), size + 1, format, args);
+    vsnprintf(formatted.data(), size + 1, format, args);
     va_end(args);
 
-    return std::string(buffer.data());
+    return formatted;
 }
 
 // template<typename T>
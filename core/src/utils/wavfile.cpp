@@ -0,0 +1,240 @@
+/**
+ * @file wavfile.cpp
+ * @author Zeyu Yang (zeyuuyang42@gmail.com)
+ * @brief Minimal WAV reader over a memory-mapped file and a float WAV writer
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2023-2026
+ */
+#include "wavfile.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define ZERR_WAV_MMAP
+#endif
+
+using namespace zerr;
+
+namespace {
+
+constexpr uint16_t FORMAT_PCM        = 1;
+constexpr uint16_t FORMAT_FLOAT      = 3;
+constexpr uint16_t FORMAT_EXTENSIBLE = 0xFFFE;
+
+uint16_t read16(const uint8_t* p) { return (uint16_t)(p[0] | p[1] << 8); }
+
+uint32_t read32(const uint8_t* p)
+{
+    return (uint32_t)p[0] | (uint32_t)p[1] << 8 | (uint32_t)p[2] << 16 | (uint32_t)p[3] << 24;
+}
+
+void put16(std::vector<uint8_t>& out, uint16_t v)
+{
+    out.push_back(v & 0xFF);
+    out.push_back(v >> 8);
+}
+
+void put32(std::vector<uint8_t>& out, uint32_t v)
+{
+    for (int i = 0; i < 4; ++i) {
+        out.push_back((v >> (8 * i)) & 0xFF);
+    }
+}
+
+} // namespace
+
+WavReader::WavReader(const std::string& path)
+{
+#ifdef ZERR_WAV_MMAP
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error("cannot open " + path);
+    }
+    struct stat st;
+    if (fstat(fd, &st) == 0 && st.st_size > 0) {
+        size      = (size_t)st.st_size;
+        void* map = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (map != MAP_FAILED) {
+            data = static_cast<const uint8_t*>(map);
+            // the file is read once from start to end
+            madvise(map, size, MADV_SEQUENTIAL);
+        }
+    }
+    ::close(fd);
+#endif
+    if (!data) {
+        std::ifstream in(path, std::ios::binary);
+        if (!in) {
+            throw std::runtime_error("cannot open " + path);
+        }
+        copy.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+        data = copy.data();
+        size = copy.size();
+    }
+    _parse(path);
+}
+
+WavReader::~WavReader()
+{
+#ifdef ZERR_WAV_MMAP
+    if (data && copy.empty()) {
+        munmap(const_cast<uint8_t*>(data), size);
+    }
+#endif
+}
+
+void WavReader::_parse(const std::string& path)
+{
+    if (size < 12 || std::memcmp(data, "RIFF", 4) || std::memcmp(data + 8, "WAVE", 4)) {
+        throw std::runtime_error(path + " is not a WAV file");
+    }
+
+    uint16_t format   = 0;
+    int bits          = 0;
+    size_t data_bytes = 0;
+    for (size_t pos = 12; pos + 8 <= size;) {
+        const uint8_t* chunk = data + pos;
+        size_t chunk_size    = read32(chunk + 4);
+        const uint8_t* body  = chunk + 8;
+        size_t available     = std::min(chunk_size, size - pos - 8);
+
+        if (!std::memcmp(chunk, "fmt ", 4) && available >= 16) {
+            format      = read16(body);
+            n_channels  = read16(body + 2);
+            sample_rate = read32(body + 4);
+            bits        = read16(body + 14);
+            if (format == FORMAT_EXTENSIBLE && available >= 26) {
+                format = read16(body + 24);
+            }
+        }
+        else if (!std::memcmp(chunk, "data", 4)) {
+            samples    = body;
+            data_bytes = available;
+        }
+        // chunks are padded to an even size
+        pos += 8 + chunk_size + (chunk_size & 1);
+    }
+
+    is_float         = format == FORMAT_FLOAT;
+    bytes_per_sample = bits / 8;
+    bool supported   = (format == FORMAT_PCM && (bits == 16 || bits == 24 || bits == 32)) ||
+                     (is_float && (bits == 32 || bits == 64));
+    if (!supported || n_channels < 1 || !samples) {
+        throw std::runtime_error(path + " is not 16, 24 or 32 bit PCM or float WAV");
+    }
+    n_frames = data_bytes / (bytes_per_sample * n_channels);
+}
+
+float WavReader::_sample(const uint8_t* p) const
+{
+    if (is_float) {
+        if (bytes_per_sample == 4) {
+            float v;
+            std::memcpy(&v, p, 4);
+            return v;
+        }
+        double v;
+        std::memcpy(&v, p, 8);
+        return (float)v;
+    }
+    switch (bytes_per_sample) {
+    case 2:
+        return (int16_t)read16(p) / 32768.0f;
+    case 3:
+        return (int32_t)((uint32_t)p[0] << 8 | (uint32_t)p[1] << 16 | (uint32_t)p[2] << 24) /
+               2147483648.0f;
+    default:
+        return (int32_t)read32(p) / 2147483648.0f;
+    }
+}
+
+size_t WavReader::read(float* const* channels, size_t n)
+{
+    const size_t n_read = std::min(n, n_frames - position);
+    const size_t stride = (size_t)bytes_per_sample * n_channels;
+
+    const uint8_t* frame = samples + position * stride;
+    for (size_t i = 0; i < n_read; ++i, frame += stride) {
+        for (int ch = 0; ch < n_channels; ++ch) {
+            channels[ch][i] = _sample(frame + ch * bytes_per_sample);
+        }
+    }
+    for (int ch = 0; ch < n_channels; ++ch) {
+        std::fill(channels[ch] + n_read, channels[ch] + n, 0.0f);
+    }
+    position += n_read;
+    return n_read;
+}
+
+WavWriter::WavWriter(const std::string& path, int n_channels, size_t sample_rate)
+    : n_channels(n_channels)
+    , sample_rate(sample_rate)
+{
+    file = std::fopen(path.c_str(), "wb");
+    if (!file) {
+        throw std::runtime_error("cannot create " + path);
+    }
+    _write_header();
+}
+
+WavWriter::~WavWriter() { close(); }
+
+void WavWriter::_write_header()
+{
+    const uint32_t data_bytes = (uint32_t)(n_frames * n_channels * sizeof(float));
+    const uint16_t block      = (uint16_t)(n_channels * sizeof(float));
+
+    std::vector<uint8_t> header;
+    header.insert(header.end(), {'R', 'I', 'F', 'F'});
+    put32(header, 4 + (8 + 16) + (8 + 4) + (8 + data_bytes));
+    header.insert(header.end(), {'W', 'A', 'V', 'E', 'f', 'm', 't', ' '});
+    put32(header, 16);
+    put16(header, FORMAT_FLOAT);
+    put16(header, (uint16_t)n_channels);
+    put32(header, (uint32_t)sample_rate);
+    put32(header, (uint32_t)(sample_rate * block));
+    put16(header, block);
+    put16(header, 32);
+    // float data needs a fact chunk with the number of frames
+    header.insert(header.end(), {'f', 'a', 'c', 't'});
+    put32(header, 4);
+    put32(header, (uint32_t)n_frames);
+    header.insert(header.end(), {'d', 'a', 't', 'a'});
+    put32(header, data_bytes);
+
+    std::fseek(file, 0, SEEK_SET);
+    failed |= std::fwrite(header.data(), 1, header.size(), file) != header.size();
+    std::fseek(file, 0, SEEK_END);
+}
+
+void WavWriter::write(const float* const* channels, size_t n)
+{
+    interleaved.resize(n * n_channels);
+    for (size_t i = 0; i < n; ++i) {
+        for (int ch = 0; ch < n_channels; ++ch) {
+            interleaved[i * n_channels + ch] = channels[ch][i];
+        }
+    }
+    failed |= std::fwrite(interleaved.data(), sizeof(float), interleaved.size(), file) !=
+              interleaved.size();
+    n_frames += n;
+}
+
+bool WavWriter::close()
+{
+    if (!file) {
+        return !failed;
+    }
+    _write_header();
+    failed |= std::fclose(file) != 0;
+    file = nullptr;
+    return !failed;
+}
@@ -0,0 +1,289 @@
+/**
+ * @file bus.cpp
+ * @author Zeyu Yang (zeyuuyang42@gmail.com)
+ * @brief Lists the feature buses or follows the frames published on one of them
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2023-2026
+ *
+ * Without arguments the existing buses are listed. With a bus name every published frame is
+ * printed as it arrives, like tail -f, or only the latest frame at a fixed rate. The tool waits
+ * for the bus to appear and follows it when the writer restarts.
+ *
+ *     zerr_bus voice --features rms,osf --rate 20
+ */
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "featurebus.h"
+
+using namespace zerr;
+
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+/**
+ * @brief Command line options
+ */
+struct Options {
+    std::string bus;        /**< Bus to follow, empty to list the buses */
+    FeatureNames features;  /**< Features to print, all if empty */
+    double rate     = 0.0;  /**< Frames per second printed, 0 prints every frame */
+    uint64_t frames = 0;    /**< Quit after this many frames, 0 runs until interrupted */
+    bool csv        = false;
+};
+
+FeatureNames split(const std::string& list)
+{
+    FeatureNames names;
+    std::stringstream stream(list);
+    std::string name;
+    while (std::getline(stream, name, ',')) {
+        if (!name.empty()) {
+            names.push_back(name);
+        }
+    }
+    return names;
+}
+
+void usage()
+{
+    std::printf(
+        "usage: zerr_bus [<bus> [options]]\n"
+        "  without a bus, list the existing buses\n"
+        "  --features <list>    comma-separated features to print (all)\n"
+        "  --rate <hz>          print the latest frame this often instead of every frame\n"
+        "  --frames <n>         quit after n frames\n"
+        "  --csv                print comma-separated values\n");
+}
+
+bool parse(int argc, char** argv, Options& options)
+{
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg.rfind("--", 0) != 0) {
+            if (!options.bus.empty()) {
+                return false;
+            }
+            options.bus = arg;
+            continue;
+        }
+        if (arg == "--csv") {
+            options.csv = true;
+            continue;
+        }
+
+        const char* value = i + 1 < argc ? argv[i + 1] : nullptr;
+        if (!value) {
+            return false;
+        }
+        ++i;
+        if (arg == "--features")
+            options.features = split(value);
+        else if (arg == "--rate")
+            options.rate = std::strtod(value, nullptr);
+        else if (arg == "--frames")
+            options.frames = std::strtoull(value, nullptr, 10);
+        else
+            return false;
+    }
+    return options.rate >= 0.0;
+}
+
+int list()
+{
+    FeatureNames buses = list_feature_buses();
+    for (const auto& name : buses) {
+        try {
+            FeatureBusReader reader(name);
+            std::printf("%-24s %zu features, %.0f Hz / %zu%s\n", name.c_str(),
+                        reader.get_n_features(), reader.get_sample_rate(),
+                        reader.get_block_size(), reader.is_closed() ? ", closed" : "");
+        }
+        catch (const std::exception& e) {
+            std::printf("%-24s %s\n", name.c_str(), e.what());
+        }
+    }
+    if (buses.empty()) {
+        std::printf("no feature buses\n");
+    }
+    return 0;
+}
+
+/**
+ * @brief Open the bus, waiting until it exists
+ */
+std::unique_ptr<FeatureBusReader> open(const std::string& name)
+{
+    bool waiting = false;
+    while (true) {
+        try {
+            auto reader = std::make_unique<FeatureBusReader>(name);
+            if (!reader->is_closed()) {
+                return reader;
+            }
+        }
+        catch (const std::exception& e) {
+            if (!waiting) {
+                std::fprintf(stderr, "zerr_bus: %s, waiting\n", e.what());
+            }
+        }
+        waiting = true;
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    }
+}
+
+/**
+ * @brief Indices of the printed features, empty if one of them is missing
+ */
+std::vector<int> find_columns(const FeatureBusReader& reader, const Options& options)
+{
+    std::vector<int> columns;
+    FeatureNames names = options.features.empty() ? reader.get_feature_names() : options.features;
+    for (const auto& name : names) {
+        int index = reader.find(name);
+        if (index < 0) {
+            std::fprintf(stderr, "zerr_bus: bus |%s| has no feature |%s|\n",
+                         reader.get_name().c_str(), name.c_str());
+            return {};
+        }
+        columns.push_back(index);
+    }
+    return columns;
+}
+
+void print_header(const FeatureBusReader& reader, const std::vector<int>& columns,
+                  const Options& options)
+{
+    const char* separator = options.csv ? "," : " ";
+    std::printf(options.csv ? "frame,time" : "%10s %12s", "frame", "time");
+    for (int index : columns) {
+        const char* name = reader.get_feature_names()[index].c_str();
+        if (options.csv) {
+            std::printf("%s%s", separator, name);
+        }
+        else {
+            std::printf("%s%12s", separator, name);
+        }
+    }
+    std::printf("\n");
+}
+
+void print_frame(const FeatureFrame& frame, const std::vector<int>& columns, int64_t origin_ns,
+                 const Options& options)
+{
+    const double time = (frame.time_ns - origin_ns) * 1e-9;
+    if (options.csv) {
+        std::printf("%llu,%.6f", (unsigned long long)frame.frame, time);
+        for (int index : columns) {
+            std::printf(",%.9g", frame.values[index]);
+        }
+    }
+    else {
+        std::printf("%10llu %12.6f", (unsigned long long)frame.frame, time);
+        for (int index : columns) {
+            std::printf(" %12.6g", frame.values[index]);
+        }
+    }
+    std::printf("\n");
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    Options options;
+    if (!parse(argc, argv, options)) {
+        usage();
+        return 1;
+    }
+    if (options.bus.empty()) {
+        return list();
+    }
+
+    uint64_t printed = 0;
+    FeatureFrame frame;
+    while (true) {
+        std::unique_ptr<FeatureBusReader> reader = open(options.bus);
+        const std::vector<int> columns           = find_columns(*reader, options);
+        if (columns.empty()) {
+            return 1;
+        }
+        print_header(*reader, columns, options);
+
+        // times are printed relative to the first frame seen
+        int64_t origin_ns = -1;
+        uint64_t next     = reader->get_published();
+        uint64_t dropped  = 0;
+        auto deadline     = Clock::now();
+        auto progress     = Clock::now();
+
+        while (!reader->is_closed() || next < reader->get_published()) {
+            // a writer that crashed never closes its bus, its successor creates a new one
+            if (next < reader->get_published()) {
+                progress = Clock::now();
+            }
+            else if (Clock::now() - progress > std::chrono::seconds(1)) {
+                if (reader->is_replaced()) {
+                    break;
+                }
+                progress = Clock::now();
+            }
+
+            if (options.rate > 0.0) {
+                deadline += std::chrono::duration_cast<Clock::duration>(
+                    std::chrono::duration<double>(1.0 / options.rate));
+                std::this_thread::sleep_until(deadline);
+                if (reader->read_latest(frame) && frame.frame >= next) {
+                    origin_ns = origin_ns < 0 ? frame.time_ns : origin_ns;
+                    print_frame(frame, columns, origin_ns, options);
+                    std::fflush(stdout);
+                    next = frame.frame + 1;
+                    ++printed;
+                }
+            }
+            else {
+                const uint64_t published = reader->get_published();
+                if (published - next > reader->get_capacity()) {
+                    // the writer lapped us, continue with the oldest frame still there
+                    dropped += published - reader->get_capacity() - next;
+                    next = published - reader->get_capacity();
+                }
+                for (; next < published; ++next) {
+                    if (!reader->read(next, frame)) {
+                        ++dropped;
+                        continue;
+                    }
+                    origin_ns = origin_ns < 0 ? frame.time_ns : origin_ns;
+                    print_frame(frame, columns, origin_ns, options);
+                    if (options.frames && ++printed >= options.frames) {
+                        break;
+                    }
+                }
+                std::fflush(stdout);
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+            if (options.frames && printed >= options.frames) {
+                if (dropped) {
+                    std::fprintf(stderr, "zerr_bus: %llu frames dropped\n",
+                                 (unsigned long long)dropped);
+                }
+                return 0;
+            }
+        }
+
+        std::fprintf(stderr, "zerr_bus: bus |%s| closed", options.bus.c_str());
+        if (dropped) {
+            std::fprintf(stderr, ", %llu frames dropped", (unsigned long long)dropped);
+        }
+        std::fprintf(stderr, "\n");
+        std::fflush(stdout);
+    }
+}
@@ -0,0 +1,340 @@
+/**
+ * @file extract.cpp
+ * @author Zeyu Yang (zeyuuyang42@gmail.com)
+ * @brief Offline feature extraction of many recordings in parallel into columnar files
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2023-2026
+ *
+ * Every worker thread takes the next file from the list, builds its FeatureBank for the sample
+ * rate of the file and runs the whole file through it, without waiting for real time. The
+ * trajectories are written as one .zft file per recording, see featurefile.h, and optionally
+ * as CSV. Multichannel recordings are mixed to mono, like a single inlet of zerr_features~.
+ *
+ *     zerr_extract --features rms,ctd@1024/256,osf --out features/ --csv recordings/<name>.wav
+ */
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "featurebank.h"
+#include "featurefile.h"
+#include "wavfile.h"
+
+using namespace zerr;
+
+namespace fs = std::filesystem;
+
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+/**
+ * @brief Command line options
+ */
+struct Options {
+    FeatureNames features = {"rms", "ctd", "osf"}; /**< Feature set of every file */
+    std::vector<fs::path> inputs;                  /**< Recordings to analyse */
+    fs::path out_dir;                              /**< Output directory, empty for beside */
+    size_t block_size = 512;                       /**< Samples per row */
+    unsigned n_jobs   = 0;                         /**< Worker threads, 0 for all cores */
+    bool csv          = false;                     /**< Also write CSV files */
+};
+
+/**
+ * @brief One recording and the outcome of its analysis
+ */
+struct Job {
+    fs::path input;
+    fs::path output;     /**< The .zft file, the CSV file has the same stem */
+    double seconds = 0;  /**< Duration of the recording */
+    std::string error;   /**< Empty if the analysis succeeded */
+};
+
+uint64_t round_up(uint64_t n, uint64_t alignment)
+{
+    return (n + alignment - 1) / alignment * alignment;
+}
+
+/**
+ * @brief Write the columns, laid out with the stride of the file already
+ */
+void write_feature_file(const fs::path& path, const FeatureNames& names, size_t sample_rate,
+                        size_t hop_size, uint64_t n_frames, const std::vector<float>& columns)
+{
+    FeatureFileHeader header{};
+    std::memcpy(header.magic, FEATURE_FILE_MAGIC, sizeof(header.magic));
+    header.version    = FEATURE_FILE_VERSION;
+    header.n_features = (uint32_t)names.size();
+    header.n_frames   = n_frames;
+    header.column_offset =
+        round_up(sizeof(FeatureFileHeader) + names.size() * FEATURE_NAME_SIZE, FEATURE_FILE_ALIGN);
+    header.column_stride = round_up(n_frames * sizeof(float), FEATURE_FILE_ALIGN);
+    header.sample_rate   = (double)sample_rate;
+    header.hop_size      = (uint32_t)hop_size;
+    header.name_size     = FEATURE_NAME_SIZE;
+
+    std::vector<char> head(header.column_offset, 0);
+    std::memcpy(head.data(), &header, sizeof(header));
+    for (size_t i = 0; i < names.size(); ++i) {
+        std::strncpy(head.data() + sizeof(header) + i * FEATURE_NAME_SIZE, names[i].c_str(),
+                     FEATURE_NAME_SIZE - 1);
+    }
+
+    std::ofstream file(path, std::ios::binary);
+    file.write(head.data(), head.size());
+    file.write(reinterpret_cast<const char*>(columns.data()), columns.size() * sizeof(float));
+    if (!file) {
+        throw std::runtime_error("cannot write " + path.string());
+    }
+}
+
+void write_csv(const fs::path& path, const FeatureNames& names, size_t sample_rate,
+               size_t hop_size, uint64_t n_frames, const std::vector<float>& columns,
+               size_t stride)
+{
+    std::ofstream file(path);
+    file << "time";
+    for (const auto& name : names) {
+        file << "," << name;
+    }
+    file << "\n";
+
+    char value[32];
+    for (uint64_t row = 0; row < n_frames; ++row) {
+        std::snprintf(value, sizeof(value), "%.6f", (double)(row + 1) * hop_size / sample_rate);
+        file << value;
+        for (size_t f = 0; f < names.size(); ++f) {
+            std::snprintf(value, sizeof(value), ",%.9g", columns[f * stride + row]);
+            file << value;
+        }
+        file << "\n";
+    }
+    if (!file) {
+        throw std::runtime_error("cannot write " + path.string());
+    }
+}
+
+/**
+ * @brief Analyse one recording with a bank owned by the calling worker
+ */
+void extract(const Options& options, Job& job, std::unique_ptr<FeatureBank>& bank)
+{
+    WavReader reader(job.input.string());
+    const size_t block_size  = options.block_size;
+    const size_t sample_rate = reader.get_sample_rate();
+    const int n_channels     = reader.get_n_channels();
+
+    // a fresh bank per file keeps the results independent of the order the files are taken in
+    bank = std::make_unique<FeatureBank>();
+    bank->initialize(options.features, {sample_rate, block_size});
+
+    const uint64_t n_frames = (reader.get_n_frames() + block_size - 1) / block_size;
+    const size_t stride =
+        round_up(n_frames * sizeof(float), FEATURE_FILE_ALIGN) / sizeof(float);
+    std::vector<float> columns(options.features.size() * stride, 0.0f);
+
+    std::vector<std::vector<float>> blocks(n_channels, std::vector<float>(block_size));
+    std::vector<float*> channels(n_channels);
+    for (int ch = 0; ch < n_channels; ++ch) {
+        channels[ch] = blocks[ch].data();
+    }
+    Block mono(block_size);
+
+    for (uint64_t row = 0; row < n_frames; ++row) {
+        reader.read(channels.data(), block_size);
+        for (size_t i = 0; i < block_size; ++i) {
+            Sample sum = 0.0;
+            for (int ch = 0; ch < n_channels; ++ch) {
+                sum += blocks[ch][i];
+            }
+            mono[i] = sum / n_channels;
+        }
+
+        // the value at the end of the block is the latest analysis of every feature
+        const FeaturesVals& y = bank->perform(mono);
+        for (size_t f = 0; f < y.size(); ++f) {
+            columns[f * stride + row] = y[f].back();
+        }
+    }
+
+    write_feature_file(job.output, options.features, sample_rate, block_size, n_frames, columns);
+    if (options.csv) {
+        fs::path csv = job.output;
+        write_csv(csv.replace_extension(".csv"), options.features, sample_rate, block_size,
+                  n_frames, columns, stride);
+    }
+    job.seconds = (double)reader.get_n_frames() / sample_rate;
+}
+
+FeatureNames split(const std::string& list)
+{
+    FeatureNames names;
+    std::stringstream stream(list);
+    std::string name;
+    while (std::getline(stream, name, ',')) {
+        if (!name.empty()) {
+            names.push_back(name);
+        }
+    }
+    return names;
+}
+
+void usage()
+{
+    std::printf(
+        "usage: zerr_extract [options] <file.wav>...\n"
+        "  --features <list>    comma-separated feature set (rms,ctd,osf), e.g. ctd@1024/256\n"
+        "  --list <file>        also analyse the files listed in a text file, one per line\n"
+        "  --out <dir>          output directory (beside every input)\n"
+        "  --block <n>          samples per row of the output, at most 2048 (512)\n"
+        "  --jobs <n>           number of worker threads (all cores)\n"
+        "  --csv                also write a CSV file per input\n");
+}
+
+bool parse(int argc, char** argv, Options& options)
+{
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg.rfind("--", 0) != 0) {
+            options.inputs.emplace_back(arg);
+            continue;
+        }
+        if (arg == "--csv") {
+            options.csv = true;
+            continue;
+        }
+
+        const char* value = i + 1 < argc ? argv[i + 1] : nullptr;
+        if (!value) {
+            return false;
+        }
+        ++i;
+        if (arg == "--features")
+            options.features = split(value);
+        else if (arg == "--list") {
+            std::ifstream list(value);
+            if (!list) {
+                std::fprintf(stderr, "zerr_extract: cannot read %s\n", value);
+                return false;
+            }
+            std::string line;
+            while (std::getline(list, line)) {
+                if (!line.empty()) {
+                    options.inputs.emplace_back(line);
+                }
+            }
+        }
+        else if (arg == "--out")
+            options.out_dir = value;
+        else if (arg == "--block")
+            options.block_size = std::strtoul(value, nullptr, 10);
+        else if (arg == "--jobs")
+            options.n_jobs = (unsigned)std::strtoul(value, nullptr, 10);
+        else
+            return false;
+    }
+    // the analysis buffers of the bank hold AUDIO_BUFFER_SIZE samples at least
+    if (options.block_size == 0 || options.block_size > AUDIO_BUFFER_SIZE) {
+        std::fprintf(stderr, "zerr_extract: --block must be between 1 and %d\n",
+                     AUDIO_BUFFER_SIZE);
+        return false;
+    }
+    return !options.inputs.empty() && !options.features.empty();
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    Options options;
+    if (!parse(argc, argv, options)) {
+        usage();
+        return 1;
+    }
+
+    // check the feature set once instead of failing in every worker
+    try {
+        FeatureBank bank;
+        bank.initialize(options.features, {48000, options.block_size});
+    }
+    catch (const std::exception& e) {
+        std::fprintf(stderr, "zerr_extract: %s\n", e.what());
+        return 1;
+    }
+
+    if (!options.out_dir.empty()) {
+        fs::create_directories(options.out_dir);
+    }
+    std::vector<Job> jobs(options.inputs.size());
+    for (size_t i = 0; i < jobs.size(); ++i) {
+        jobs[i].input  = options.inputs[i];
+        jobs[i].output = options.out_dir.empty()
+                             ? fs::path(jobs[i].input).replace_extension(".zft")
+                             : options.out_dir / jobs[i].input.stem().concat(".zft");
+    }
+
+    unsigned n_jobs = options.n_jobs ? options.n_jobs : std::thread::hardware_concurrency();
+    n_jobs          = std::max(1u, std::min<unsigned>(n_jobs, (unsigned)jobs.size()));
+    std::printf("%zu files, %zu features, block %zu, %u workers\n", jobs.size(),
+                options.features.size(), options.block_size, n_jobs);
+
+    std::atomic<size_t> next{0};
+    std::atomic<size_t> done{0};
+    std::mutex print_mutex;
+
+    const auto start = Clock::now();
+    std::vector<std::thread> workers;
+    for (unsigned w = 0; w < n_jobs; ++w) {
+        workers.emplace_back([&]() {
+            std::unique_ptr<FeatureBank> bank;
+            for (size_t i = next++; i < jobs.size(); i = next++) {
+                try {
+                    extract(options, jobs[i], bank);
+                }
+                catch (const std::exception& e) {
+                    jobs[i].error = e.what();
+                }
+
+                std::lock_guard<std::mutex> lock(print_mutex);
+                size_t n = ++done;
+                if (jobs[i].error.empty()) {
+                    std::printf("[%zu/%zu] %s: %.1f s\n", n, jobs.size(),
+                                jobs[i].output.string().c_str(), jobs[i].seconds);
+                }
+                else {
+                    std::fprintf(stderr, "[%zu/%zu] %s: %s\n", n, jobs.size(),
+                                 jobs[i].input.string().c_str(), jobs[i].error.c_str());
+                }
+            }
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    const double elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+
+    double seconds = 0.0;
+    size_t failed  = 0;
+    for (const auto& job : jobs) {
+        seconds += job.seconds;
+        failed += !job.error.empty();
+    }
+    std::printf("\n%zu of %zu files, %.1f s of audio in %.2f s: %.1fx real time, %.1f files/s\n",
+                jobs.size() - failed, jobs.size(), seconds, elapsed,
+                elapsed > 0.0 ? seconds / elapsed : 0.0,
+                elapsed > 0.0 ? (jobs.size() - failed) / elapsed : 0.0);
+
+    return failed ? 1 : 0;
+}
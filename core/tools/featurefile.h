@@ -0,0 +1,58 @@
+/**
+ * @file featurefile.h
+ * @author Zeyu Yang (zeyuuyang42@gmail.com)
+ * @brief Layout of the columnar feature files written by zerr_extract
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2023-2026
+ *
+ * A .zft file holds the feature trajectories of one recording, one column per feature, so that
+ * a reader can map the file and use every column as an array without copying:
+ *
+ *     offset               content
+ *     0                    FeatureFileHeader, 64 bytes
+ *     64                   n_features names of FEATURE_NAME_SIZE bytes, NUL-padded
+ *     column_offset        column 0: n_frames float32 values
+ *     column_offset + k *  column k
+ *       column_stride
+ *
+ * All values are little-endian. column_offset and column_stride are multiples of 64, so every
+ * column starts on a cache line. Row i holds the values at the end of block i, that is at
+ * (i + 1) * hop_size samples. With numpy:
+ *
+ *     h = np.fromfile(path, dtype=np.uint8, count=64)
+ *     columns = np.memmap(path, dtype=np.float32, mode="r", offset=column_offset,
+ *                         shape=(n_features, column_stride // 4))[:, :n_frames]
+ */
+#ifndef FEATUREFILE_H
+#define FEATUREFILE_H
+
+#include <cstdint>
+
+namespace zerr {
+
+constexpr char FEATURE_FILE_MAGIC[8]   = {'Z', 'E', 'R', 'R', 'F', 'E', 'A', 'T'};
+constexpr uint32_t FEATURE_FILE_VERSION = 1;
+constexpr uint32_t FEATURE_NAME_SIZE    = 32; /**< Bytes of a name, including the terminator */
+constexpr uint64_t FEATURE_FILE_ALIGN   = 64; /**< Alignment of the columns in bytes */
+
+/**
+ * @brief Header at the start of a .zft file
+ */
+struct FeatureFileHeader {
+    char magic[8];          /**< FEATURE_FILE_MAGIC */
+    uint32_t version;       /**< FEATURE_FILE_VERSION */
+    uint32_t n_features;    /**< Number of columns */
+    uint64_t n_frames;      /**< Number of rows */
+    uint64_t column_offset; /**< Byte offset of the first column */
+    uint64_t column_stride; /**< Bytes from the start of one column to the next */
+    double sample_rate;     /**< Sample rate of the recording */
+    uint32_t hop_size;      /**< Samples between two rows */
+    uint32_t name_size;     /**< FEATURE_NAME_SIZE */
+    uint8_t reserved[8];    /**< Zero */
+};
+
+static_assert(sizeof(FeatureFileHeader) == 64, "the header must stay 64 bytes");
+
+} // namespace zerr
+#endif // FEATUREFILE_H
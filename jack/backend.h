@@ -0,0 +1,46 @@
+/**
+ * @file backend.h
+ * @author Zeyu Yang (zeyuuyang42@gmail.com)
+ * @brief Interface of the audio drivers that run the engine of the host
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2023-2026
+ */
+#ifndef BACKEND_H
+#define BACKEND_H
+
+#include <atomic>
+
+#include "zerr.h"
+
+namespace zerr {
+
+/**
+ * @class Backend
+ * @brief Feeds the engine with blocks and takes its speaker signals
+ *
+ * A backend decides the sample rate and block size, calls Zerr::prepare() and then
+ * Zerr::process() for every block, from an audio thread or as fast as it can. While it runs,
+ * it calls Zerr::service() from a non-real-time thread to print the deferred log messages.
+ */
+class Backend {
+  public:
+    virtual ~Backend() = default;
+
+    /**
+     * @brief Run the engine until stop() or the end of the input
+     * @param engine Engine with a loaded session
+     * @return int Exit code of the program
+     */
+    virtual int run(Zerr& engine) = 0;
+    /**
+     * @brief Ask run() to return, async-signal-safe
+     */
+    void stop() { running.store(false); }
+
+  protected:
+    std::atomic<bool> running{true};
+};
+
+} // namespace zerr
+#endif // BACKEND_H
@@ -0,0 +1,98 @@
+/**
+ * @file filebackend.cpp
+ * @author Zeyu Yang (zeyuuyang42@gmail.com)
+ * @brief Backend rendering a WAV file through the engine faster than real time
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2023-2026
+ */
+#include "filebackend.h"
+
+#include <chrono>
+#include <cstdio>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "wavfile.h"
+
+using namespace zerr;
+
+int FileBackend::run(Zerr& engine)
+{
+    using Clock                = std::chrono::steady_clock;
+    const HostOptions& options = engine.getOptions();
+
+    WavReader reader(options.input_path);
+    const int numChannels = reader.get_n_channels();
+    const int numSources  = engine.getNumInputs();
+    if (numChannels != 1 && numChannels != numSources) {
+        throw std::runtime_error(options.input_path + " has " + std::to_string(numChannels) +
+                                 " channels, the session needs 1 or " +
+                                 std::to_string(numSources));
+    }
+    // the analysis buffers of the feature banks hold AUDIO_BUFFER_SIZE samples at least
+    if (options.block_size == 0 || options.block_size > AUDIO_BUFFER_SIZE) {
+        throw std::runtime_error("--block must be between 1 and " +
+                                 std::to_string(AUDIO_BUFFER_SIZE) + " samples, got " +
+                                 std::to_string(options.block_size));
+    }
+
+    SystemConfigs systemCfgs{};
+    systemCfgs.sample_rate = reader.get_sample_rate();
+    systemCfgs.block_size  = options.block_size;
+    engine.prepare(systemCfgs);
+
+    const size_t blockSize = systemCfgs.block_size;
+    const int numSpeakers  = engine.getNumOutputs();
+    WavWriter writer(options.output_path, numSpeakers, systemCfgs.sample_rate);
+
+    std::vector<std::vector<float>> fileBlocks(numChannels, std::vector<float>(blockSize));
+    std::vector<std::vector<float>> speakerBlocks(numSpeakers, std::vector<float>(blockSize));
+    std::vector<float*> channels(numChannels);
+    std::vector<const float*> inputs(numSources);
+    std::vector<float*> outputs(numSpeakers);
+    for (int ch = 0; ch < numChannels; ++ch) {
+        channels[ch] = fileBlocks[ch].data();
+    }
+    for (int s = 0; s < numSources; ++s) {
+        inputs[s] = fileBlocks[numChannels == 1 ? 0 : s].data();
+    }
+    for (int ch = 0; ch < numSpeakers; ++ch) {
+        outputs[ch] = speakerBlocks[ch].data();
+    }
+
+    std::printf("rendering %s: %d sources -> %d speakers, block %zu at %zu Hz\n",
+                options.input_path.c_str(), numSources, numSpeakers, blockSize,
+                systemCfgs.sample_rate);
+
+    Clock::duration processing{};
+    const auto start = Clock::now();
+    size_t rendered  = 0;
+    while (running.load() && rendered < reader.get_n_frames()) {
+        // the last block is padded with zeros and cut when written
+        size_t n = reader.read(channels.data(), blockSize);
+
+        auto begin = Clock::now();
+        engine.process(inputs.data(), outputs.data());
+        processing += Clock::now() - begin;
+
+        writer.write(outputs.data(), n);
+        engine.service();
+        rendered += n;
+    }
+    const double elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+
+    if (!writer.close()) {
+        std::fprintf(stderr, "zerr: cannot write %s\n", options.output_path.c_str());
+        return 1;
+    }
+
+    const double seconds = (double)rendered / systemCfgs.sample_rate;
+    const double engineSeconds = std::chrono::duration<double>(processing).count();
+    std::printf("rendered %.2f s in %.3f s: %.1fx real time (engine alone %.1fx)\n", seconds,
+                elapsed, elapsed > 0.0 ? seconds / elapsed : 0.0,
+                engineSeconds > 0.0 ? seconds / engineSeconds : 0.0);
+    engine.printStats();
+    return 0;
+}
@@ -0,0 +1,38 @@
+/**
+ * @file filebackend.h
+ * @author Zeyu Yang (zeyuuyang42@gmail.com)
+ * @brief Backend rendering a WAV file through the engine faster than real time
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2023-2026
+ */
+#ifndef FILEBACKEND_H
+#define FILEBACKEND_H
+
+#include "backend.h"
+
+namespace zerr {
+
+/**
+ * @class FileBackend
+ * @brief Runs the engine on a WAV file without a JACK server
+ *
+ * The input is read through a memory-mapped WavReader: a mono file feeds every source, a file
+ * with one channel per source feeds them in the order of the session. The blocks go through
+ * the same Zerr::process() as with JACK, back to back, and the speaker signals are written to
+ * a 32-bit float WAV file with one channel per speaker. The sample rate is the one of the
+ * input, the block size HostOptions::block_size.
+ *
+ * At the end the backend reports the real-time factor, the duration of the audio divided by
+ * the time the render took. With HostOptions::seeded two renders of the same input and
+ * session produce identical files.
+ */
+class FileBackend : public Backend {
+  public:
+    FileBackend() = default;
+
+    int run(Zerr& engine) override;
+};
+
+} // namespace zerr
+#endif // FILEBACKEND_H
@@ -0,0 +1,233 @@
+/**
+ * @file jackbackend.cpp
+ * @author Zeyu Yang (zeyuuyang42@gmail.com)
+ * @brief Backend running the engine as a JACK client
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2023-2026
+ */
+#include "jackbackend.h"
+
+#include <chrono>
+#include <cstdio>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+#if defined(__linux__) || defined(__APPLE__)
+#include <sys/mman.h>
+#endif
+
+#include "tracer.h"
+
+using namespace zerr;
+
+void JackBackend::_open()
+{
+    const HostOptions& options = engine->getOptions();
+
+    jack_status_t status;
+    client = jack_client_open(options.client_name.c_str(), JackNoStartServer, &status);
+    if (!client) {
+        throw std::runtime_error("cannot connect to the JACK server");
+    }
+
+    systemCfgs.sample_rate = jack_get_sample_rate(client);
+    systemCfgs.block_size  = jack_get_buffer_size(client);
+    engine->prepare(systemCfgs);
+
+    for (int s = 0; s < engine->getNumInputs(); ++s) {
+        const std::string& name = engine->getInputName(s);
+        jack_port_t* port       = jack_port_register(client, name.c_str(),
+                                                     JACK_DEFAULT_AUDIO_TYPE, JackPortIsInput, 0);
+        if (!port) {
+            throw std::runtime_error("cannot register the input port " + name);
+        }
+        inputPorts.push_back(port);
+    }
+    for (int ch = 0; ch < engine->getNumOutputs(); ++ch) {
+        std::string name  = "speaker_" + std::to_string(ch + 1);
+        jack_port_t* port = jack_port_register(client, name.c_str(), JACK_DEFAULT_AUDIO_TYPE,
+                                               JackPortIsOutput, 0);
+        if (!port) {
+            throw std::runtime_error("cannot register the output port " + name);
+        }
+        outputPorts.push_back(port);
+    }
+    inputs.resize(inputPorts.size());
+    outputs.resize(outputPorts.size());
+
+    jack_set_process_callback(client, callbackProcess, this);
+    jack_set_buffer_size_callback(client, callbackBufferSize, this);
+    jack_set_xrun_callback(client, callbackXrun, this);
+    jack_set_freewheel_callback(client, callbackFreewheel, this);
+    jack_on_shutdown(client, callbackShutdown, this);
+
+    _lockMemory();
+
+    std::printf("%s: %d sources -> %d speakers, block %zu at %zu Hz%s\n",
+                jack_get_client_name(client), engine->getNumInputs(), engine->getNumOutputs(),
+                systemCfgs.block_size, systemCfgs.sample_rate,
+                jack_is_realtime(client) ? ", real-time" : "");
+}
+
+void JackBackend::_lockMemory()
+{
+#if defined(__linux__) || defined(__APPLE__)
+    // page faults in the process callback would block it on the disk
+    if (mlockall(MCL_CURRENT | MCL_FUTURE) != 0) {
+        std::fprintf(stderr, "zerr: cannot lock the memory, raise the memlock limit to avoid "
+                             "page faults in the audio thread\n");
+    }
+#endif
+}
+
+int JackBackend::callbackProcess(jack_nframes_t nframes, void* object)
+{
+    return static_cast<JackBackend*>(object)->process(nframes);
+}
+
+int JackBackend::callbackBufferSize(jack_nframes_t nframes, void* object)
+{
+    JackBackend* self = static_cast<JackBackend*>(object);
+    if (nframes == self->systemCfgs.block_size) {
+        return 0;
+    }
+    // JACK does not call process() while the buffer size changes
+    self->systemCfgs.block_size = nframes;
+    try {
+        self->engine->prepare(self->systemCfgs);
+    }
+    catch (const std::exception& e) {
+        std::fprintf(stderr, "zerr: cannot rebuild the chain for %u frames: %s\n", nframes,
+                     e.what());
+        self->stop();
+        return 1;
+    }
+    return 0;
+}
+
+int JackBackend::callbackXrun(void* object)
+{
+    JackBackend* self = static_cast<JackBackend*>(object);
+    self->xruns.fetch_add(1, std::memory_order_relaxed);
+    Tracer::instance().mark_xrun();
+    return 0;
+}
+
+void JackBackend::callbackFreewheel(int starting, void* object)
+{
+    JackBackend* self = static_cast<JackBackend*>(object);
+    // a render counts its length from the first freewheeling block
+    if (starting) {
+        self->framesProcessed.store(0);
+    }
+    self->freewheeling.store(starting != 0);
+}
+
+void JackBackend::callbackShutdown(void* object)
+{
+    JackBackend* self = static_cast<JackBackend*>(object);
+    self->shutdown.store(true);
+    self->stop();
+}
+
+int JackBackend::process(jack_nframes_t nframes)
+{
+    for (size_t s = 0; s < inputPorts.size(); ++s) {
+        inputs[s] = static_cast<const float*>(jack_port_get_buffer(inputPorts[s], nframes));
+    }
+    for (size_t ch = 0; ch < outputPorts.size(); ++ch) {
+        outputs[ch] = static_cast<float*>(jack_port_get_buffer(outputPorts[ch], nframes));
+    }
+    engine->process(inputs.data(), outputs.data());
+
+    framesProcessed.fetch_add(nframes, std::memory_order_relaxed);
+    return 0;
+}
+
+void JackBackend::_connectPorts()
+{
+    const auto& inputConnections = engine->getInputConnections();
+    for (size_t s = 0; s < inputPorts.size() && s < inputConnections.size(); ++s) {
+        if (jack_connect(client, inputConnections[s].c_str(), jack_port_name(inputPorts[s]))) {
+            std::fprintf(stderr, "zerr: cannot connect %s\n", inputConnections[s].c_str());
+        }
+    }
+    const std::string& outputConnection = engine->getOutputConnection();
+    if (outputConnection.empty()) {
+        return;
+    }
+    for (size_t ch = 0; ch < outputPorts.size(); ++ch) {
+        std::string port = outputConnection + std::to_string(ch + 1);
+        if (jack_connect(client, jack_port_name(outputPorts[ch]), port.c_str())) {
+            std::fprintf(stderr, "zerr: cannot connect %s\n", port.c_str());
+        }
+    }
+}
+
+int JackBackend::run(Zerr& engine)
+{
+    this->engine               = &engine;
+    const HostOptions& options = engine.getOptions();
+
+    _open();
+    if (jack_activate(client)) {
+        std::fprintf(stderr, "zerr: cannot activate the client\n");
+        return 1;
+    }
+    if (options.connect) {
+        _connectPorts();
+    }
+
+    const bool render = options.freewheel_seconds > 0.0;
+    const uint64_t renderFrames =
+        (uint64_t)(options.freewheel_seconds * systemCfgs.sample_rate);
+    if (render) {
+        // the whole graph runs as fast as possible, recorders see the same blocks as live
+        if (jack_set_freewheel(client, 1)) {
+            std::fprintf(stderr, "zerr: cannot enter freewheel mode\n");
+            return 1;
+        }
+        std::printf("rendering %.1f s in freewheel mode...\n", options.freewheel_seconds);
+    }
+    else {
+        std::printf("running, press Ctrl+C to stop\n");
+    }
+
+    auto lastStatus = std::chrono::steady_clock::now();
+    while (running.load()) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(render ? 10 : 100));
+        engine.service();
+
+        if (render && freewheeling.load() && framesProcessed.load() >= renderFrames) {
+            break;
+        }
+        auto now = std::chrono::steady_clock::now();
+        if (!render && now - lastStatus >= std::chrono::seconds(1)) {
+            lastStatus = now;
+            std::printf("cpu %5.1f%%, %llu xruns\n", jack_cpu_load(client),
+                        (unsigned long long)xruns.load());
+            engine.printStats();
+        }
+    }
+
+    if (render) {
+        jack_set_freewheel(client, 0);
+        std::printf("rendered %.1f s\n", (double)framesProcessed.load() / systemCfgs.sample_rate);
+    }
+    if (shutdown.load()) {
+        std::fprintf(stderr, "zerr: the JACK server closed the client\n");
+        client = nullptr;
+        return 1;
+    }
+    return 0;
+}
+
+JackBackend::~JackBackend()
+{
+    if (client) {
+        jack_deactivate(client);
+        jack_client_close(client);
+    }
+}
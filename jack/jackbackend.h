@@ -0,0 +1,72 @@
+/**
+ * @file jackbackend.h
+ * @author Zeyu Yang (zeyuuyang42@gmail.com)
+ * @brief Backend running the engine as a JACK client
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2023-2026
+ */
+#ifndef JACKBACKEND_H
+#define JACKBACKEND_H
+
+#include <jack/jack.h>
+
+#include <atomic>
+#include <vector>
+
+#include "backend.h"
+
+namespace zerr {
+
+/**
+ * @class JackBackend
+ * @brief Runs the engine in the process callback of a JACK client
+ *
+ * The client has one input port per source and one output port per speaker. The engine is
+ * prepared and its memory locked before the client is activated, so the process callback
+ * only hands the port buffers to Zerr::process(). A change of the JACK buffer size prepares
+ * the engine again in the buffer size callback, while JACK does not call process().
+ *
+ * With HostOptions::freewheel_seconds the backend switches the server to freewheel mode,
+ * which runs the whole graph as fast as possible, and returns after that much audio.
+ */
+class JackBackend : public Backend {
+  public:
+    JackBackend() = default;
+    ~JackBackend() override;
+
+    int run(Zerr& engine) override;
+
+  private:
+    Zerr* engine          = nullptr;
+    jack_client_t* client = nullptr;
+    SystemConfigs systemCfgs{};
+
+    std::vector<jack_port_t*> inputPorts;
+    std::vector<jack_port_t*> outputPorts;
+    std::vector<const float*> inputs; /**< Port buffers of the current block */
+    std::vector<float*> outputs;      /**< Port buffers of the current block */
+
+    std::atomic<bool> freewheeling{false};
+    std::atomic<uint64_t> xruns{0};
+    std::atomic<uint64_t> framesProcessed{0};
+    std::atomic<bool> shutdown{false}; /**< The server closed the client */
+
+    static int callbackProcess(jack_nframes_t nframes, void* object);
+    static int callbackBufferSize(jack_nframes_t nframes, void* object);
+    static int callbackXrun(void* object);
+    static void callbackFreewheel(int starting, void* object);
+    static void callbackShutdown(void* object);
+
+    /**
+     * @brief Run the engine on the port buffers of one block, real-time safe
+     */
+    int process(jack_nframes_t nframes);
+
+    void _open();
+    void _connectPorts();
+    void _lockMemory();
+};
+
+} // namespace zerr
+#endif // JACKBACKEND_H
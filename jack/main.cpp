@@ -1,49 +1,138 @@
+/**
+ * @file main.cpp
+ * @author Zeyu Yang (zeyuuyang42@gmail.com)
+ * @brief Command line entry of the Zerr* host
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2023-2026
+ *
+ *     run_zerr -c session.yaml [--name zerr] [--stats] [--trace xrun.json]
+ *     run_zerr -c session.yaml --freewheel 60
+ *     run_zerr -c session.yaml --input in.wav --output speakers.wav --seed 1
+ */
 #include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <stdexcept>
+#include <string>
 
+#include "filebackend.h"
+#ifdef ZERR_JACK
+#include "jackbackend.h"
+#endif
 #include "zerr.h"
 
 using namespace zerr;
-// spkrCfgFile
-// "/Users/yangzeyu/Downloads/Zerr/configs/spkr_configs/circulation_8.yaml"
-// zerrCfgFile
-// "/Users/yangzeyu/Downloads/Zerr/configs/zerr_configs/preset1.yaml"
-// ./run_zerr -z
-// "/Users/yangzeyu/Downloads/Zerr/configs/zerr_configs/preset1.yaml" -s
-// "/Users/yangzeyu/Downloads/Zerr/configs/spkr_configs/circulation_8.yaml"
 
-Zerr* zerr_client;  // define the zerr_client ptr here to make handleSignal
-                    // access it easier
+namespace {
 
-void handleSignal(int signal) {
-    std::cout << "Received keyboard interrupt. Stopping Zerr..." << std::endl;
+Backend* backend = nullptr; // the signal handler asks the backend to stop
 
-    delete zerr_client;
-
-    std::exit(signal);
+void handleSignal(int)
+{
+    if (backend) {
+        backend->stop();
+    }
 }
 
-int main(int argc, char* argv[]) {
-    // std::signal(SIGINT, handleSignal);
+void usage()
+{
+    std::printf(
+        "usage: run_zerr -c <session.yaml> [options]\n"
+        "  -c, --session <yaml>  session with the speaker layout and the sources\n"
+        "  --name <name>         JACK client name (the session name or zerr)\n"
+        "  --no-connect          do not make the connections listed in the session\n"
+        "  --stats               print the load of every module once per second\n"
+        "  --trace <file>        write a Chrome trace on every xrun (core built with tracing)\n"
+        "  --freewheel <s>       render s seconds in JACK freewheel mode, then quit\n"
+        "  --input <wav>         render a file instead of running on JACK, mono or one\n"
+        "                        channel per source\n"
+        "  --output <wav>        speaker signals of the render (speakers.wav)\n"
+        "  --block <n>           block size of the render, at most 2048 (64)\n"
+        "  --seed <n>            seed the random speaker selection for reproducible output\n");
+}
 
-    std::string zerrCfgFile;
-    std::string spkrCfgFile;
+bool parse(int argc, char** argv, HostOptions& options)
+{
+    for (int i = 1; i < argc; ++i) {
+        std::string arg   = argv[i];
+        const char* value = i + 1 < argc ? argv[i + 1] : nullptr;
 
-    // Display each command-line argument.
-    std::cout << "\nCommand-line arguments:\n";
-    for (int i = 1; i < (argc - 1); i++) {
-        if (std::string(argv[i]) == "-z") {
-            std::cout << "zerr configs: " << " " << argv[i + 1] << std::endl;
-            zerrCfgFile = argv[i + 1];
+        if (arg == "--stats") {
+            options.stats = true;
+            continue;
+        }
+        if (arg == "--no-connect") {
+            options.connect = false;
+            continue;
         }
-        if (std::string(argv[i]) == "-s") {
-            std::cout << "spkr configs: " << " " << argv[i + 1] << std::endl;
-            spkrCfgFile = argv[i + 1];
+        if (!value) {
+            return false;
         }
+        ++i;
+        if (arg == "-c" || arg == "--session")
+            options.session = value;
+        else if (arg == "--name")
+            options.client_name = value;
+        else if (arg == "--trace")
+            options.trace_path = value;
+        else if (arg == "--freewheel")
+            options.freewheel_seconds = std::atof(value);
+        else if (arg == "--input")
+            options.input_path = value;
+        else if (arg == "--output")
+            options.output_path = value;
+        else if (arg == "--block")
+            options.block_size = std::strtoul(value, nullptr, 10);
+        else if (arg == "--seed") {
+            options.seeded = true;
+            options.seed   = (unsigned int)std::strtoul(value, nullptr, 10);
+        }
+        else
+            return false;
+    }
+    if (!options.input_path.empty() && options.output_path.empty()) {
+        options.output_path = "speakers.wav";
+    }
+    return !options.session.empty();
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    HostOptions options;
+    if (!parse(argc, argv, options)) {
+        usage();
+        return 1;
     }
 
-    zerr_client = new Zerr(zerrCfgFile, spkrCfgFile);
-    zerr_client->initialize();
-    zerr_client->run();
+    int result = 1;
+    try {
+        Zerr engine(options);
+
+        std::unique_ptr<Backend> driver;
+        if (!options.input_path.empty()) {
+            driver = std::make_unique<FileBackend>();
+        }
+        else {
+#ifdef ZERR_JACK
+            driver = std::make_unique<JackBackend>();
+#else
+            throw std::runtime_error("built without JACK, render a file with --input");
+#endif
+        }
+
+        backend = driver.get();
+        std::signal(SIGINT, handleSignal);
+        std::signal(SIGTERM, handleSignal);
 
-    return 0;
+        result  = driver->run(engine);
+        backend = nullptr;
+    }
+    catch (const std::exception& e) {
+        std::fprintf(stderr, "zerr: %s\n", e.what());
+    }
+    return result;
 }
@@ -1,181 +1,345 @@
+/**
+ * @file zerr.cpp
+ * @author Zeyu Yang (zeyuuyang42@gmail.com)
+ * @brief Engine of the Zerr* host, the chain of several sources described in a session file
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2023-2026
+ */
 #include "zerr.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <stdexcept>
+
+#include "tracer.h"
+
 using namespace zerr;
 
-Zerr::Zerr(std::string zerrCfgFile, std::string spkrCfgFile) {
-    zerr_cfg = zerrCfgFile;
-    spkr_cfg = spkrCfgFile;
+namespace {
+
+/**
+ * @brief Resolve a path of the session relative to the directory of the session file
+ */
+std::string resolvePath(const std::string& session, const std::string& path)
+{
+    if (path.empty() || path[0] == '/') {
+        return path;
+    }
+    size_t slash = session.find_last_of('/');
+    return slash == std::string::npos ? path : session.substr(0, slash + 1) + path;
 }
 
-void Zerr::initialize() {
-    _initialize_audioclient();
-    _initialize_zerr();
+} // namespace
+
+Zerr::Zerr(HostOptions options)
+    : options(std::move(options))
+{
+    _loadSession();
 }
 
-void Zerr::run() {
-    jack_activate(this->client);
-    jack_connect(client, "system:capture_1", jack_port_name(input_port[0]));
+void Zerr::_loadSession()
+{
+    YAML::Node session;
+    try {
+        session = YAML::LoadFile(options.session);
+    }
+    catch (const YAML::Exception& e) {
+        throw std::runtime_error("cannot read the session " + options.session + ": " + e.what());
+    }
 
-    std::string system_playback_name;
-    for (int i = 0; i < nOutputs; ++i) {
-        system_playback_name =
-            "system:playback_" +
-            std::to_string(i + nInputs + 1);  //+nInputs to avoid feedback loop
-        // system_playback_name = "BlackHole 64ch:playback_" +
-        // std::to_string(i+nInputs+1); //+nInputs to avoid feedback loop
-        jack_connect(client, jack_port_name(output_port[i]),
-                     system_playback_name.c_str());
+    if (!session["layout"]) {
+        throw std::runtime_error("the session has no speaker layout");
     }
+    layout = resolvePath(options.session, session["layout"].as<std::string>());
 
-    _hold();  // run forever
-}
+    const YAML::Node& sourceNodes = session["sources"];
+    if (!sourceNodes || !sourceNodes.IsSequence() || sourceNodes.size() == 0) {
+        throw std::runtime_error("the session has no sources");
+    }
+    for (const auto& node : sourceNodes) {
+        SourceSettings source;
+        source.name = node["name"] ? node["name"].as<std::string>()
+                                   : "source_" + std::to_string(sessionSources.size() + 1);
+        source.features = node["features"].as<FeatureNames>(FeatureNames{});
+        if (node["combination"]) {
+            source.combination = node["combination"].as<std::string>();
+        }
+        if (node["bus"]) {
+            source.bus = node["bus"].as<std::string>();
+        }
+        if (!node["envelopes"] || node["envelopes"].size() == 0) {
+            throw std::runtime_error("source |" + source.name + "| has no envelopes");
+        }
+        for (const auto& envelope : node["envelopes"]) {
+            source.envelopes.push_back(_parseEnvelope(envelope, source.features));
+        }
+        sessionSources.push_back(std::move(source));
+    }
 
-void Zerr::_hold() {
-    std::cout << "\nZerr is listening...\nPress Ctrl+C to stop..." << std::endl;
+    if (const YAML::Node& connect = session["connect"]) {
+        if (connect["inputs"]) {
+            inputConnections = connect["inputs"].as<std::vector<std::string>>();
+        }
+        if (connect["outputs"]) {
+            outputConnection = connect["outputs"].as<std::string>();
+        }
+    }
 
-    auto startTime = std::chrono::steady_clock::now();  // Get the starting time
+    if (options.client_name.empty()) {
+        options.client_name = session["name"] ? session["name"].as<std::string>() : "zerr";
+    }
 
-    while (true) {
-        auto currentTime =
-            std::chrono::steady_clock::now();  // Get the current time
-        auto elapsedTime = std::chrono::duration_cast<std::chrono::seconds>(
-            currentTime - startTime);  // Calculate elapsed time in seconds
+    if (!options.trace_path.empty()) {
+#ifndef ZERR_TRACING
+        std::fprintf(stderr, "zerr: the core was built without ZERR_CORE_TRACING, the trace "
+                             "only shows the xruns\n");
+#endif
+        Tracer::instance().start();
+    }
+}
 
-        std::cout << "\rRunning time: " << elapsedTime.count() << " seconds"
-                  << std::flush;
+Zerr::EnvelopeSettings Zerr::_parseEnvelope(const YAML::Node& node,
+                                            const FeatureNames& features) const
+{
+    EnvelopeSettings envelope;
+    envelope.mode = node["mode"] ? node["mode"].as<std::string>() : "trigger";
+    if (envelope.mode != "trigger" && envelope.mode != "trajectory") {
+        throw std::runtime_error("unknown envelope mode |" + envelope.mode + "|");
+    }
 
-        // Delay for a short period to avoid excessive output
-        std::this_thread::sleep_for(std::chrono::seconds(1));
+    // a spread of zero would silence all but one speaker, a volume of zero everything
+    const char* names[3]     = {"main", "spread", "volume"};
+    const Sample defaults[3] = {0.0, 0.5, 1.0};
+    for (int i = 0; i < 3; ++i) {
+        if (node[names[i]]) {
+            envelope.controls[i] = _parseControl(node[names[i]], features);
+        }
+        else if (i == 0) {
+            throw std::runtime_error("an envelope of mode |" + envelope.mode +
+                                     "| has no main input");
+        }
+        else {
+            envelope.controls[i].value = defaults[i];
+        }
     }
+    return envelope;
 }
 
-void Zerr::_get_feature_names() {
-    feature_names.clear();
-    YAML::Node featureNode = zerrNode["features"];
-    int cnt = 0;
-    for (auto it = featureNode.begin(); it != featureNode.end(); ++it) {
-        YAML::Node value = it->second;
+Zerr::Control Zerr::_parseControl(const YAML::Node& node, const FeatureNames& features) const
+{
+    Control control;
+    std::string feature;
+    if (node.IsMap()) {
+        feature       = node["feature"].as<std::string>("");
+        control.scale = node["scale"].as<Sample>(1.0);
+        control.value = node["offset"].as<Sample>(0.0);
+    }
+    else {
+        // a scalar is a constant if it parses as a number, otherwise a feature name
+        Sample value;
+        if (YAML::convert<Sample>::decode(node, value)) {
+            control.value = value;
+            return control;
+        }
+        feature = node.as<std::string>();
+    }
 
-        std::string name = value["name"].as<std::string>();
-        feature_names.push_back(name);
-        cnt++;
+    auto it = std::find(features.begin(), features.end(), feature);
+    if (it == features.end()) {
+        throw std::runtime_error("feature |" + feature + "| is not extracted by its source");
     }
+    control.feature = (int)(it - features.begin());
+    return control;
 }
 
-void Zerr::_initialize_zerr() {
-    std::cout << "initialize zerr..." << std::endl;
+void Zerr::prepare(SystemConfigs systemCfgs)
+{
+    this->systemCfgs = systemCfgs;
+    _buildChain();
+
+    if (options.seeded) {
+        unsigned int seed = options.seed;
+        for (auto& source : sources) {
+            for (auto& generator : source.generators) {
+                generator->setSeed(seed++);
+            }
+        }
+    }
 
-    zerrNode = YAML::LoadFile(zerr_cfg);
-    _get_feature_names();
+    // the feature banks need a few frames before every resolution has been analysed, and
+    // lazy first-use work of the modules should not happen in the first real block
+    for (auto& source : sources) {
+        source.input.fill(0.0);
+    }
+    for (int n = 0; n < 8; ++n) {
+        _perform();
+    }
 
-    bank.initialize(feature_names, sys_cfg);
+}
 
-#ifdef TESTMODE
-    bank.print_all_features();
-    bank.print_active_features();
-#endif  // TESTMODE
+void Zerr::_buildChain()
+{
+    sources.clear();
+    sources.reserve(sessionSources.size());
 
-    gen.initialize(feature_names.size(), "bypass");
-    mapper.initialize(spkr_cfg);
-    router.initialize(sys_cfg.block_size, mapper.get_n_speaker());
-}
+    const size_t blockSize = systemCfgs.block_size;
+    for (const auto& settings : sessionSources) {
+        Source source;
 
-void Zerr::_initialize_audioclient() {
-    std::cout << "initialize audioclient..." << std::endl;
-    client = jack_client_open("zerr", JackNullOption, &status, NULL);
-    // assert(client && "Creating Client Failed");
+        source.bank = std::make_unique<FeatureBank>();
+        source.bank->initialize(settings.features, systemCfgs);
+        // the banks of the previous chain are gone, so the bus names are free again
+        if (!settings.bus.empty()) {
+            source.bank->publish(settings.bus);
+        }
 
-#ifdef TESTMODE
-    sys_cfg.sample_rate = static_cast<size_t>(jack_get_sample_rate(client));
-    sys_cfg.block_size = static_cast<size_t>(jack_get_buffer_size(client));
-    std::cout << "sys_cfg.sample_rate -- " << sys_cfg.sample_rate << std::endl;
-    std::cout << "sys_cfg.block_size  -- " << sys_cfg.block_size << std::endl;
-#endif  // TESTMODE
+        for (const auto& envelope : settings.envelopes) {
+            auto generator = std::make_unique<EnvelopeGenerator>(systemCfgs, layout, envelope.mode);
+            if (!generator->initialize()) {
+                throw std::runtime_error("cannot load the speaker layout " + layout);
+            }
+            // the messages of perform() are printed by service()
+            generator->setLogDeferred(true);
+            source.generators.push_back(std::move(generator));
+        }
 
-    // const char** ports = jack_get_ports(client, nullptr, nullptr,
-    // JackPortIsPhysical);
+        numSpeakers = source.generators[0]->getNumSpeakers();
+        if (numSpeakers > MAX_SPEAKERS) {
+            throw std::runtime_error("the layout has more than " + std::to_string(MAX_SPEAKERS) +
+                                     " speakers");
+        }
+        const int numSets = (int)source.generators.size();
 
-    // for (int i = 0; ports[i] != nullptr; ++i) {
-    //     std::cout << ports[i] << std::endl;
-    // }
+        source.combinator = std::make_unique<EnvelopeCombinator>(numSets, numSpeakers, systemCfgs,
+                                                                 settings.combination);
+        source.disperser  = std::make_unique<AudioDisperser>(numSpeakers, systemCfgs);
+        if (!source.combinator->initialize() || !source.disperser->initialize()) {
+            throw std::runtime_error("cannot set up the chain of source |" + settings.name + "|");
+        }
 
-    jack_set_process_callback(this->client, this->callback_process, this);
+        source.input.resize(1, blockSize);
+        source.control.resize(3, blockSize);
+        source.envelopes.resize(numSets * numSpeakers, blockSize);
+        source.dispersed.resize(numSpeakers + 1, blockSize);
 
-    // allocate jack input ports
-    input_port = new jack_port_t *[nInputs];
-    for (int i = 0; i < nInputs; i++) {
-        std::string tmp_str = "input_" + std::to_string(i + 1);
-        input_port[i] =
-            jack_port_register(client, tmp_str.c_str(), JACK_DEFAULT_AUDIO_TYPE,
-                               JackPortIsInput, 0);
+        sources.push_back(std::move(source));
     }
 
-    // allocate jack output ports
-    output_port = new jack_port_t *[nOutputs];
-    for (int i = 0; i < nOutputs; i++) {
-        std::string tmp_str = "output_" + std::to_string(i + 1);
-        output_port[i] =
-            jack_port_register(client, tmp_str.c_str(), JACK_DEFAULT_AUDIO_TYPE,
-                               JackPortIsOutput, 0);
+    for (auto& source : sources) {
+        source.bank->get_load_meter().set_enabled(options.stats);
+        for (auto& generator : source.generators) {
+            generator->getLoadMeter().set_enabled(options.stats);
+        }
+        source.combinator->get_load_meter().set_enabled(options.stats);
+        source.disperser->get_load_meter().set_enabled(options.stats);
     }
-
-    out = new jack_default_audio_sample_t *[nOutputs];
-    in = new jack_default_audio_sample_t *[nInputs];
-}
-
-int Zerr::callback_process(jack_nframes_t x, void *object) {
-    return static_cast<Zerr *>(object)->process(x);
 }
 
-int Zerr::process(jack_nframes_t nframes) {
-    // get input buffers
-    for (int i = 0; i < nInputs; i++)
-        in[i] = (jack_default_audio_sample_t *)jack_port_get_buffer(
-            this->input_port[i], jack_get_buffer_size(client));
+void Zerr::process(const float* const* inputs, float* const* outputs)
+{
+    const size_t blockSize = systemCfgs.block_size;
 
-    // get output buffers
-    for (int i = 0; i < nOutputs; i++)
-        out[i] = (jack_default_audio_sample_t *)jack_port_get_buffer(
-            this->output_port[i], jack_get_buffer_size(client));
-
-    // set output buffer "0.0"
-    for (int chanCNT = 0; chanCNT < nOutputs; chanCNT++) {
-        for (int sampCNT = 0; sampCNT < nframes; sampCNT++)
-            out[chanCNT][sampCNT] = 0.0;
+    for (size_t s = 0; s < sources.size(); ++s) {
+        std::copy(inputs[s], inputs[s] + blockSize, sources[s].input.channel(0));
     }
 
-    for (int chanCNT = 0; chanCNT < nOutputs; chanCNT++) {
-        for (int sampCNT = 0; sampCNT < nframes; sampCNT++) {
-            out[chanCNT][sampCNT] = in[0][sampCNT];
+    _perform();
+
+    for (int ch = 0; ch < numSpeakers; ++ch) {
+        float* out = outputs[ch];
+        std::fill(out, out + blockSize, 0.0f);
+        for (const auto& source : sources) {
+            const Sample* speaker = source.output->channel(ch);
+            for (size_t i = 0; i < blockSize; ++i) {
+                out[i] += (float)speaker[i];
+            }
         }
     }
+}
 
-    t_blockIn targetData(in[0], in[0] + nframes);
-
-    bank.fetch(targetData);
-    bank.process();
-
-    gen.fetch(bank.send());
-    gen.process();
-
-    mapper.fetch(gen.send());
-    mapper.process();
-
-    router.fetch(targetData, mapper.send());
-    router.process();
+void Zerr::_perform()
+{
+    const size_t blockSize = systemCfgs.block_size;
+
+    for (size_t s = 0; s < sources.size(); ++s) {
+        Source& source        = sources[s];
+        const FeaturesVals& y = source.bank->perform(source.input);
+
+        for (size_t g = 0; g < source.generators.size(); ++g) {
+            const EnvelopeSettings& settings = sessionSources[s].envelopes[g];
+            for (int c = 0; c < 3; ++c) {
+                const Control& control = settings.controls[c];
+                Sample* control_out    = source.control.channel(c);
+                if (control.feature < 0) {
+                    std::fill(control_out, control_out + blockSize, control.value);
+                    continue;
+                }
+                const FeatureVals& values = y[control.feature];
+                for (size_t i = 0; i < blockSize; ++i) {
+                    control_out[i] = values[i] * control.scale + control.value;
+                }
+            }
+
+            // the combinator expects channel ch of set g at ch + g * numSpeakers
+            const PlanarBuffer& env = source.generators[g]->perform(source.control);
+            for (int ch = 0; ch < numSpeakers; ++ch) {
+                std::copy(env.channel(ch), env.channel(ch) + blockSize,
+                          source.envelopes.channel(ch + g * numSpeakers));
+            }
+        }
 
-    output_buffer = router.send();
+        const PlanarBuffer& combined = source.combinator->perform(source.envelopes);
+        std::copy(source.input.channel(0), source.input.channel(0) + blockSize,
+                  source.dispersed.channel(0));
+        for (int ch = 0; ch < numSpeakers; ++ch) {
+            std::copy(combined.channel(ch), combined.channel(ch) + blockSize,
+                      source.dispersed.channel(ch + 1));
+        }
+        source.output = &source.disperser->perform(source.dispersed);
+    }
+}
 
-    for (int chanCNT = 0; chanCNT < nOutputs; chanCNT++) {
-        for (int sampCNT = 0; sampCNT < nframes; sampCNT++) {
-            out[chanCNT][sampCNT] = static_cast<jack_default_audio_sample_t>(
-                output_buffer[chanCNT][sampCNT]);
+void Zerr::service()
+{
+    for (auto& source : sources) {
+        for (auto& generator : source.generators) {
+            if (generator->hasPendingLog()) {
+                generator->flushLog();
+            }
         }
     }
+    if (!options.trace_path.empty()) {
+        Tracer::instance().dump_xrun(options.trace_path);
+    }
+}
 
-    return 0;
+void Zerr::printStats()
+{
+    if (!options.stats) {
+        return;
+    }
+    for (size_t s = 0; s < sources.size(); ++s) {
+        const Source& source = sources[s];
+        const char* name     = sessionSources[s].name.c_str();
+        std::printf("  %s features:   %s\n", name,
+                    source.bank->get_load_meter().report().c_str());
+        for (size_t g = 0; g < source.generators.size(); ++g) {
+            std::printf("  %s envelopes %zu: %s\n", name, g + 1,
+                        source.generators[g]->getLoadMeter().report().c_str());
+        }
+        std::printf("  %s combinator: %s\n", name,
+                    source.combinator->get_load_meter().report().c_str());
+        std::printf("  %s disperser:  %s\n", name,
+                    source.disperser->get_load_meter().report().c_str());
+    }
+    std::fflush(stdout);
 }
 
-Zerr::~Zerr() {
-    jack_deactivate(client);
-    jack_client_close(client);
-}
\ No newline at end of file
+Zerr::~Zerr()
+{
+    if (!options.trace_path.empty()) {
+        Tracer::instance().stop();
+        Tracer::instance().write_json(options.trace_path);
+    }
+}
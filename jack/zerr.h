@@ -1,82 +1,185 @@
+/**
+ * @file zerr.h
+ * @author Zeyu Yang (zeyuuyang42@gmail.com)
+ * @brief Engine of the Zerr* host, the chain of several sources described in a session file
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2023-2026
+ */
 #ifndef ZERR_H
 #define ZERR_H
 
-// dependencies
-#include "configs.h"
-#include "types.h"
-#include "utils.h"
+#include <memory>
+#include <string>
+#include <vector>
 
-// modules
-#include <jack/jack.h>
+#include <yaml-cpp/yaml.h>
 
-#include "audiorouter.h"
+#include "audiodisperser.h"
+#include "envelopecombinator.h"
+#include "envelopegenerator.h"
 #include "featurebank.h"
-#include "mapper.h"
-#include "trajectorygenerator.h"
+#include "planarbuffer.h"
+#include "types.h"
 
 namespace zerr {
 
+/**
+ * @brief Options of the host given on the command line
+ */
+struct HostOptions {
+    std::string session;          /**< Session file */
+    std::string client_name;      /**< JACK client name, the session name by default */
+    std::string trace_path;       /**< Write a Chrome trace on every xrun, needs ZERR_TRACING */
+    double freewheel_seconds = 0; /**< Render this long in freewheel mode and quit, 0 runs live */
+    bool stats               = false; /**< Print the load of the modules */
+    bool connect             = true;  /**< Make the connections listed in the session */
+
+    std::string input_path;  /**< Render this WAV file instead of running on JACK */
+    std::string output_path; /**< WAV file receiving the speaker signals of a file render */
+    size_t block_size = 64;  /**< Block size of a file render */
+
+    bool seeded       = false; /**< Whether the random speaker selection uses seed */
+    unsigned int seed = 0;     /**< Seed of the first generator, the others count up from it */
+};
+
+/**
+ * @class Zerr
+ * @brief Engine spatialising N sources with their own features and envelopes
+ *
+ * The session file lists the speaker layout and the sources. Every source has an input,
+ * a FeatureBank and one or more EnvelopeGenerators, each driven by the features of the
+ * source. The envelopes of a source are merged by an EnvelopeCombinator and applied to its
+ * signal by an AudioDisperser, and the dispersed sources are summed into the speakers:
+ *
+ *     layout: ring_8.yaml            # relative to the session file
+ *     sources:
+ *       - name: voice
+ *         features: [osf, ctd@1024/256, rms]
+ *         bus: voice                 # optional, publish the features, see featurebus.h
+ *         combination: max           # add, root or max, when there are several envelopes
+ *         envelopes:
+ *           - mode: trigger
+ *             main: osf              # feature name, number, or {feature, scale, offset}
+ *             spread: 0.4
+ *             volume: {feature: rms, scale: 4.0}
+ *     connect:
+ *       inputs: [system:capture_1]   # one port per source
+ *       outputs: system:playback_    # prefix, numbered from 1
+ *
+ * The engine does not know where its audio comes from: a Backend calls prepare() with the
+ * sample rate and block size, and then process() once per block. Everything is built in
+ * prepare(), process() only copies the blocks and runs the chain on preallocated memory.
+ */
 class Zerr {
   public:
+    static constexpr int MAX_SPEAKERS = 256; /**< Outputs the engine can address */
+
     /**
-     * setup configs files and
+     * @brief Read the session, throws if it is invalid
+     * @param options Command line options
      */
-    Zerr(std::string zerrCfgFile, std::string spkrCfgFile);
+    explicit Zerr(HostOptions options);
     /**
-     * initialize all zerr modules and the audio clients
+     * @brief Build the chain for a sample rate and block size, not real-time safe
+     * @param systemCfgs Sample rate and block size of the following process() calls
      */
-    void initialize();
+    void prepare(SystemConfigs systemCfgs);
     /**
-     * activate the audioclient and zerr callback
-     * run it forever till user interrupted
+     * @brief Process one block, real-time safe
+     * @param inputs One block of block_size samples per source
+     * @param outputs One block of block_size samples per speaker, overwritten
      */
-    void run();
+    void process(const float* const* inputs, float* const* outputs);
+    /**
+     * @brief Print deferred log messages and write a pending xrun trace, not real-time safe
+     */
+    void service();
+    /**
+     * @brief Print the load of every module, if enabled with HostOptions::stats
+     */
+    void printStats();
+
+    int getNumInputs() const { return (int)sessionSources.size(); }
+    int getNumOutputs() const { return numSpeakers; }
+    const std::string& getInputName(int index) const { return sessionSources[index].name; }
+    const HostOptions& getOptions() const { return options; }
+    const std::vector<std::string>& getInputConnections() const { return inputConnections; }
+    const std::string& getOutputConnection() const { return outputConnection; }
 
     ~Zerr();
 
+    Zerr(const Zerr&)            = delete;
+    Zerr& operator=(const Zerr&) = delete;
+
   private:
-    // basic config
-    std::vector<t_blockIn> output_buffer;
-    t_systemConfigs sys_cfg;
-    // t_featureNameList feature_names = {"Centroid", "RMSAmplitude"};// move
-    // this to zerr YAML file
-    t_featureNameList feature_names;
-
-    // config path
-    std::string zerr_cfg;
-    std::string spkr_cfg;
-
-    YAML::Node zerrNode;
-
-    // module objects
-    FeatureBank bank;
-    TrajectoryGenerator gen;
-    Mapper mapper;
-    AudioRouter router;
-
-    // jackclient
-    int nInputs = 1;
-    int nOutputs = 21;
-    jack_client_t *client;
-    jack_status_t status;
-    jack_port_t **input_port;
-    jack_port_t **output_port;
-    jack_default_audio_sample_t **in, **out;
-    static int callback_process(jack_nframes_t x, void *object);
-    int process(jack_nframes_t nframes);
-
-    void _get_feature_names();
+    /**
+     * @brief One of the three inputs of an envelope generator, a constant or a scaled feature
+     */
+    struct Control {
+        int feature  = -1;  /**< Index of the feature, -1 for the constant */
+        Sample scale = 1.0; /**< Factor applied to the feature */
+        Sample value = 0.0; /**< Offset added to the feature, or the constant */
+    };
+
+    /**
+     * @brief Settings of one envelope generator of a source
+     */
+    struct EnvelopeSettings {
+        Mode mode;
+        Control controls[3]; /**< Main, spread and volume */
+    };
+
+    /**
+     * @brief Settings of one source from the session
+     */
+    struct SourceSettings {
+        std::string name;
+        FeatureNames features;
+        Mode combination = "max";
+        std::string bus; /**< Feature bus the source publishes on, empty for none */
+        std::vector<EnvelopeSettings> envelopes;
+    };
+
+    /**
+     * @brief The modules and buffers of one source
+     */
+    struct Source {
+        std::unique_ptr<FeatureBank> bank;
+        std::vector<std::unique_ptr<EnvelopeGenerator>> generators;
+        std::unique_ptr<EnvelopeCombinator> combinator;
+        std::unique_ptr<AudioDisperser> disperser;
+
+        PlanarBuffer input;     /**< Current block of the source */
+        PlanarBuffer control;   /**< Main, spread and volume of one generator */
+        PlanarBuffer envelopes; /**< Envelopes of all generators, one set after another */
+        PlanarBuffer dispersed; /**< Signal and combined envelopes for the disperser */
+
+        const PlanarBuffer* output = nullptr; /**< Speaker signals of the last block */
+    };
+
+    HostOptions options;
+    ConfigPath layout; /**< Speaker layout file */
+    std::vector<SourceSettings> sessionSources;
+    std::vector<std::string> inputConnections;
+    std::string outputConnection;
+
+    SystemConfigs systemCfgs{};
+    int numSpeakers = 0;
+    std::vector<Source> sources;
 
+    void _loadSession();
+    EnvelopeSettings _parseEnvelope(const YAML::Node& node, const FeatureNames& features) const;
+    Control _parseControl(const YAML::Node& node, const FeatureNames& features) const;
     /**
-     * seperarate the initialization of zerr modules and audio client
+     * @brief Build the modules of all sources for the current system configs
      */
-    void _initialize_zerr();
-    void _initialize_audioclient();
+    void _buildChain();
     /**
-     * hold the run function
+     * @brief Run the chain on the input buffers of the sources
      */
-    void _hold();
+    void _perform();
 };
 
-}  // namespace zerr
-#endif  // ZERR_H
+} // namespace zerr
+#endif // ZERR_H
@@ -50,6 +50,7 @@ void zerr_combinator_perform64(t_zerr_combinator* x, t_object* dsp64,
     void* userparam);
 
 void zerr_combinator_bang(t_zerr_combinator* x);
+void zerr_combinator_stats(t_zerr_combinator* x, t_symbol* msg, long argc, t_atom* argv);
 
 long zerr_combinator_multichanneloutputs(t_zerr_combinator* x, long outletindex);
 
@@ -80,6 +81,7 @@ C74_EXPORT void ext_main(void* r)
     class_addmethod(c, (method)zerr_combinator_multichanneloutputs, "multichanneloutputs", A_CANT, 0);
     class_addmethod(c, (method)zerr_combinator_inputchanged, "inputchanged", A_CANT, 0);
     class_addmethod(c, (method)zerr_combinator_bang, "bang", 0);
+    class_addmethod(c, (method)zerr_combinator_stats, "stats", A_GIMME, 0);
 
     // Attributes
     CLASS_ATTR_LONG(c, "chans", 0, t_zerr_combinator, channel_count);
@@ -182,6 +184,20 @@ void zerr_combinator_bang(t_zerr_combinator* x)
     object_post((t_object*)x, "combination mode: %s \n channel count = %ld", "everything", x->channel_count);
 }
 
+void zerr_combinator_stats(t_zerr_combinator* x, t_symbol* msg, long argc, t_atom* argv)
+{
+    // "stats 1" / "stats 0" start and stop timing, "stats reset" clears, "stats" posts
+    zerr::LoadMeter& meter = x->zc->getLoadMeter();
+
+    if (argc > 0 && (atom_gettype(argv) == A_LONG || atom_gettype(argv) == A_FLOAT)) {
+        meter.set_enabled(atom_getlong(argv) != 0);
+    } else if (argc > 0 && atom_getsym(argv) == gensym("reset")) {
+        meter.reset();
+    } else {
+        object_post((t_object*)x, "%s", meter.report().c_str());
+    }
+}
+
 //------------------------------------------------------------------------------
 // Multichannel Methods
 //------------------------------------------------------------------------------
@@ -36,7 +36,7 @@ class ZerrCombinator {
      */
     ZerrCombinator(const zerr::SystemConfigs& sys_config, int inputCount, std::string mode)
         : systemConfigs { sys_config }
-        , inputBuffer(inputCount, std::vector<double>(sys_config.block_size, 0.0))
+        , inputBuffer(inputCount, sys_config.block_size)
     // , combinator { std::make_unique<zerr::EnvelopeCombinator>(sys_config, spkrCfgFile, selectionMode) }
     {
     }
@@ -69,8 +69,8 @@ class ZerrCombinator {
         // outputCount = combinator->getNumSpeakers();
         // post("ZerrCombinator::initialize outputCount is %d", outputCount);
 
-        inputBuffer.resize(inputCount, zerr::Samples(systemConfigs.block_size, 0.0f));
-        outputBuffer.resize(outputCount, zerr::Samples(systemConfigs.block_size, 0.0f));
+        inputBuffer.resize(inputCount, systemConfigs.block_size);
+        outputBuffer.resize(outputCount, systemConfigs.block_size);
 
         return true;
     }
@@ -118,6 +118,12 @@ class ZerrCombinator {
      */
     [[nodiscard]] int getPortCount() const noexcept { return inputCount + outputCount; }
 
+    /**
+     * @brief Gets the timing of the perform routine, enable it to collect statistics
+     * @return The load meter of the core component
+     */
+    zerr::LoadMeter& getLoadMeter() noexcept { return combinator->get_load_meter(); }
+
     ~ZerrCombinator() = default;
 
  private:
@@ -126,8 +132,8 @@ class ZerrCombinator {
 
     zerr::SystemConfigs systemConfigs; /**< System configuration settings */
 
-    zerr::Blocks inputBuffer; /**< Buffer for storing incoming audio samples */
-    zerr::Blocks outputBuffer; /**< Multi-channel buffer for storing processed audio samples */
+    zerr::PlanarBuffer inputBuffer; /**< Buffer for storing incoming audio samples */
+    zerr::PlanarBuffer outputBuffer; /**< Multi-channel buffer for storing processed audio samples */
 
     std::unique_ptr<zerr::EnvelopeCombinator> combinator; /**< Core component that implements the feature extraction algorithms */
 
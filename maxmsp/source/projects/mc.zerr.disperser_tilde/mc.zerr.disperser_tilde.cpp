@@ -10,6 +10,8 @@
 
 #include "c74_min.h"
 
+#include "loadmeter.h"
+
 using namespace c74::min;
 
 class mc_zerr_disperser_tilde : public object<mc_zerr_disperser_tilde>, public mc_operator<> {
@@ -100,6 +102,8 @@ class mc_zerr_disperser_tilde : public object<mc_zerr_disperser_tilde>, public m
     // ==========================
     void operator()(audio_bundle input, audio_bundle output)
     {
+        zerr::LoadMeter::Scope measure(loadMeter);
+
         // Check the channel structure.
         if (input.channel_count() != output.channel_count() + 1) {
             output.clear();
@@ -120,6 +124,31 @@ class mc_zerr_disperser_tilde : public object<mc_zerr_disperser_tilde>, public m
     // ==========================
     // Messages
     // ==========================
+    message<> dspsetup {
+        this, "dspsetup",
+        [this](const atoms& args, const int inlet) -> atoms {
+            zerr::SystemConfigs systemConfigs;
+            systemConfigs.sample_rate = static_cast<size_t>(static_cast<double>(args[0]));
+            systemConfigs.block_size = static_cast<size_t>(static_cast<int>(args[1]));
+            loadMeter.set_period(systemConfigs);
+            return {};
+        }
+    };
+
+    message<> stats {
+        this, "stats", "Time the perform routine: 1/0 to start/stop, reset, or post the statistics.",
+        [this](const atoms& args, const int inlet) -> atoms {
+            if (!args.empty() && (args[0].a_type == c74::max::A_LONG || args[0].a_type == c74::max::A_FLOAT)) {
+                loadMeter.set_enabled(static_cast<int>(args[0]) != 0);
+            } else if (!args.empty() && args[0].a_type == c74::max::A_SYM && symbol(args[0]) == symbol("reset")) {
+                loadMeter.reset();
+            } else {
+                cout << loadMeter.report() << endl;
+            }
+            return {};
+        }
+    };
+
     // Disable bang message
     // message<> bang { this, "bang", "Ignored bang message.",
     //     [this](const atoms& args, const int inlet) -> atoms {
@@ -129,6 +158,8 @@ class mc_zerr_disperser_tilde : public object<mc_zerr_disperser_tilde>, public m
  private:
     int channelCountSrc { 1 };
     int channelCountEnv { 1 };
+
+    zerr::LoadMeter loadMeter; ///< Timing of the perform routine
 };
 
 MIN_EXTERNAL(mc_zerr_disperser_tilde);
@@ -27,6 +27,7 @@ typedef struct _zerr_envelopes {
     t_pxobject x_obj; ///< DSP object header (must be first)
     long channel_count; ///< Channel count of multichannel signal
     ZerrEnvelopes* ze; ///< Pointer to the zerr_envelopes implementation
+    void* log_qelem; ///< Prints the log messages deferred by the audio thread
 } t_zerr_envelopes;
 
 //------------------------------------------------------------------------------
@@ -41,12 +42,14 @@ void zerr_envelopes_perform64(t_zerr_envelopes* x, t_object* dsp64, double** ins
 long zerr_envelopes_multichanneloutputs(t_zerr_envelopes* x, long outletindex);
 //------------------------------------------------------------------------------
 void zerr_envelopes_bang(t_zerr_envelopes* x);
+void zerr_envelopes_stats(t_zerr_envelopes* x, t_symbol* msg, long argc, t_atom* argv);
 void zerr_envelopes_active(t_zerr_envelopes* x, t_symbol* msg, long argc, t_atom* argv);
 void zerr_envelopes_curr(t_zerr_envelopes* x, t_symbol* msg, long argc, t_atom* argv);
 void zerr_envelopes_topo(t_zerr_envelopes* x, t_symbol* msg, long argc, t_atom* argv);
 void zerr_envelopes_traj(t_zerr_envelopes* x, t_symbol* msg, long argc, t_atom* argv);
 void zerr_envelopes_interval(t_zerr_envelopes* x, t_symbol* msg, long argc, t_atom* argv);
 void zerr_envelopes_print(t_zerr_envelopes* x);
+void zerr_envelopes_flush_log(t_zerr_envelopes* x);
 
 // Class pointer
 static t_class* zerr_envelopes_class = NULL;
@@ -72,6 +75,7 @@ C74_EXPORT void ext_main(void* r)
     class_addmethod(c, (method)zerr_envelopes_assist, "assist", A_CANT, 0);
     class_addmethod(c, (method)zerr_envelopes_multichanneloutputs, "multichanneloutputs", A_CANT, 0);
     class_addmethod(c, (method)zerr_envelopes_bang, "bang", 0);
+    class_addmethod(c, (method)zerr_envelopes_stats, "stats", A_GIMME, 0);
     class_addmethod(c, (method)zerr_envelopes_active, "active", A_GIMME, 0);
     class_addmethod(c, (method)zerr_envelopes_curr, "curr", A_GIMME, 0);
     class_addmethod(c, (method)zerr_envelopes_topo, "topo", A_GIMME, 0);
@@ -106,6 +110,7 @@ void* zerr_envelopes_new(t_symbol* s, long argc, t_atom* argv)
 
     // Initialize default values -----------------------------------------------
     x->ze = NULL;
+    x->log_qelem = NULL;
     x->channel_count = 1; // Default 1 channel output for the multichannel outlet
 
     // Parsing arguments -------------------------------------------------------
@@ -213,6 +218,7 @@ void* zerr_envelopes_new(t_symbol* s, long argc, t_atom* argv)
 
     // Further instance setups -------------------------------------------------
     x->channel_count = x->ze->getOutputCount();
+    x->log_qelem = qelem_new(x, (method)zerr_envelopes_flush_log);
 
     attr_args_process(x, argc, argv);
 
@@ -227,6 +233,11 @@ void zerr_envelopes_free(t_zerr_envelopes* x)
 {
     dsp_free((t_pxobject*)x);
 
+    if (x->log_qelem) {
+        qelem_free(x->log_qelem);
+        x->log_qelem = NULL;
+    }
+
     if (x->ze) {
         delete x->ze;
         x->ze = NULL;
@@ -267,6 +278,15 @@ void zerr_envelopes_dsp64(t_zerr_envelopes* x, t_object* dsp64, short* count, do
 void zerr_envelopes_perform64(t_zerr_envelopes* x, t_object* dsp64, double** ins, long numins, double** outs, long numouts, long sampleframes, long flags, void* userparam)
 {
     x->ze->perform(ins, numins, outs, numouts, sampleframes);
+
+    // print the deferred logs from the main thread
+    if (x->ze->hasPendingLog())
+        qelem_set(x->log_qelem);
+}
+
+void zerr_envelopes_flush_log(t_zerr_envelopes* x)
+{
+    x->ze->flushLog();
 }
 
 //------------------------------------------------------------------------------
@@ -278,6 +298,20 @@ void zerr_envelopes_bang(t_zerr_envelopes* x)
     post("mc.zerr.envelopes~: current channel count = %ld", x->channel_count);
 }
 
+void zerr_envelopes_stats(t_zerr_envelopes* x, t_symbol* msg, long argc, t_atom* argv)
+{
+    // "stats 1" / "stats 0" start and stop timing, "stats reset" clears, "stats" posts
+    zerr::LoadMeter& meter = x->ze->getLoadMeter();
+
+    if (argc > 0 && (atom_gettype(argv) == A_LONG || atom_gettype(argv) == A_FLOAT)) {
+        meter.set_enabled(atom_getlong(argv) != 0);
+    } else if (argc > 0 && atom_getsym(argv) == gensym("reset")) {
+        meter.reset();
+    } else {
+        object_post((t_object*)x, "%s", meter.report().c_str());
+    }
+}
+
 void zerr_envelopes_active(t_zerr_envelopes* x, t_symbol* msg, long argc, t_atom* argv)
 {
     t_symbol* action;
@@ -62,12 +62,14 @@ class ZerrEnvelopes {
             post(msg.c_str());
         };
         generator->setPrinter(printFunc);
+        // post() must not be called in perform, the logs of the audio thread go through a qelem
+        generator->setLogDeferred(true);
 
         outputCount = generator->getNumSpeakers();
         // post("ZerrEnvelopes::initialize outputCount is %d", outputCount);
 
-        inputBuffer.resize(inputCount, zerr::Samples(systemConfigs.block_size, 0.0f));
-        outputBuffer.resize(outputCount, zerr::Samples(systemConfigs.block_size, 0.0f));
+        inputBuffer.resize(inputCount, systemConfigs.block_size);
+        outputBuffer.resize(outputCount, systemConfigs.block_size);
 
         return true;
     }
@@ -116,6 +118,12 @@ class ZerrEnvelopes {
      */
     [[nodiscard]] int getPortCount() const noexcept { return inputCount + outputCount; }
 
+    /**
+     * @brief Gets the timing of the perform routine, enable it to collect statistics
+     * @return The load meter of the core component
+     */
+    zerr::LoadMeter& getLoadMeter() noexcept { return generator->getLoadMeter(); }
+
     ~ZerrEnvelopes() = default;
 
     /**
@@ -181,14 +189,30 @@ class ZerrEnvelopes {
         generator->printParameters();
     }
 
+    /**
+     * @brief Prints the log messages deferred by the audio thread, call from the main thread
+     */
+    void flushLog()
+    {
+        generator->flushLog();
+    }
+
+    /**
+     * @brief Whether the audio thread deferred log messages, safe to call in perform
+     */
+    bool hasPendingLog() const
+    {
+        return generator->hasPendingLog();
+    }
+
  private:
     static constexpr int inputCount = 3; /**< Number of signal inlets: main(0), spread(1), volume(2) */
     int outputCount = 0; /**< Number of signal outlets based on the loudspeaker setup */
 
     zerr::SystemConfigs systemConfigs; /**< System configuration: sample rate and block size */
 
-    zerr::Blocks inputBuffer; /**< Multi-channel buffer for storing incoming audio samples */
-    zerr::Blocks outputBuffer; /**< Multi-channel buffer for storing envelope outputs */
+    zerr::PlanarBuffer inputBuffer; /**< Multi-channel buffer for storing incoming audio samples */
+    zerr::PlanarBuffer outputBuffer; /**< Multi-channel buffer for storing envelope outputs */
 
     std::unique_ptr<zerr::EnvelopeGenerator> generator; /**< Core component that implements envelope generation logic */
 
@@ -26,7 +26,11 @@
 typedef struct _zerr_features {
     t_pxobject x_obj; ///< DSP object header (must be first)
     long channel_count; ///< Channel count of multichannel signal
+    long feature_count; ///< Number of extracted features
+    long input_channels; ///< Channel count of the multichannel input signal
     ZerrFeatures* zf; ///< Pointer to the zerr_features implementation
+    t_symbol* bus; ///< Feature bus requested with the "bus" message, empty for none
+    t_symbol* published; ///< Feature bus the implementation currently publishes on
 } t_zerr_features;
 
 //------------------------------------------------------------------------------
@@ -39,7 +43,10 @@ void zerr_features_assist(t_zerr_features* x, void* b, long m, long a, char* s);
 void zerr_features_dsp64(t_zerr_features* x, t_object* dsp64, short* count, double samplerate, long maxvectorsize, long flags);
 void zerr_features_perform64(t_zerr_features* x, t_object* dsp64, double** ins, long numins, double** outs, long numouts, long sampleframes, long flags, void* userparam);
 long zerr_features_multichanneloutputs(t_zerr_features* x, long outletindex);
+long zerr_features_inputchanged(t_zerr_features* x, long index, long count);
 void zerr_features_bang(t_zerr_features* x);
+void zerr_features_stats(t_zerr_features* x, t_symbol* msg, long argc, t_atom* argv);
+void zerr_features_bus(t_zerr_features* x, t_symbol* msg, long argc, t_atom* argv);
 
 // Class pointer
 static t_class* zerr_features_class = NULL;
@@ -63,7 +70,10 @@ C74_EXPORT void ext_main(void* r)
     class_addmethod(c, (method)zerr_features_dsp64, "dsp64", A_CANT, 0);
     class_addmethod(c, (method)zerr_features_assist, "assist", A_CANT, 0);
     class_addmethod(c, (method)zerr_features_multichanneloutputs, "multichanneloutputs", A_CANT, 0);
+    class_addmethod(c, (method)zerr_features_inputchanged, "inputchanged", A_CANT, 0);
     class_addmethod(c, (method)zerr_features_bang, "bang", 0);
+    class_addmethod(c, (method)zerr_features_stats, "stats", A_GIMME, 0);
+    class_addmethod(c, (method)zerr_features_bus, "bus", A_GIMME, 0);
 
     // CLASS_ATTR_LONG(c, "chans", 0, t_zerr_features, channel_count);
     // CLASS_ATTR_LABEL(c, "chans", 0, "Output Channels");
@@ -90,7 +100,10 @@ void* zerr_features_new(t_symbol* s, long argc, t_atom* argv)
 
     // Initialize default values -----------------------------------------------
     x->zf = NULL;
+    x->bus = gensym("");
+    x->published = gensym("");
     x->channel_count = 1; // Default 1 channel output for the multichannel outlet
+    x->input_channels = 1;
 
     // Parsing arguments -------------------------------------------------------
     long offset = attr_args_offset(argc, argv);
@@ -99,6 +112,7 @@ void* zerr_features_new(t_symbol* s, long argc, t_atom* argv)
         return NULL;
     }
 
+    x->feature_count = offset;
     x->channel_count = offset; // the number of argument defines the channel
 
     // Ensure channel count is within bounds
@@ -128,7 +142,7 @@ void* zerr_features_new(t_symbol* s, long argc, t_atom* argv)
     dsp_setup((t_pxobject*)x, 1);
 
     // Mark as multichannel inlet enabled
-    // x->x_obj.z_misc = Z_MC_INLETS;
+    x->x_obj.z_misc = Z_MC_INLETS;
 
     outlet_new((t_object*)x, "multichannelsignal");
 
@@ -151,9 +165,9 @@ void zerr_features_free(t_zerr_features* x)
 void zerr_features_assist(t_zerr_features* x, void* b, long m, long a, char* s)
 {
     if (m == ASSIST_INLET) {
-        strcpy(s, "(signal) Input source signal");
+        strcpy(s, "(multichannel signal) Input source signals");
     } else if (m == ASSIST_OUTLET) {
-        strcpy(s, "(multichannel signal) Output extracted audio features");
+        strcpy(s, "(multichannel signal) Output extracted audio features, grouped by feature");
     }
 }
 
@@ -166,12 +180,52 @@ long zerr_features_multichanneloutputs(t_zerr_features* x, long outletindex)
     return x->channel_count;
 }
 
+long zerr_features_inputchanged(t_zerr_features* x, long index, long count)
+{
+    if (index == 0 && count != x->input_channels) {
+        // every feature is extracted from every input channel
+        x->input_channels = CLAMP(count, 1, MC_MAX_CHANS / x->feature_count);
+        x->channel_count = x->feature_count * x->input_channels;
+        return true;
+    }
+    return false;
+}
+
 //------------------------------------------------------------------------------
 // DSP Methods
 //------------------------------------------------------------------------------
 
 void zerr_features_dsp64(t_zerr_features* x, t_object* dsp64, short* count, double samplerate, long maxvectorsize, long flags)
 {
+    // rebuild the feature bank when the input channel count changed
+    if (x->zf->getChannelCount() != x->input_channels) {
+        ZerrFeatures* zf = new ZerrFeatures(samplerate, maxvectorsize, x->zf->getFeatureNames(), x->input_channels);
+        if (!zf->initialize()) {
+            object_error((t_object*)x, "failed to analyse %ld channels", x->input_channels);
+            delete zf;
+            return;
+        }
+        zf->getLoadMeter().set_enabled(x->zf->getLoadMeter().is_enabled());
+        // the old bank removes its bus before the new one publishes under the same name
+        delete x->zf;
+        x->zf = zf;
+        x->published = gensym("");
+    }
+
+    // the bus changes while audio is off, perform() publishes on it
+    if (x->bus != x->published) {
+        if (!x->zf->publish(x->bus->s_name)) {
+            object_error((t_object*)x, "failed to publish on bus %s", x->bus->s_name);
+            x->bus = gensym("");
+        }
+        x->published = x->bus;
+    }
+
+    // the features share one outlet, nothing is extracted while it is not connected
+    for (long i = 0; i < x->feature_count; ++i) {
+        x->zf->setFeatureEnabled(i, count[1] != 0);
+    }
+
     dsp_add64(dsp64, (t_object*)x, (t_perfroutine64)zerr_features_perform64, 0, NULL);
 }
 
@@ -185,5 +239,29 @@ void zerr_features_perform64(t_zerr_features* x, t_object* dsp64, double** ins,
 void zerr_features_bang(t_zerr_features* x)
 {
     // change to output current activate feature info
-    object_post((t_object*)x, "current channel count = %ld", x->channel_count);
+    object_post((t_object*)x, "current channel count = %ld (%ld features x %ld input channels)",
+        x->channel_count, x->feature_count, x->input_channels);
+}
+
+void zerr_features_stats(t_zerr_features* x, t_symbol* msg, long argc, t_atom* argv)
+{
+    // "stats 1" / "stats 0" start and stop timing, "stats reset" clears, "stats" posts
+    zerr::LoadMeter& meter = x->zf->getLoadMeter();
+
+    if (argc > 0 && (atom_gettype(argv) == A_LONG || atom_gettype(argv) == A_FLOAT)) {
+        meter.set_enabled(atom_getlong(argv) != 0);
+    } else if (argc > 0 && atom_getsym(argv) == gensym("reset")) {
+        meter.reset();
+    } else {
+        object_post((t_object*)x, "%s", meter.report().c_str());
+    }
+}
+
+void zerr_features_bus(t_zerr_features* x, t_symbol* msg, long argc, t_atom* argv)
+{
+    // "bus voice" publishes on the bus named voice from the next time audio starts, "bus" stops
+    x->bus = argc > 0 ? atom_getsym(argv) : gensym("");
+    if (x->bus != x->published) {
+        object_post((t_object*)x, "the feature bus changes when audio is turned on again");
+    }
 }
@@ -31,13 +31,16 @@ class ZerrFeatures {
      * @brief Creates a new ZerrFeatures instance
      * @param sys_config System configuration containing sample rate and block size settings
      * @param ft_names List of audio features to extract from the input signal
+     * @param numChannels Number of channels of the multichannel input signal
      */
-    explicit ZerrFeatures(float sampleRate, int blockSize, const zerr::FeatureNames& names)
+    explicit ZerrFeatures(float sampleRate, int blockSize, const zerr::FeatureNames& names,
+        int numChannels = 1)
         : systemConfigs {
             .sample_rate = (size_t)sampleRate,
             .block_size = (size_t)blockSize,
         }
-        , inputBuffer(inputCount, std::vector<double>(blockSize, 0.0))
+        , channelCount(numChannels)
+        , inputBuffer(numChannels, zerr::Block(blockSize, 0.0))
         , bank { std::make_unique<zerr::FeatureBank>() }
         , featureNames { std::move(names) } // Move instead of copy
     {
@@ -57,14 +60,15 @@ class ZerrFeatures {
     bool initialize()
     {
         try {
-            bank->initialize(featureNames, systemConfigs);
+            bank->initialize(featureNames, systemConfigs, channelCount);
         } catch (const std::exception& e) {
             return false;
         }
 
-        outputCount = featureNames.size();
+        // every feature outputs one channel per input channel
+        outputCount = featureNames.size() * channelCount;
 
-        inputBuffer.resize(inputCount, std::vector<double>(systemConfigs.block_size, 0.0));
+        inputBuffer.resize(channelCount, zerr::Block(systemConfigs.block_size, 0.0));
         outputBuffer.resize(outputCount);
 
         return true;
@@ -81,17 +85,21 @@ class ZerrFeatures {
     void perform(double** ins, long numins, double** outs, long numouts, long sampleframes)
     {
         // Validate input parameters
-        if (!ins || !outs || numins < inputCount || numouts < outputCount) {
+        if (!ins || !outs || numins < channelCount || numouts < outputCount) {
             throw std::invalid_argument("Invalid buffer pointers or sizes in perform()");
         }
 
         // Use std::copy for better optimization possibilities
-        for (int i = 0; i < numins; ++i) {
+        for (int i = 0; i < channelCount; ++i) {
             std::copy_n(ins[i], sampleframes, inputBuffer[i].begin());
         }
 
-        // Process audio through the feature bank
-        outputBuffer = bank->perform(inputBuffer[0]);
+        // Process audio through the feature bank, all channels share one batched FFT
+        if (channelCount == 1) {
+            outputBuffer = bank->perform(inputBuffer[0]);
+        } else {
+            outputBuffer = bank->perform(inputBuffer);
+        }
 
         // Copy output to destination buffers
         for (int i = 0; i < numouts; ++i) {
@@ -99,6 +107,28 @@ class ZerrFeatures {
         }
     }
 
+    /**
+     * @brief Enables or disables the extraction of one feature, does not allocate
+     * @param index Position of the feature in the object arguments
+     * @param enabled Whether the feature is extracted, a disabled feature outputs zeros
+     */
+    void setFeatureEnabled(int index, bool enabled) { bank->set_feature_enabled(index, enabled); }
+
+    /**
+     * @brief Publishes the features on a shared-memory feature bus, not real-time safe
+     * @param name Name of the bus, empty to stop publishing
+     * @return true if the bus was created, false otherwise, e.g. when the name is taken
+     */
+    bool publish(const std::string& name)
+    {
+        try {
+            bank->publish(name);
+        } catch (const std::exception& e) {
+            return false;
+        }
+        return true;
+    }
+
     /**
      * @brief Gets the number of output channels
      * @return Number of output channels based on enabled feature extractors
@@ -111,17 +141,36 @@ class ZerrFeatures {
      */
     [[nodiscard]] constexpr int getInputCount() const noexcept { return inputCount; }
 
+    /**
+     * @brief Gets the number of channels of the multichannel input signal
+     * @return Number of analysed input channels
+     */
+    [[nodiscard]] int getChannelCount() const noexcept { return channelCount; }
+
+    /**
+     * @brief Gets the names of the extracted features
+     * @return List of enabled audio feature extractors
+     */
+    [[nodiscard]] const zerr::FeatureNames& getFeatureNames() const noexcept { return featureNames; }
+
     /**
      * @brief Gets the total number of ports (inlets + outlets)
      * @return Total count of all audio ports
      */
     [[nodiscard]] int getPortCount() const noexcept { return inputCount + outputCount; }
 
+    /**
+     * @brief Gets the timing of the perform routine, enable it to collect statistics
+     * @return The load meter of the core component
+     */
+    zerr::LoadMeter& getLoadMeter() noexcept { return bank->get_load_meter(); }
+
     ~ZerrFeatures() = default;
 
  private:
     static constexpr int inputCount = 1; /**< Number of signal inlets for receiving audio input */
     int outputCount = 0; /**< Number of signal outlets based on enabled feature extractors */
+    int channelCount = 1; /**< Number of channels of the multichannel input signal */
 
     zerr::SystemConfigs systemConfigs; /**< System configuration settings */
     zerr::FeatureNames featureNames; /**< List of enabled audio feature extractors */
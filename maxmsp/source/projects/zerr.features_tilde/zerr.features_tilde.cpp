@@ -27,6 +27,8 @@ typedef struct _zerr_features {
     t_pxobject x_obj; ///< DSP object header (must be first)
     long channel_count; ///< Channel count of output signal
     ZerrFeatures* zf; ///< Pointer to the zerr_features implementation
+    t_symbol* bus; ///< Feature bus requested with the "bus" message, empty for none
+    t_symbol* published; ///< Feature bus the implementation currently publishes on
 } t_zerr_features;
 
 //------------------------------------------------------------------------------
@@ -39,6 +41,8 @@ void zerr_features_assist(t_zerr_features* x, void* b, long m, long a, char* s);
 void zerr_features_dsp64(t_zerr_features* x, t_object* dsp64, short* count, double samplerate, long maxvectorsize, long flags);
 void zerr_features_perform64(t_zerr_features* x, t_object* dsp64, double** ins, long numins, double** outs, long numouts, long sampleframes, long flags, void* userparam);
 void zerr_features_bang(t_zerr_features* x);
+void zerr_features_stats(t_zerr_features* x, t_symbol* msg, long argc, t_atom* argv);
+void zerr_features_bus(t_zerr_features* x, t_symbol* msg, long argc, t_atom* argv);
 
 // Class pointer
 static t_class* zerr_features_class = NULL;
@@ -63,6 +67,8 @@ C74_EXPORT void ext_main(void* r)
     class_addmethod(c, (method)zerr_features_assist, "assist", A_CANT, 0);
     // class_addmethod(c, (method)zerr_features_multichanneloutputs, "multichanneloutputs", A_CANT, 0);
     class_addmethod(c, (method)zerr_features_bang, "bang", 0);
+    class_addmethod(c, (method)zerr_features_stats, "stats", A_GIMME, 0);
+    class_addmethod(c, (method)zerr_features_bus, "bus", A_GIMME, 0);
 
     // CLASS_ATTR_LONG(c, "chans", 0, t_zerr_features, channel_count);
     // CLASS_ATTR_LABEL(c, "chans", 0, "Output Channels");
@@ -89,6 +95,8 @@ void* zerr_features_new(t_symbol* s, long argc, t_atom* argv)
 
     // Initialize default values -----------------------------------------------
     x->zf = NULL;
+    x->bus = gensym("");
+    x->published = gensym("");
     x->channel_count = 1; // Default 1 channel output for the multichannel outlet
 
     // Parsing arguments -------------------------------------------------------
@@ -164,6 +172,20 @@ void zerr_features_assist(t_zerr_features* x, void* b, long m, long a, char* s)
 
 void zerr_features_dsp64(t_zerr_features* x, t_object* dsp64, short* count, double samplerate, long maxvectorsize, long flags)
 {
+    // only extract the features of connected outlets, count lists the inlet before the outlets
+    for (int i = 0; i < x->zf->getOutputCount(); ++i) {
+        x->zf->setFeatureEnabled(i, count[x->zf->getInputCount() + i] != 0);
+    }
+
+    // the bus changes while audio is off, perform() publishes on it
+    if (x->bus != x->published) {
+        if (!x->zf->publish(x->bus->s_name)) {
+            object_error((t_object*)x, "failed to publish on bus %s", x->bus->s_name);
+            x->bus = gensym("");
+        }
+        x->published = x->bus;
+    }
+
     dsp_add64(dsp64, (t_object*)x, (t_perfroutine64)zerr_features_perform64, 0, NULL);
 }
 
@@ -178,4 +200,27 @@ void zerr_features_bang(t_zerr_features* x)
 {
     // change to output current activate feature info
     object_post((t_object*)x, "current channel count = %ld", x->channel_count);
-}
\ No newline at end of file
+}
+
+void zerr_features_stats(t_zerr_features* x, t_symbol* msg, long argc, t_atom* argv)
+{
+    // "stats 1" / "stats 0" start and stop timing, "stats reset" clears, "stats" posts
+    zerr::LoadMeter& meter = x->zf->getLoadMeter();
+
+    if (argc > 0 && (atom_gettype(argv) == A_LONG || atom_gettype(argv) == A_FLOAT)) {
+        meter.set_enabled(atom_getlong(argv) != 0);
+    } else if (argc > 0 && atom_getsym(argv) == gensym("reset")) {
+        meter.reset();
+    } else {
+        object_post((t_object*)x, "%s", meter.report().c_str());
+    }
+}
+
+void zerr_features_bus(t_zerr_features* x, t_symbol* msg, long argc, t_atom* argv)
+{
+    // "bus voice" publishes on the bus named voice from the next time audio starts, "bus" stops
+    x->bus = argc > 0 ? atom_getsym(argv) : gensym("");
+    if (x->bus != x->published) {
+        object_post((t_object*)x, "the feature bus changes when audio is turned on again");
+    }
+}
@@ -37,7 +37,7 @@ class ZerrFeatures {
             .sample_rate = (size_t)sampleRate,
             .block_size = (size_t)blockSize,
         }
-        , inputBuffer(inputCount, std::vector<double>(blockSize, 0.0))
+        , inputBuffer(inputCount, zerr::Block(blockSize, 0.0))
         , bank { std::make_unique<zerr::FeatureBank>() }
         , featureNames { std::move(names) } // Move instead of copy
     {
@@ -64,7 +64,7 @@ class ZerrFeatures {
 
         outputCount = featureNames.size();
 
-        inputBuffer.resize(inputCount, std::vector<double>(systemConfigs.block_size, 0.0));
+        inputBuffer.resize(inputCount, zerr::Block(systemConfigs.block_size, 0.0));
         outputBuffer.resize(outputCount);
 
         return true;
@@ -99,6 +99,28 @@ class ZerrFeatures {
         }
     }
 
+    /**
+     * @brief Enables or disables the extraction of one feature, does not allocate
+     * @param index Position of the feature in the object arguments
+     * @param enabled Whether the feature is extracted, a disabled feature outputs zeros
+     */
+    void setFeatureEnabled(int index, bool enabled) { bank->set_feature_enabled(index, enabled); }
+
+    /**
+     * @brief Publishes the features on a shared-memory feature bus, not real-time safe
+     * @param name Name of the bus, empty to stop publishing
+     * @return true if the bus was created, false otherwise, e.g. when the name is taken
+     */
+    bool publish(const std::string& name)
+    {
+        try {
+            bank->publish(name);
+        } catch (const std::exception& e) {
+            return false;
+        }
+        return true;
+    }
+
     /**
      * @brief Gets the number of output channels
      * @return Number of output channels based on enabled feature extractors
@@ -117,6 +139,12 @@ class ZerrFeatures {
      */
     [[nodiscard]] int getPortCount() const noexcept { return inputCount + outputCount; }
 
+    /**
+     * @brief Gets the timing of the perform routine, enable it to collect statistics
+     * @return The load meter of the core component
+     */
+    zerr::LoadMeter& getLoadMeter() noexcept { return bank->get_load_meter(); }
+
     ~ZerrFeatures() = default;
 
  private:
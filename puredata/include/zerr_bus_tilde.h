@@ -0,0 +1,92 @@
+/**
+ * @file zerr_bus_tilde.h
+ * @author Zeyu Yang (zeyuuyang42@gmail.com)
+ * @brief zerr_bus~ Pure Data External - Reads features from a shared-memory feature bus
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2023-2026
+ */
+#pragma once
+
+#include "m_pd.h"
+
+#include "featurebus.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @struct zerr_bus_tilde
+ * @brief The main Pure Data external interface structure
+ *
+ * A zerr_bus~ object follows one feature bus, published by a [zerr_features~] with the "bus"
+ * message or by another process, and outputs the latest value of the selected features. Any
+ * number of objects can read the same bus, so one analysis drives many envelope generators
+ * without send~/receive~ copies of the feature signals.
+ */
+typedef struct {
+    t_object x_obj; /**< Parent Pure Data object - must be the first member */
+    t_int n_outlet; /**< Number of outlets, one per selected feature */
+
+    t_symbol* bus;       /**< Name of the followed bus */
+    t_symbol** features; /**< Name of the feature of every outlet */
+    int* indices;        /**< Position of every feature on the bus, -1 if missing */
+    t_float* values;     /**< Latest value of every feature, held between frames */
+    t_float* scratch;    /**< Values of the frame being read, kept only if it was not torn */
+
+    zerr::FeatureBusReader* reader; /**< Mapped bus, NULL until it exists */
+    t_clock* clock;                 /**< Periodic check that the bus is still the current one */
+} zerr_bus_tilde;
+
+/**
+ * @memberof zerr_bus_tilde
+ * @brief Creates a new zerr_bus_tilde object instance
+ *
+ * The first argument names the bus, the others the features to output, e.g.
+ * [zerr_bus~ voice osf rms]. The bus does not need to exist yet.
+ *
+ * @param s Symbol containing the object name (unused)
+ * @param argc Number of creation arguments
+ * @param argv Bus name followed by feature names
+ * @return void* Pointer to the new object or NULL if creation failed
+ */
+void* zerr_bus_tilde_new(t_symbol* s, int argc, t_atom* argv);
+
+/**
+ * @memberof zerr_bus_tilde
+ * @brief Unmaps the bus and frees all resources of the object
+ *
+ * @param x Pointer to the zerr_bus~ object to be freed (must not be NULL)
+ */
+void zerr_bus_tilde_free(zerr_bus_tilde* x);
+
+/**
+ * @memberof zerr_bus_tilde
+ * @brief Sets up the DSP processing chain for the object
+ *
+ * @param x Pointer to the zerr_bus~ object
+ * @param sp Array of signal pointers provided by Pure Data, the outlets
+ */
+void zerr_bus_tilde_dsp(zerr_bus_tilde* x, t_signal** sp);
+
+/**
+ * @memberof zerr_bus_tilde
+ * @brief Follows another bus
+ *
+ * Handles the "set" message, e.g. "set synth". The outlets keep their features.
+ *
+ * @param x Pointer to the zerr_bus~ object
+ * @param name Name of the bus
+ */
+void zerr_bus_tilde_set(zerr_bus_tilde* x, t_symbol* name);
+
+/**
+ * @related zerr_bus_tilde
+ * @brief Initializes the zerr_bus~ external in Pure Data
+ */
+void zerr_bus_tilde_setup(void);
+
+#ifdef __cplusplus
+}
+#endif
@@ -52,14 +52,19 @@ class ZerrCombinator {
      * @return Total count of all audio ports
      */
     int get_port_count(); // TODO(Zeyu Yang): remove if not needed
+    /**
+     * @brief Gets the timing of the DSP perform routine, enable it to collect statistics
+     * @return The load meter of the core component
+     */
+    zerr::LoadMeter& get_load_meter() { return envelopeCombinator->get_load_meter(); }
     /**
      * @brief Destructor that cleans up and frees all allocated resources
      */
     ~ZerrCombinator();
 
  private:
-    zerr::Blocks inputBuffer; /**< Multi-channel buffer for storing incoming audio samples */
-    zerr::Blocks outputBuffer; /**< Multi-channel buffer for storing processed audio samples */
+    zerr::PlanarBuffer inputBuffer; /**< Multi-channel buffer for storing incoming audio samples */
+    zerr::PlanarBuffer outputBuffer; /**< Multi-channel buffer for storing processed audio samples */
     float** inPtr; /**< Array of pointers to Pure Data input signal vectors */
     float** outPtr; /**< Array of pointers to Pure Data output signal vectors */
 
@@ -98,6 +98,21 @@ void zerr_combinator_tilde_free(zerr_combinator_tilde *x);
  */
 void zerr_combinator_tilde_dsp(zerr_combinator_tilde *x, t_signal **sp);
 
+/**
+ * @memberof zerr_combinator_tilde
+ * @brief Reports how long the DSP perform routine takes
+ *
+ * Handles the "stats" message. "stats 1" starts timing every DSP block and "stats 0" stops
+ * it, "stats reset" clears the collected values. Without arguments the mean, percentiles,
+ * maximum and load of the recent blocks are posted to the console.
+ *
+ * @param x Pointer to the zerr_combinator~ object
+ * @param s Symbol containing the message selector (unused)
+ * @param argc Number of arguments in the message
+ * @param argv 1, 0, reset or nothing
+ */
+void zerr_combinator_tilde_stats(zerr_combinator_tilde *x, t_symbol *s, int argc, t_atom *argv);
+
 /**
  * @related zerr_combinator_tilde
  * @brief Initializes the zerr_combinator~ external in Pure Data
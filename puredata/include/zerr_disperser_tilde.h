@@ -98,6 +98,21 @@ void zerr_disperser_tilde_free(zerr_disperser_tilde *x);
  */
 void zerr_disperser_tilde_dsp(zerr_disperser_tilde *x, t_signal **sp);
 
+/**
+ * @memberof zerr_disperser_tilde
+ * @brief Reports how long the DSP perform routine takes
+ *
+ * Handles the "stats" message. "stats 1" starts timing every DSP block and "stats 0" stops
+ * it, "stats reset" clears the collected values. Without arguments the mean, percentiles,
+ * maximum and load of the recent blocks are posted to the console.
+ *
+ * @param x Pointer to the zerr_disperser~ object
+ * @param s Symbol containing the message selector (unused)
+ * @param argc Number of arguments in the message
+ * @param argv 1, 0, reset or nothing
+ */
+void zerr_disperser_tilde_stats(zerr_disperser_tilde *x, t_symbol *s, int argc, t_atom *argv);
+
 /**
  * @related zerr_disperser_tilde
  * @brief Initializes the zerr_disperser~ external in Pure Data
@@ -49,6 +49,11 @@ class ZerrEnvelopes {
      * @return Total count of all audio ports
      */
     int get_port_count();
+    /**
+     * @brief Gets the timing of the DSP perform routine, enable it to collect statistics
+     * @return The load meter of the core component
+     */
+    zerr::LoadMeter& get_load_meter() { return envelopeGenerator->getLoadMeter(); }
     /**
      * @brief Updates the list of active speakers in the envelope system
      * @param action Action to perform on the speaker list ("add", "remove", etc.)
@@ -83,6 +88,15 @@ class ZerrEnvelopes {
      * @brief Outputs the current state information to the Pure Data console
      */
     void printParameters();
+    /**
+     * @brief Prints the log messages deferred by the audio thread, call from the scheduler
+     */
+    void flushLog();
+    /**
+     * @brief Whether the audio thread deferred log messages, safe to call in perform
+     * @return true if flushLog() has something to print
+     */
+    bool hasPendingLog();
     /**
      * @brief Destructor that cleans up and frees all allocated resources
      */
@@ -91,8 +105,8 @@ class ZerrEnvelopes {
  private:
     zerr::SystemConfigs systemCfgs; /**< Pure Data system configuration settings */
 
-    zerr::Blocks inputBuffer; /**< Multi-channel buffer for storing incoming audio samples */
-    zerr::Blocks outputBuffer; /**< Multi-channel buffer for storing processed audio samples */
+    zerr::PlanarBuffer inputBuffer; /**< Multi-channel buffer for storing incoming audio samples */
+    zerr::PlanarBuffer outputBuffer; /**< Multi-channel buffer for storing processed audio samples */
     float** inPtr; /**< Array of pointers to Pure Data input signal vectors */
     float** outPtr; /**< Array of pointers to Pure Data output signal vectors */
 
@@ -47,6 +47,8 @@ typedef struct {
     t_zerrout *x_vec; /**< Dynamic array of outlet structures */
 
     ZerrEnvelopes *z; /**< Pointer to the core zerr_envelopes processing component */
+
+    t_clock *log_clock; /**< Clock that prints the log messages deferred by the audio thread */
 } zerr_envelopes_tilde;
 
 /**
@@ -88,6 +90,21 @@ void zerr_envelopes_tilde_free(zerr_envelopes_tilde *x);
  */
 void zerr_envelopes_tilde_dsp(zerr_envelopes_tilde *x, t_signal **sp);
 
+/**
+ * @memberof zerr_envelopes_tilde
+ * @brief Reports how long the DSP perform routine takes
+ *
+ * Handles the "stats" message. "stats 1" starts timing every DSP block and "stats 0" stops
+ * it, "stats reset" clears the collected values. Without arguments the mean, percentiles,
+ * maximum and load of the recent blocks are posted to the console.
+ *
+ * @param x Pointer to the zerr_envelopes~ object
+ * @param s Symbol containing the message selector (unused)
+ * @param argc Number of arguments in the message
+ * @param argv 1, 0, reset or nothing
+ */
+void zerr_envelopes_tilde_stats(zerr_envelopes_tilde *x, t_symbol *s, int argc, t_atom *argv);
+
 /**
  * @related zerr_envelopes_tilde
  * @brief Initializes the zerr_envelopes~ external in Pure Data
@@ -155,6 +172,17 @@ void zerr_envelopes_tilde_trigger_interval(zerr_envelopes_tilde *x, t_symbol *s,
  */
 void zerr_envelopes_tilde_print(zerr_envelopes_tilde *x, t_symbol *s);
 
+/**
+ * @memberof zerr_envelopes_tilde
+ * @brief Prints the log messages deferred by the DSP perform routine
+ *
+ * Scheduled by the perform routine through log_clock, so that the messages are posted from
+ * the scheduler instead of the audio thread.
+ *
+ * @param x Pointer to the zerr_envelopes~ object
+ */
+void zerr_envelopes_tilde_flush_log(zerr_envelopes_tilde *x);
+
 /**
  * @memberof zerr_envelopes_tilde
  * @brief Resets all parameters to their default values
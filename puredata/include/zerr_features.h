@@ -29,6 +29,7 @@ class ZerrFeatures {
   public:
     int n_outlet;    /**< Number of signal outlets based on enabled feature extractors */
     int n_inlet = 1; /**< Number of signal inlets for receiving audio input */
+    int n_channels = 1; /**< Number of channels of the (multichannel) input signal */
     /**
      * @brief Creates a new ZerrFeatures instance
      * @param sys_cnfg Pure Data system configuration containing sample rate and block size settings
@@ -40,9 +41,34 @@ class ZerrFeatures {
      * @return 1 if initialization was successful, 0 otherwise
      */
     int initialize();
+    /**
+     * @brief Changes the number of analysed input channels and reinitializes the feature bank
+     * @param n_chans Number of channels of the input signal
+     * @return 1 if reinitialization was successful, 0 otherwise
+     */
+    int set_channel_count(int n_chans);
+    /**
+     * @brief Enables or disables the extraction of features, a disabled feature outputs zeros
+     * @param name Feature name as given in the object arguments, e.g. "rms" or "ctd@512"
+     * @param enable Whether the feature is extracted
+     * @return Number of features with this name
+     */
+    int set_feature_enabled(const std::string& name, bool enable);
+    /**
+     * @brief Enables or disables the extraction of all features
+     * @param enable Whether the features are extracted
+     */
+    void set_all_features_enabled(bool enable);
+    /**
+     * @brief Publishes the features on a shared-memory feature bus after every block
+     * @param name Name of the bus, empty to stop publishing
+     * @return 1 if the bus was created, 0 otherwise, e.g. when the name is taken
+     */
+    int publish(const std::string& name);
     /**
      * @brief Main DSP callback function that processes audio buffers
-     * @param ports Array of pointers to input/output audio buffers (shared memory between in/out)
+     * @param ports Array of pointers to input/output audio buffers (shared memory between in/out),
+     *              each buffer holds n_channels vectors of n_vec samples one after another
      * @param n_vec The actual size of audio vectors to process (may be smaller than system block size)
      */
     void perform(float **ports, int n_vec);
@@ -51,6 +77,11 @@ class ZerrFeatures {
      * @return Total count of all audio ports
      */
     int get_port_count();
+    /**
+     * @brief Gets the timing of the DSP perform routine, enable it to collect statistics
+     * @return The load meter of the core component
+     */
+    zerr::LoadMeter& get_load_meter() { return bank->get_load_meter(); }
     /**
      * @brief Destructor that cleans up and frees all allocated resources
      */
@@ -59,6 +90,8 @@ class ZerrFeatures {
   private:
     zerr::SystemConfigs systemConfigs; /**< Pure Data system configuration settings */
     zerr::FeatureNames featureNames;   /**< List of enabled audio feature extractors */
+    std::vector<bool> enabled;         /**< Whether each feature is extracted, kept across rebuilds */
+    std::string busName;               /**< Feature bus the bank publishes on, kept across rebuilds */
 
     zerr::Blocks input_buffer;         /**< Buffer for storing incoming audio samples */
     zerr::FeaturesVals output_buffer;  /**< Buffer for storing extracted feature values */
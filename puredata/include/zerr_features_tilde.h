@@ -82,6 +82,64 @@ void zerr_features_tilde_free(zerr_features_tilde* x);
  */
 void zerr_features_tilde_dsp(zerr_features_tilde* x, t_signal** sp);
 
+/**
+ * @memberof zerr_features_tilde
+ * @brief Reports how long the DSP perform routine takes
+ *
+ * Handles the "stats" message. "stats 1" starts timing every DSP block and "stats 0" stops
+ * it, "stats reset" clears the collected values. Without arguments the mean, percentiles,
+ * maximum and load of the recent blocks are posted to the console.
+ *
+ * @param x Pointer to the zerr_features~ object
+ * @param s Symbol containing the message selector (unused)
+ * @param argc Number of arguments in the message
+ * @param argv 1, 0, reset or nothing
+ */
+void zerr_features_tilde_stats(zerr_features_tilde* x, t_symbol* s, int argc, t_atom* argv);
+
+/**
+ * @memberof zerr_features_tilde
+ * @brief Enables the extraction of features
+ *
+ * Handles the "enable" message. Each argument names a feature as given in the creation
+ * arguments, without arguments all features are enabled.
+ *
+ * @param x Pointer to the zerr_features~ object
+ * @param s Symbol containing the message selector (unused)
+ * @param argc Number of arguments in the message
+ * @param argv Feature names
+ */
+void zerr_features_tilde_enable(zerr_features_tilde* x, t_symbol* s, int argc, t_atom* argv);
+
+/**
+ * @memberof zerr_features_tilde
+ * @brief Disables the extraction of features
+ *
+ * Handles the "disable" message. A disabled feature is skipped by the analysis and its outlet
+ * outputs zeros. Without arguments all features are disabled.
+ *
+ * @param x Pointer to the zerr_features~ object
+ * @param s Symbol containing the message selector (unused)
+ * @param argc Number of arguments in the message
+ * @param argv Feature names
+ */
+void zerr_features_tilde_disable(zerr_features_tilde* x, t_symbol* s, int argc, t_atom* argv);
+
+/**
+ * @memberof zerr_features_tilde
+ * @brief Publishes the features on a shared-memory feature bus
+ *
+ * Handles the "bus" message. "bus voice" publishes the value of every feature and channel at
+ * the end of each DSP block on the bus named voice, where [zerr_bus~] objects and other
+ * processes such as zerr_bus or a visualiser read it. "bus" without a name stops publishing.
+ *
+ * @param x Pointer to the zerr_features~ object
+ * @param s Symbol containing the message selector (unused)
+ * @param argc Number of arguments in the message
+ * @param argv Bus name or nothing
+ */
+void zerr_features_tilde_bus(zerr_features_tilde* x, t_symbol* s, int argc, t_atom* argv);
+
 /**
  * @related zerr_features_tilde
  * @brief Initializes the zerr_features~ external in Pure Data
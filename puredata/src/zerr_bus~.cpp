@@ -0,0 +1,184 @@
+/**
+ * @file zerr_bus~.cpp
+ * @author Zeyu Yang (zeyuuyang42@gmail.com)
+ * @brief zerr_bus~ Pure Data External
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2023-2026
+ */
+#include "./zerr_bus_tilde.h"
+
+#define ZERR_BUS_CHECK_INTERVAL 500 /**< Milliseconds between two checks of the bus */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+static t_class *zerr_bus_tilde_class;
+
+/**
+ * @brief Map the bus if it exists and find the features on it
+ */
+static void zerr_bus_tilde_open(zerr_bus_tilde *x) {
+    delete x->reader;
+    x->reader = NULL;
+    for (int i = 0; i < x->n_outlet; ++i) {
+        x->values[i] = 0;
+    }
+
+    try {
+        x->reader = new zerr::FeatureBusReader(x->bus->s_name);
+    } catch (...) {
+        // the bus does not exist yet, the clock tries again
+        return;
+    }
+
+    for (int i = 0; i < x->n_outlet; ++i) {
+        x->indices[i] = x->reader->find(x->features[i]->s_name);
+        if (x->indices[i] < 0) {
+            pd_error(x, "zerr_bus~: bus %s has no feature %s", x->bus->s_name,
+                     x->features[i]->s_name);
+        }
+    }
+}
+
+
+static void zerr_bus_tilde_tick(zerr_bus_tilde *x) {
+    // a restarted writer publishes on a new bus of the same name
+    if (!x->reader || x->reader->is_closed() || x->reader->is_replaced()) {
+        zerr_bus_tilde_open(x);
+    }
+    clock_delay(x->clock, ZERR_BUS_CHECK_INTERVAL);
+}
+
+
+void *zerr_bus_tilde_new(t_symbol *s, int argc, t_atom *argv) {
+    // the bus name and at least one feature name should be given
+    if (argc < 2) {
+        pd_error(NULL, "zerr_bus~: bus name and feature names expected");
+        return NULL;
+    }
+    for (int i = 0; i < argc; i++) {
+        if (argv[i].a_type != A_SYMBOL) {
+            pd_error(NULL, "zerr_bus~: bus name and feature names expected");
+            return NULL;
+        }
+    }
+
+    zerr_bus_tilde *x = (zerr_bus_tilde *) pd_new(zerr_bus_tilde_class);
+    if (!x) return NULL;
+
+    x->bus      = atom_getsymbol(argv);
+    x->n_outlet = argc - 1;
+    x->features = (t_symbol **) getbytes(x->n_outlet * sizeof(*x->features));
+    x->indices  = (int *) getbytes(x->n_outlet * sizeof(*x->indices));
+    x->values   = (t_float *) getbytes(x->n_outlet * sizeof(*x->values));
+    x->scratch  = (t_float *) getbytes(x->n_outlet * sizeof(*x->scratch));
+    x->reader   = NULL;
+
+    for (int i = 0; i < x->n_outlet; ++i) {
+        x->features[i] = atom_getsymbol(argv + i + 1);
+        x->indices[i]  = -1;
+        outlet_new(&x->x_obj, &s_signal);
+    }
+
+    x->clock = clock_new(x, (t_method) zerr_bus_tilde_tick);
+    zerr_bus_tilde_tick(x);
+
+    return (void *) x;
+}
+
+
+void zerr_bus_tilde_free(zerr_bus_tilde *x) {
+    clock_free(x->clock);
+    delete x->reader;
+    freebytes(x->features, x->n_outlet * sizeof(*x->features));
+    freebytes(x->indices, x->n_outlet * sizeof(*x->indices));
+    freebytes(x->values, x->n_outlet * sizeof(*x->values));
+    freebytes(x->scratch, x->n_outlet * sizeof(*x->scratch));
+}
+
+
+static t_int *zerr_bus_tilde_perform(t_int *w) {
+    zerr_bus_tilde *x = (zerr_bus_tilde *) w[1];
+    int n_vec         = (int) w[2];
+    int n_args        = (int) w[3];
+
+    t_sample **outs = (t_sample **) &w[4];
+
+    // the values are read in place, a frame torn by the writer is dropped and read again
+    if (x->reader) {
+        for (int attempt = 0; attempt < 4; ++attempt) {
+            if (x->reader->visit_latest([x](uint64_t, int64_t, const float *frame) {
+                    for (int i = 0; i < x->n_outlet; ++i) {
+                        x->scratch[i] = x->indices[i] < 0 ? 0 : frame[x->indices[i]];
+                    }
+                })) {
+                for (int i = 0; i < x->n_outlet; ++i) {
+                    x->values[i] = x->scratch[i];
+                }
+                break;
+            }
+        }
+    }
+
+    for (int i = 0; i < x->n_outlet; ++i) {
+        for (int j = 0; j < n_vec; ++j) {
+            outs[i][j] = x->values[i];
+        }
+    }
+
+    return &w[n_args+1];
+}
+
+
+void zerr_bus_tilde_dsp(zerr_bus_tilde *x, t_signal **sp) {
+    int n_rest = 3;  // size of [x, n_vec, n_args]
+    int n_args = x->n_outlet + n_rest;
+
+    t_int *vec = (t_int *) getbytes(n_args * sizeof(t_int *));
+
+    vec[0] = (t_int) x;
+    vec[1] = (t_int) sp[0]->s_n;
+    vec[2] = (t_int) n_args;
+    for (int i = 0; i < x->n_outlet; ++i) {
+        vec[i+n_rest] = (t_int) sp[i]->s_vec;
+    }
+
+    dsp_addv(zerr_bus_tilde_perform, n_args, vec);
+    freebytes(vec, n_args * sizeof(t_int *));
+}
+
+
+void zerr_bus_tilde_set(zerr_bus_tilde *x, t_symbol *name) {
+    x->bus = name;
+    zerr_bus_tilde_open(x);
+}
+
+
+void zerr_bus_tilde_setup(void) {
+    zerr_bus_tilde_class = class_new(gensym("zerr_bus~"),
+        (t_newmethod) zerr_bus_tilde_new,
+        (t_method) zerr_bus_tilde_free,
+        (size_t) sizeof(zerr_bus_tilde),
+        CLASS_DEFAULT,
+        A_GIMME, 0);
+
+    class_addmethod(zerr_bus_tilde_class,
+        (t_method) zerr_bus_tilde_dsp,
+        gensym("dsp"),
+        A_CANT,
+        A_NULL);
+
+    class_addmethod(zerr_bus_tilde_class,
+        (t_method) zerr_bus_tilde_set,
+        gensym("set"),
+        A_SYMBOL,
+        A_NULL);
+
+    class_sethelpsymbol(zerr_bus_tilde_class, gensym("zerr_bus~"));
+}
+
+#ifdef __cplusplus
+}
+#endif
@@ -35,10 +35,8 @@ bool ZerrCombinator::initialize() {
     numInlet  = envelopeCombinator->numInlet;
     numOutlet = envelopeCombinator->numOutlet;
 
-    inputBuffer.resize(numInlet,
-        zerr::Samples(envelopeCombinator->get_block_size(), 0.0f));
-    outputBuffer.resize(numOutlet,
-        zerr::Samples(envelopeCombinator->get_block_size(), 0.0f));
+    inputBuffer.resize(numInlet, envelopeCombinator->get_block_size());
+    outputBuffer.resize(numOutlet, envelopeCombinator->get_block_size());
 
     logger->logDebug(zerr::formatString(
         "ZerrCombinator::initialize numInlet:%d numOutlet:%d blockSize %d",
@@ -102,6 +102,19 @@ void zerr_combinator_tilde_dsp(zerr_combinator_tilde *x, t_signal **sp) {
 }
 
 
+void zerr_combinator_tilde_stats(zerr_combinator_tilde *x, t_symbol *s, int argc, t_atom *argv) {
+    zerr::LoadMeter &meter = x->z->get_load_meter();
+
+    if (argc > 0 && argv[0].a_type == A_FLOAT) {
+        meter.set_enabled(atom_getfloat(argv) != 0);
+    } else if (argc > 0 && atom_getsymbol(argv) == gensym("reset")) {
+        meter.reset();
+    } else {
+        post("zerr_combinator~: %s", meter.report().c_str());
+    }
+}
+
+
 void zerr_combinator_tilde_setup(void) {
     zerr_combinator_tilde_class = class_new(gensym("zerr_combinator~"),
         (t_newmethod) zerr_combinator_tilde_new,
@@ -116,6 +129,12 @@ void zerr_combinator_tilde_setup(void) {
         A_CANT,
         A_NULL);
 
+    class_addmethod(zerr_combinator_tilde_class,
+        (t_method) zerr_combinator_tilde_stats,
+        gensym("stats"),
+        A_GIMME,
+        A_NULL);
+
     class_sethelpsymbol(zerr_combinator_tilde_class,
                         gensym("zerr_combinator~"));
     CLASS_MAINSIGNALIN(zerr_combinator_tilde_class, zerr_combinator_tilde, f);
@@ -27,10 +27,8 @@ bool ZerrDisperser::initialize() {
     numInlet  = audioDisperser->numInlet;
     numOutlet = audioDisperser->numOutlet;
 
-    inputBuffer.resize(numInlet,
-        zerr::Samples(audioDisperser->get_block_size(), 0.0f));
-    outputBuffer.resize(numOutlet,
-        zerr::Samples(audioDisperser->get_block_size(), 0.0f));
+    inputBuffer.resize(numInlet, audioDisperser->get_block_size());
+    outputBuffer.resize(numOutlet, audioDisperser->get_block_size());
 
     #ifdef TESTMODE
     logger->logDebug(zerr::formatString(
@@ -56,7 +54,7 @@ void ZerrDisperser::perform(float **ports, int blockSize) {
     }
 
     try {
-        outputBuffer = audioDisperser->perfrom(inputBuffer);
+        outputBuffer = audioDisperser->perform(inputBuffer);
     }
     catch (...) {
         // logger->logError("ZerrDisperser::perform process failed...");
@@ -97,6 +97,19 @@ void zerr_disperser_tilde_dsp(zerr_disperser_tilde *x, t_signal **sp) {
 }
 
 
+void zerr_disperser_tilde_stats(zerr_disperser_tilde *x, t_symbol *s, int argc, t_atom *argv) {
+    zerr::LoadMeter &meter = x->z->get_load_meter();
+
+    if (argc > 0 && argv[0].a_type == A_FLOAT) {
+        meter.set_enabled(atom_getfloat(argv) != 0);
+    } else if (argc > 0 && atom_getsymbol(argv) == gensym("reset")) {
+        meter.reset();
+    } else {
+        post("zerr_disperser~: %s", meter.report().c_str());
+    }
+}
+
+
 void zerr_disperser_tilde_setup(void) {
     zerr_disperser_tilde_class = class_new(gensym("zerr_disperser~"),
         (t_newmethod) zerr_disperser_tilde_new,
@@ -111,6 +124,12 @@ void zerr_disperser_tilde_setup(void) {
         A_CANT,
         A_NULL);
 
+    class_addmethod(zerr_disperser_tilde_class,
+        (t_method) zerr_disperser_tilde_stats,
+        gensym("stats"),
+        A_GIMME,
+        A_NULL);
+
     class_sethelpsymbol(zerr_disperser_tilde_class, gensym("zerr_disperser~"));
     CLASS_MAINSIGNALIN(zerr_disperser_tilde_class, zerr_disperser_tilde, f);
 }
@@ -30,11 +30,13 @@ bool ZerrEnvelopes::initialize()
         post(msg.c_str());
     };
     envelopeGenerator->setPrinter(printFunc);
+    // post() must not be called in perform, the logs of the audio thread are printed by a clock
+    envelopeGenerator->setLogDeferred(true);
 
     numOutlet = envelopeGenerator->getNumSpeakers();
 
-    inputBuffer.resize(numInlet, zerr::Samples(systemCfgs.block_size, 0.0f));
-    outputBuffer.resize(numOutlet, zerr::Samples(systemCfgs.block_size, 0.0f));
+    inputBuffer.resize(numInlet, systemCfgs.block_size);
+    outputBuffer.resize(numOutlet, systemCfgs.block_size);
 
     inPtr = (float**)getbytes(numInlet * sizeof(float**));
     outPtr = (float**)getbytes(numOutlet * sizeof(float**));
@@ -102,6 +104,16 @@ void ZerrEnvelopes::printParameters()
     envelopeGenerator->printParameters();
 }
 
+void ZerrEnvelopes::flushLog()
+{
+    envelopeGenerator->flushLog();
+}
+
+bool ZerrEnvelopes::hasPendingLog()
+{
+    return envelopeGenerator->hasPendingLog();
+}
+
 ZerrEnvelopes::~ZerrEnvelopes()
 {
     delete envelopeGenerator;
@@ -76,6 +76,8 @@ void* zerr_envelopes_tilde_new(__attribute__((unused)) t_symbol* s, int argc, t_
     if (!x->z->initialize())
         return NULL;
 
+    x->log_clock = clock_new(x, (t_method)zerr_envelopes_tilde_flush_log);
+
     // create inlets
     x->spread_inlet = inlet_new(&x->x_obj, &x->x_obj.ob_pd, &s_signal, &s_signal);
     x->volume_inlet = inlet_new(&x->x_obj, &x->x_obj.ob_pd, &s_signal, &s_signal);
@@ -100,6 +102,7 @@ void* zerr_envelopes_tilde_new(__attribute__((unused)) t_symbol* s, int argc, t_
 void zerr_envelopes_tilde_free(zerr_envelopes_tilde* x)
 {
     freebytes(x->x_vec, x->n_outlet * sizeof(*x->x_vec));
+    clock_free(x->log_clock);
     delete x->z;
 }
 
@@ -119,9 +122,19 @@ static t_int* zerr_envelopes_tilde_perform(t_int* w)
 
     x->z->perform(ports, n_vec);
 
+    // print the deferred logs as soon as the scheduler is back from DSP
+    if (x->z->hasPendingLog())
+        clock_delay(x->log_clock, 0);
+
     return &w[n_args + 1];
 }
 
+/**
+ * @brief Clock callback that prints the log messages deferred by the perform method.
+ * @param x Pointer to the zerr_envelopes_tilde object.
+ */
+void zerr_envelopes_tilde_flush_log(zerr_envelopes_tilde* x) { x->z->flushLog(); }
+
 /**
  * @brief Method to dynamically adjust active speakers.
  * @param x Pointer to the zerr_envelopes_tilde object.
@@ -277,6 +290,29 @@ void zerr_envelopes_tilde_trigger_interval(zerr_envelopes_tilde* x,
  */
 void zerr_envelopes_tilde_print(zerr_envelopes_tilde* x, t_symbol* s) { x->z->printParameters(); }
 
+/**
+ * @brief Method to time the perform method and print the statistics.
+ * @param x Pointer to the zerr_envelopes_tilde object.
+ * @param s Unused symbol parameter.
+ * @param argc Count of arguments passed.
+ * @param argv 1 or 0 to start or stop timing, reset, or nothing to print.
+ */
+void zerr_envelopes_tilde_stats(zerr_envelopes_tilde* x, __attribute__((unused)) t_symbol* s,
+                                int argc, t_atom* argv)
+{
+    zerr::LoadMeter& meter = x->z->get_load_meter();
+
+    if (argc > 0 && argv[0].a_type == A_FLOAT) {
+        meter.set_enabled(atom_getfloat(argv) != 0);
+    }
+    else if (argc > 0 && atom_getsymbol(argv) == gensym("reset")) {
+        meter.reset();
+    }
+    else {
+        post("zerr_envelopes~: %s", meter.report().c_str());
+    }
+}
+
 /**
  * @brief Adds the zerr_envelopes~ object to the DSP chain.
  * @param x Pointer to the zerr_envelopes_tilde object.
@@ -331,6 +367,9 @@ void zerr_envelopes_tilde_setup(void)
     class_addmethod(zerr_envelopes_tilde_class, (t_method)zerr_envelopes_tilde_print,
                     gensym("print"), A_GIMME, A_NULL);
 
+    class_addmethod(zerr_envelopes_tilde_class, (t_method)zerr_envelopes_tilde_stats,
+                    gensym("stats"), A_GIMME, A_NULL);
+
     class_addmethod(zerr_envelopes_tilde_class, (t_method)zerr_envelopes_tilde_dsp, gensym("dsp"),
                     A_CANT, A_NULL);
 
@@ -12,7 +12,7 @@
 #include <stdlib.h>
 
 ZerrFeatures::ZerrFeatures(zerr::SystemConfigs sys_cnfg, zerr::t_featureNames ft_names):
-            input_buffer(n_inlet, std::vector<double>(sys_cnfg.block_size, 0.0f)) {
+            input_buffer(n_inlet, zerr::Block(sys_cnfg.block_size, 0.0f)) {
     bank = new zerr::FeatureBank();
 
     systemConfigs.sample_rate = sys_cnfg.sample_rate;
@@ -21,12 +21,13 @@ ZerrFeatures::ZerrFeatures(zerr::SystemConfigs sys_cnfg, zerr::t_featureNames ft
     for (int i = 0; i < ft_names.num; ++i) {
         featureNames.push_back(ft_names.names[i]);
     }
+    enabled.assign(featureNames.size(), true);
 }
 
 
 int ZerrFeatures::initialize() {
     try {
-        bank->initialize(featureNames, systemConfigs);
+        bank->initialize(featureNames, systemConfigs, n_channels);
     } catch (...) {
         // send bank initialize failed
         return 0;
@@ -34,8 +35,8 @@ int ZerrFeatures::initialize() {
 
     n_outlet = featureNames.size();
 
-    input_buffer.resize(n_inlet, std::vector<double>(systemConfigs.block_size, 0.0f));
-    output_buffer.resize(n_outlet);
+    input_buffer.resize(n_channels, zerr::Block(systemConfigs.block_size, 0.0f));
+    output_buffer.resize(n_outlet * n_channels);
 
     in_ptr  = (float **) malloc(n_inlet * sizeof(float **));
     out_ptr = (float **) malloc(n_outlet * sizeof(float **));
@@ -44,21 +45,94 @@ int ZerrFeatures::initialize() {
 }
 
 
+int ZerrFeatures::set_channel_count(int n_chans) {
+    if (n_chans < 1) return 0;
+
+    // extractors keep per channel state, so the bank is rebuilt for the new layout
+    zerr::FeatureBank *new_bank = new zerr::FeatureBank();
+    try {
+        new_bank->initialize(featureNames, systemConfigs, n_chans);
+    } catch (...) {
+        delete new_bank;
+        return 0;
+    }
+
+    for (size_t i = 0; i < enabled.size(); ++i) {
+        new_bank->set_feature_enabled(i, enabled[i]);
+    }
+    new_bank->get_load_meter().set_enabled(bank->get_load_meter().is_enabled());
+
+    // the old bank removes its bus, so that the new one can publish under the same name
+    delete bank;
+    bank = new_bank;
+    n_channels = n_chans;
+    if (!busName.empty()) {
+        publish(busName);
+    }
+
+    input_buffer.resize(n_channels, zerr::Block(systemConfigs.block_size, 0.0f));
+    output_buffer.resize(n_outlet * n_channels);
+
+    return 1;
+}
+
+
+int ZerrFeatures::set_feature_enabled(const std::string& name, bool enable) {
+    int n_found = 0;
+    for (size_t i = 0; i < featureNames.size(); ++i) {
+        if (featureNames[i] == name) {
+            enabled[i] = enable;
+            bank->set_feature_enabled(i, enable);
+            n_found++;
+        }
+    }
+    return n_found;
+}
+
+
+void ZerrFeatures::set_all_features_enabled(bool enable) {
+    for (size_t i = 0; i < featureNames.size(); ++i) {
+        enabled[i] = enable;
+        bank->set_feature_enabled(i, enable);
+    }
+}
+
+
+int ZerrFeatures::publish(const std::string& name) {
+    busName = name;
+    try {
+        bank->publish(name);
+    } catch (...) {
+        // the name is taken by another writer or shared memory is unavailable
+        busName.clear();
+        return 0;
+    }
+    return 1;
+}
+
+
 void ZerrFeatures::perform(float **ports, int n_vec) {
     in_ptr  = (float **) &ports[0];
     out_ptr = (float **) &ports[n_inlet];
 
-    for (int i = 0; i < n_inlet; i++) {
+    for (int c = 0; c < n_channels; c++) {
         for (int j = 0; j < n_vec; j++) {
-            input_buffer[i][j] = in_ptr[i][j];
+            input_buffer[c][j] = in_ptr[0][c * n_vec + j];
         }
     }
 
-    output_buffer = bank->perform(input_buffer[0]);
+    if (n_channels == 1) {
+        output_buffer = bank->perform(input_buffer[0]);
+    } else {
+        output_buffer = bank->perform(input_buffer);
+    }
 
+    // every outlet carries one feature of all channels
     for (int i = 0; i < n_outlet; i++) {
-        for (int j = 0; j < n_vec; j++) {
-            out_ptr[i][j] = output_buffer[i][j];
+        for (int c = 0; c < n_channels; c++) {
+            for (int j = 0; j < n_vec; j++) {
+                out_ptr[i][c * n_vec + j] = output_buffer[i * n_channels + c][j];
+            }
         }
     }
 }
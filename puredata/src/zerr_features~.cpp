@@ -79,11 +79,57 @@ static t_int *zerr_features_tilde_perform(t_int *w) {
 }
 
 
+static void zerr_features_tilde_set_enabled(zerr_features_tilde *x, int argc, t_atom *argv,
+                                            bool enable) {
+    if (argc == 0) {
+        x->z->set_all_features_enabled(enable);
+        return;
+    }
+
+    for (int i = 0; i < argc; ++i) {
+        if (argv[i].a_type != A_SYMBOL) {
+            pd_error(x, "zerr_features~: feature names expected");
+            continue;
+        }
+        const char *name = atom_getsymbol(argv + i)->s_name;
+        if (!x->z->set_feature_enabled(name, enable)) {
+            pd_error(x, "zerr_features~: no feature %s", name);
+        }
+    }
+}
+
+
+void zerr_features_tilde_enable(zerr_features_tilde *x, t_symbol *s, int argc, t_atom *argv) {
+    zerr_features_tilde_set_enabled(x, argc, argv, true);
+}
+
+
+void zerr_features_tilde_disable(zerr_features_tilde *x, t_symbol *s, int argc, t_atom *argv) {
+    zerr_features_tilde_set_enabled(x, argc, argv, false);
+}
+
+
 void zerr_features_tilde_dsp(zerr_features_tilde *x, t_signal **sp) {
     int n_rest = 3;  // size of [x, n_vec, n_args]
 
     int n_vec = sp[0]->s_n;
     int n_port = x->z->get_port_count();
+
+#ifdef CLASS_MULTICHANNEL
+    // analyse every channel of a multichannel input, each outlet carries one feature
+    int n_chans = sp[0]->s_nchans;
+    for (int i = x->z->n_inlet; i < n_port; ++i) {
+        signal_setmultiout(&sp[i], n_chans);
+    }
+    if (n_chans != x->z->n_channels && !x->z->set_channel_count(n_chans)) {
+        pd_error(x, "zerr_features~: failed to analyse %d channels", n_chans);
+        for (int i = x->z->n_inlet; i < n_port; ++i) {
+            dsp_add_zero(sp[i]->s_vec, n_chans * n_vec);
+        }
+        return;
+    }
+#endif
+
     int n_args = n_port + n_rest;
 
     t_int *vec = (t_int *) getbytes(n_args * sizeof(t_int *));
@@ -99,12 +145,41 @@ void zerr_features_tilde_dsp(zerr_features_tilde *x, t_signal **sp) {
 }
 
 
+void zerr_features_tilde_stats(zerr_features_tilde *x, t_symbol *s, int argc, t_atom *argv) {
+    zerr::LoadMeter &meter = x->z->get_load_meter();
+
+    if (argc > 0 && argv[0].a_type == A_FLOAT) {
+        meter.set_enabled(atom_getfloat(argv) != 0);
+    } else if (argc > 0 && atom_getsymbol(argv) == gensym("reset")) {
+        meter.reset();
+    } else {
+        post("zerr_features~: %s", meter.report().c_str());
+    }
+}
+
+
+void zerr_features_tilde_bus(zerr_features_tilde *x, t_symbol *s, int argc, t_atom *argv) {
+    if (argc > 0 && argv[0].a_type != A_SYMBOL) {
+        pd_error(x, "zerr_features~: bus name expected");
+        return;
+    }
+    std::string name = argc > 0 ? atom_getsymbol(argv)->s_name : "";
+    if (!x->z->publish(name)) {
+        pd_error(x, "zerr_features~: failed to publish on bus %s", name.c_str());
+    }
+}
+
+
 void zerr_features_tilde_setup(void) {
     zerr_features_tilde_class = class_new(gensym("zerr_features~"),
         (t_newmethod) zerr_features_tilde_new,
         (t_method) zerr_features_tilde_free,
         (size_t) sizeof(zerr_features_tilde),
+#ifdef CLASS_MULTICHANNEL
+        CLASS_MULTICHANNEL,
+#else
         CLASS_DEFAULT,
+#endif
         A_GIMME, 0);
 
     class_addmethod(zerr_features_tilde_class,
@@ -113,6 +188,30 @@ void zerr_features_tilde_setup(void) {
         A_CANT,
         A_NULL);
 
+    class_addmethod(zerr_features_tilde_class,
+        (t_method) zerr_features_tilde_enable,
+        gensym("enable"),
+        A_GIMME,
+        A_NULL);
+
+    class_addmethod(zerr_features_tilde_class,
+        (t_method) zerr_features_tilde_disable,
+        gensym("disable"),
+        A_GIMME,
+        A_NULL);
+
+    class_addmethod(zerr_features_tilde_class,
+        (t_method) zerr_features_tilde_stats,
+        gensym("stats"),
+        A_GIMME,
+        A_NULL);
+
+    class_addmethod(zerr_features_tilde_class,
+        (t_method) zerr_features_tilde_bus,
+        gensym("bus"),
+        A_GIMME,
+        A_NULL);
+
     class_sethelpsymbol(zerr_features_tilde_class, gensym("zerr_features~"));
     CLASS_MAINSIGNALIN(zerr_features_tilde_class, zerr_features_tilde, f);
 }